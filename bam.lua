@@ -10,6 +10,8 @@ function dl_type_lib( tlc_file, dltlc, dl_tests )
 	local out_lib       = out_file .. ".bin"
 	local out_lib_h     = out_file .. ".bin.h"
 	local out_lib_txt_h = out_file .. ".txt.h"
+	local out_txt_gen   = out_file .. ".txt_gen.h"
+	local out_bin_gen   = out_file .. ".bin_gen.h"
 
 	local BIN2HEX  = _bam_exe .. " -e tool/bin2hex.lua"
 
@@ -21,6 +23,8 @@ function dl_type_lib( tlc_file, dltlc, dl_tests )
 	AddJob( out_lib_h,     "tlc " .. out_lib_h,  BIN2HEX .. " dst="   .. out_lib_h  .. " src=" .. out_lib,   out_lib )
 	AddJob( out_lib_txt_h, "tlc " .. out_lib_h,  BIN2HEX .. " dst="   .. out_lib_txt_h  .. " src=" .. tlc_file, tlc_file )
 	AddJob( out_header,    "tlc " .. out_header, dltlc   .. " -c -o " .. out_header .. " "     .. tlc_file,  tlc_file )
+	AddJob( out_txt_gen,   "tlc " .. out_txt_gen, dltlc  .. " -t -o " .. out_txt_gen .. " "    .. tlc_file,  tlc_file )
+	AddJob( out_bin_gen,   "tlc " .. out_bin_gen, dltlc  .. " -b -o " .. out_bin_gen .. " "    .. tlc_file,  tlc_file )
 
 	AddDependency( tlc_file, dltlc )
 	AddDependency( dl_tests, out_lib_h )
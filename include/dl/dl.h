@@ -218,6 +218,15 @@ typedef void  (*dl_error_msg_handler)( const char* msg, void* msg_ctx );
 		                 to the user, set to 0x0 to ignore error-strings.
 		error_msg_ctx  - data passed to error_msg_func as user-data.
 
+		store_reloc_table - if set, dl_instance_store and dl_txt_pack will write a table of all pointer-offsets after the
+		                    packed instance. dl_instance_load and dl_instance_load_inplace can then patch pointers
+		                    by iterating that table instead of traversing the types of the instance.
+		                    Costs 4 bytes per pointer in the packed instance, defaults to 0.
+
+		txt_unpack_flags  - combination of flags from dl_txt_unpack_flags_t controlling the text written by dl_txt_unpack,
+		                    defaults to 0, i.e. indented text over multiple lines.
+		txt_unpack_indent - number of spaces per indentation-level in text written by dl_txt_unpack, defaults to 2.
+
 	Note:
 		As a user you might replace the internal memory allocation function by using alloc_func, realloc_func
 		and free_func.
@@ -233,6 +242,11 @@ typedef struct dl_create_params
 
 	dl_error_msg_handler error_msg_func;
 	void*                error_msg_ctx;
+
+	int store_reloc_table;
+
+	unsigned int txt_unpack_flags;
+	unsigned int txt_unpack_indent;
 } dl_create_params_t;
 
 /*
@@ -254,7 +268,10 @@ typedef struct dl_create_params
 		params.free_func    = 0x0; \
 		params.alloc_ctx    = 0x0; \
 		params.error_msg_func = 0x0; \
-		params.error_msg_ctx  = 0x0;
+		params.error_msg_ctx  = 0x0; \
+		params.store_reloc_table = 0; \
+		params.txt_unpack_flags  = 0; \
+		params.txt_unpack_indent = 2;
 
 /*
 	Group: Context
@@ -336,6 +353,31 @@ dl_error_t DL_DLL_EXPORT dl_instance_load_inplace( dl_ctx_t       dl_ctx,
 												   unsigned char* packed_instance, size_t      packed_instance_size,
 												   void**         loaded_instance, size_t*     consumed );
 
+/*
+	Function: dl_instance_make_self_relative
+		Convert a packed instance, inplace, to store all pointers as offsets relative to the pointer itself. An instance
+		in this format is never patched on load, dl_instance_load() and dl_instance_load_inplace() will only validate
+		the header. This makes it possible to mmap the same read-only data into many processes and share all pages.
+
+		Since pointers in a self-relative instance is not valid pointers they need to be read via the accessors
+		generated in the c-header by dltlc, i.e. my_type_rel_my_member( instance ), or dl_rel_ptr( &instance->my_member ).
+
+	Parameters:
+		dl_ctx               - DL-context to use when converting instance.
+		type                 - Type of instance in the packed data.
+		packed_instance      - Packed instance-data to convert, as produced by dl_instance_store() or dl_txt_pack().
+		packed_instance_size - Size of buffer pointed to by packed_instance.
+
+	Return:
+		DL_ERROR_OK on success. DL_ERROR_UNSUPPORTED_OPERATION if packed_instance is not in current platform ptr-size.
+
+	Note:
+		Packed instance is required to be in current platform endian and ptr-size, if not use dl_convert() first.
+		A self-relative instance can not be converted or unpacked to text.
+*/
+dl_error_t DL_DLL_EXPORT dl_instance_make_self_relative( dl_ctx_t       dl_ctx,          dl_typeid_t type,
+														 unsigned char* packed_instance, size_t      packed_instance_size );
+
 /*
 	Group: Store
 */
@@ -378,6 +420,30 @@ dl_error_t DL_DLL_EXPORT dl_instance_calc_size( dl_ctx_t dl_ctx, dl_typeid_t typ
 dl_error_t DL_DLL_EXPORT dl_instance_store( dl_ctx_t       dl_ctx,     dl_typeid_t type,            const void* instance,
 											unsigned char* out_buffer, size_t      out_buffer_size, size_t*     produced_bytes );
 
+/*
+	Function: dl_instance_store_alloc
+		Store the instance to a buffer allocated by dl, the instance is only traversed once and the buffer
+		is grown as needed.
+
+	Parameters:
+		dl_ctx          - Context to load type-library into.
+		type            - Type id for type to store.
+		instance        - Ptr to instance to store.
+		out_buffer      - Ptr where to return the allocated buffer with the stored instance.
+		out_buffer_size - Ptr where to return size of the stored instance in out_buffer.
+
+	Return:
+		DL_ERROR_OK on success.
+
+	Note:
+		The instance after pack will be in current platform endian.
+
+		out_buffer is allocated with the alloc/realloc-functions that dl_ctx was created with and should be freed with
+		the matching free_func, that is free() if dl_ctx was created with the default allocator.
+*/
+dl_error_t DL_DLL_EXPORT dl_instance_store_alloc( dl_ctx_t        dl_ctx,     dl_typeid_t type, const void* instance,
+												  unsigned char** out_buffer, size_t*     out_buffer_size );
+
 
 /*
 	Group: Util
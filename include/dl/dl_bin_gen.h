@@ -0,0 +1,170 @@
+/* copyright (c) 2010 Fredrik Kihlander, see LICENSE for more info */
+
+#ifndef DL_DL_BIN_GEN_H_INCLUDED
+#define DL_DL_BIN_GEN_H_INCLUDED
+
+/*
+	File: dl_bin_gen.h
+		Support for store- and patch-routines specialized per type that are generated by "dltlc --bin-gen" from a
+		type library. The generated routines are registered with dl_bin_gen_register and are then used by
+		dl_instance_store, dl_instance_store_alloc, dl_instance_load and dl_instance_load_inplace for the types they
+		were generated for.
+
+		The dl_bin_gen_store_- and dl_bin_gen_patch_-functions are only meant to be called by generated code.
+*/
+
+#include <dl/dl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct CDLBinStoreContext* dl_bin_gen_store_t;
+
+/*
+	Struct: dl_bin_gen_patch_ctx
+		State passed to generated patch-routines.
+
+	Members:
+		dl_ctx         - Context the instance is patched with.
+		base_address   - Address that pointers in the instance are relative to.
+		patch_distance - Distance to patch all pointers by.
+		patched_ptrs   - Internal, instances that have already been patched.
+*/
+typedef struct dl_bin_gen_patch_ctx
+{
+	dl_ctx_t                dl_ctx;
+	uintptr_t               base_address;
+	uintptr_t               patch_distance;
+	struct dl_patched_ptrs* patched_ptrs;
+} dl_bin_gen_patch_ctx;
+
+typedef dl_bin_gen_patch_ctx* dl_bin_gen_patch_t;
+
+/*
+	Function: dl_bin_gen_store_func
+		Generated routine storing an instance of one type, called when the instance is to be written at instance_pos.
+		Space for the instance has already been reserved.
+*/
+typedef dl_error_t (*dl_bin_gen_store_func)( dl_bin_gen_store_t store_ctx, const uint8_t* instance, size_t instance_pos );
+
+/*
+	Function: dl_bin_gen_patch_func
+		Generated routine patching all pointers in an instance of one type, including all subdata.
+*/
+typedef void (*dl_bin_gen_patch_func)( dl_bin_gen_patch_t patch_ctx, uint8_t* instance );
+
+/*
+	Struct: dl_bin_gen_type
+		Generated routines for one type.
+
+	Members:
+		type         - Typeid of the type.
+		size         - Size of the type on the current platform when the routines were generated.
+		member_count - Number of members in the type when the routines were generated.
+		store        - Routine storing the type.
+		patch        - Routine patching the type, 0x0 if the type has no subdata and need no patching.
+*/
+typedef struct dl_bin_gen_type
+{
+	dl_typeid_t           type;
+	uint32_t              size;
+	uint32_t              member_count;
+	dl_bin_gen_store_func store;
+	dl_bin_gen_patch_func patch;
+} dl_bin_gen_type;
+
+/*
+	Function: dl_bin_gen_register
+		Register generated store/patch-routines with a context. Generated headers contain a function
+		<module>_bin_gen_register() that calls this with all the types of the module.
+
+	Parameters:
+		dl_ctx     - Context to register the routines with.
+		types      - Routines to register.
+		type_count - Number of entries in types.
+
+	Return:
+		DL_ERROR_OK on success, DL_ERROR_TYPE_NOT_FOUND if a type is not loaded in dl_ctx or DL_ERROR_TYPE_MISMATCH if
+		the loaded type do not match the type that the routines were generated from. Nothing is registered on error.
+
+	Note:
+		The types need to be loaded before the routines are registered.
+*/
+dl_error_t DL_DLL_EXPORT dl_bin_gen_register( dl_ctx_t dl_ctx, const dl_bin_gen_type* types, size_t type_count );
+
+/*
+	Macro: DL_BIN_GEN_PTR_SIZE_SELECT
+		Select between a value for 32- and 64-bit pointers, used for sizes and offsets that depend on pointer-size.
+*/
+#define DL_BIN_GEN_PTR_SIZE_SELECT( value32, value64 ) ( sizeof(void*) == 8 ? (value64) : (value32) )
+
+// ... store support ...
+
+/*
+	Function: dl_bin_gen_store_write
+		Write size bytes from data at pos.
+*/
+void       DL_DLL_EXPORT dl_bin_gen_store_write( dl_bin_gen_store_t store_ctx, size_t pos, const void* data, size_t size );
+
+/*
+	Function: dl_bin_gen_store_str
+		Store the string pointed to by the char* at str and write its offset at pos.
+*/
+void       DL_DLL_EXPORT dl_bin_gen_store_str( dl_bin_gen_store_t store_ctx, size_t pos, const uint8_t* str );
+
+/*
+	Function: dl_bin_gen_store_ptr
+		Store the instance pointed to by the pointer at ptr, if not already stored, with store and write its offset at pos.
+		size is the size of the pointed to type aligned to alignment.
+*/
+dl_error_t DL_DLL_EXPORT dl_bin_gen_store_ptr( dl_bin_gen_store_t store_ctx, size_t pos, const uint8_t* ptr, uint32_t size, uint32_t alignment, dl_bin_gen_store_func store );
+
+/*
+	Function: dl_bin_gen_store_array
+		Store the elements of the array at array and write the array at pos. Each element is stored with store or,
+		if store is 0x0, all elements are written as is.
+*/
+dl_error_t DL_DLL_EXPORT dl_bin_gen_store_array( dl_bin_gen_store_t store_ctx, size_t pos, const uint8_t* array, uint32_t element_size, uint32_t element_alignment, dl_bin_gen_store_func store );
+
+/*
+	Function: dl_bin_gen_store_member
+		Store member_index of type with the generic, non generated, code.
+*/
+dl_error_t DL_DLL_EXPORT dl_bin_gen_store_member( dl_bin_gen_store_t store_ctx, dl_typeid_t type, uint32_t member_index, const uint8_t* instance, size_t instance_pos );
+
+// ... patch support ...
+
+/*
+	Function: dl_bin_gen_patch_ptr
+		Patch the pointer at ptrptr and return what it points to, 0x0 for null-pointers.
+*/
+static inline uint8_t* dl_bin_gen_patch_ptr( dl_bin_gen_patch_t patch_ctx, uint8_t* ptrptr )
+{
+	uintptr_t* ptr = (uintptr_t*)ptrptr;
+	if( *ptr == ~(uintptr_t)0 )
+	{
+		*ptr = 0;
+		return 0x0;
+	}
+	*ptr += patch_ctx->patch_distance;
+	return (uint8_t*)( patch_ctx->base_address + *ptr );
+}
+
+/*
+	Function: dl_bin_gen_patch_first_visit
+		Returns 1 the first time called with ptr, i.e. when the instance at ptr should be patched.
+*/
+int  DL_DLL_EXPORT dl_bin_gen_patch_first_visit( dl_bin_gen_patch_t patch_ctx, const uint8_t* ptr );
+
+/*
+	Function: dl_bin_gen_patch_member
+		Patch member_index of type with the generic, non generated, code.
+*/
+void DL_DLL_EXPORT dl_bin_gen_patch_member( dl_bin_gen_patch_t patch_ctx, dl_typeid_t type, uint32_t member_index, uint8_t* instance );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DL_DL_BIN_GEN_H_INCLUDED
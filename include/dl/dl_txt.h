@@ -33,6 +33,8 @@ extern "C" {
 
 	Note:
 		The instance after pack will be in current platform endian.
+		Arrays and inline arrays of integers and floating point values can be written either as [ 1, 2, 3 ] or as
+		{ "__base64" : "<base64 of the elements in little endian>" }, see DL_TXT_UNPACK_FLAG_BASE64_ARRAYS.
 */
 dl_error_t DL_DLL_EXPORT dl_txt_pack( dl_ctx_t dl_ctx, const char* txt_instance, unsigned char* out_buffer, size_t out_buffer_size, size_t* produced_bytes );
 
@@ -47,6 +49,62 @@ dl_error_t DL_DLL_EXPORT dl_txt_pack( dl_ctx_t dl_ctx, const char* txt_instance,
 */
 dl_error_t DL_DLL_EXPORT dl_txt_pack_calc_size( dl_ctx_t dl_ctx, const char* txt_instance, size_t* out_instance_size );
 
+/*
+	Function: dl_txt_read_func
+		Callback used by dl_txt_pack_stream to read the text to pack.
+
+	Parameters:
+		buffer      - Buffer to read text to, the text do not need to be zero-terminated.
+		buffer_size - Max number of bytes to read to buffer.
+		read_ctx    - Same ptr that was passed to dl_txt_pack_stream.
+
+	Return:
+		Number of bytes read to buffer, 0 when there is no more text to read.
+*/
+typedef size_t (*dl_txt_read_func)( char* buffer, size_t buffer_size, void* read_ctx );
+
+/*
+	Function: dl_txt_pack_stream
+		Pack text of intermediate-data read in chunks via read_func to a binary blob that is loadable by
+		dl_instance_load. The text is only read once and the output-buffer is allocated by dl and grown as needed.
+
+	Parameters:
+		dl_ctx          - Context to use.
+		read_func       - Function called to read text to pack.
+		read_ctx        - Passed to read_func.
+		out_buffer      - Ptr where to return the allocated buffer with the packed instance.
+		out_buffer_size - Ptr where to return size of the packed instance in out_buffer.
+
+	Return:
+		DL_ERROR_OK on success.
+
+	Note:
+		Only a window of the text is kept in memory while packing, the text of a "__subdata"-member and of
+		arrays of structs containing pointers, strings or arrays is kept in full until it has been packed.
+
+		out_buffer is allocated with the alloc/realloc-functions that dl_ctx was created with and should be freed with
+		the matching free_func, that is free() if dl_ctx was created with the default allocator.
+*/
+dl_error_t DL_DLL_EXPORT dl_txt_pack_stream( dl_ctx_t dl_ctx, dl_txt_read_func read_func, void* read_ctx,
+                                             unsigned char** out_buffer, size_t* out_buffer_size );
+
+/*
+	Enum: dl_txt_unpack_flags_t
+		Flags controlling the text written by dl_txt_unpack, set via dl_create_params_t.txt_unpack_flags.
+
+	DL_TXT_UNPACK_FLAG_DEFAULT - Text is written over multiple lines and indented by dl_create_params_t.txt_unpack_indent.
+	DL_TXT_UNPACK_FLAG_COMPACT       - Text is written on a single line without any optional whitespace.
+	DL_TXT_UNPACK_FLAG_BASE64_ARRAYS - Arrays and inline arrays of integers and floating point values are written as
+	                                   { "__base64" : "<base64 of the elements in little endian>" }. This is faster to
+	                                   pack and unpack, smaller and exact for large arrays but not readable.
+*/
+typedef enum
+{
+	DL_TXT_UNPACK_FLAG_DEFAULT       = 0,
+	DL_TXT_UNPACK_FLAG_COMPACT       = 1 << 0,
+	DL_TXT_UNPACK_FLAG_BASE64_ARRAYS = 1 << 1
+} dl_txt_unpack_flags_t;
+
 /*
 	Function: dl_txt_unpack
 		Unpack binary packed instance to text-format.
@@ -86,6 +144,40 @@ dl_error_t DL_DLL_EXPORT dl_txt_unpack_calc_size( dl_ctx_t             dl_ctx,
                                                   const unsigned char* packed_instance,      size_t      packed_instance_size,
                                                   size_t*              out_txt_instance_size );
 
+/*
+	Function: dl_txt_write_func
+		Callback used by dl_txt_unpack_stream to write unpacked text.
+
+	Parameters:
+		text      - Text to write, not zero-terminated.
+		text_size - Number of bytes in text.
+		write_ctx - Same ptr that was passed to dl_txt_unpack_stream.
+*/
+typedef void (*dl_txt_write_func)( const char* text, size_t text_size, void* write_ctx );
+
+/*
+	Function: dl_txt_unpack_stream
+		Unpack binary packed instance to text-format that is passed to write_func in chunks as it is produced. The
+		instance is only traversed once and no buffer large enough to hold the entire text is needed.
+
+	Parameters:
+		dl_ctx               - Context to use.
+		type                 - Type stored in packed_instace.
+		packed_instance      - Buffer with packed data.
+		packed_instance_size - Size of packed_instance.
+		write_func           - Function called with the unpacked text.
+		write_ctx            - Passed to write_func.
+		produced_bytes       - Number of bytes passed to write_func, can be 0x0.
+
+	Note:
+		Packed instance to unpack is required to be in current platform endian, if not DL_ERROR_ENDIAN_ERROR will be returned.
+		The text is the same as produced by dl_txt_unpack except for the terminating zero that is not written.
+*/
+dl_error_t DL_DLL_EXPORT dl_txt_unpack_stream( dl_ctx_t             dl_ctx,          dl_typeid_t type,
+                                               const unsigned char* packed_instance, size_t      packed_instance_size,
+                                               dl_txt_write_func    write_func,      void*       write_ctx,
+                                               size_t*              produced_bytes );
+
 #ifdef __cplusplus
 }
 #endif
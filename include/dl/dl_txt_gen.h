@@ -0,0 +1,202 @@
+/* copyright (c) 2010 Fredrik Kihlander, see LICENSE for more info */
+
+#ifndef DL_DL_TXT_GEN_H_INCLUDED
+#define DL_DL_TXT_GEN_H_INCLUDED
+
+/*
+	File: dl_txt_gen.h
+		Support for text pack/unpack-routines specialized per type that are generated by "dltlc --txt-gen" from a
+		type library. The generated routines are registered with dl_txt_gen_register and are then used by
+		dl_txt_pack, dl_txt_pack_stream, dl_txt_unpack and dl_txt_unpack_stream for the types they were generated for.
+
+		The dl_txt_gen_pack_- and dl_txt_gen_unpack_-functions are only meant to be called by generated code.
+*/
+
+#include <dl/dl.h>
+
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dl_txt_pack_ctx*   dl_txt_gen_pack_t;
+typedef struct dl_txt_unpack_ctx* dl_txt_gen_unpack_t;
+
+/*
+	Function: dl_txt_gen_pack_func
+		Generated routine packing the members of one type, called after the opening '{' of the instance has been read.
+		Reads all members and the closing '}' and writes them to the instance at instance_pos.
+*/
+typedef void (*dl_txt_gen_pack_func)( dl_txt_gen_pack_t pack_ctx, size_t instance_pos );
+
+/*
+	Function: dl_txt_gen_unpack_func
+		Generated routine unpacking the members of one type, called after the opening '{' of the instance has been
+		written. Writes all members of the instance at instance_data.
+*/
+typedef void (*dl_txt_gen_unpack_func)( dl_txt_gen_unpack_t unpack_ctx, const uint8_t* instance_data );
+
+/*
+	Struct: dl_txt_gen_type
+		Generated routines for one type.
+
+	Members:
+		type         - Typeid of the type.
+		size         - Size of the type on the current platform when the routines were generated.
+		member_count - Number of members in the type when the routines were generated.
+		pack         - Routine packing the type.
+		unpack       - Routine unpacking the type.
+*/
+typedef struct dl_txt_gen_type
+{
+	dl_typeid_t            type;
+	uint32_t               size;
+	uint32_t               member_count;
+	dl_txt_gen_pack_func   pack;
+	dl_txt_gen_unpack_func unpack;
+} dl_txt_gen_type;
+
+/*
+	Function: dl_txt_gen_register
+		Register generated text pack/unpack-routines with a context. Generated headers contain a function
+		<module>_txt_gen_register() that calls this with all the types of the module.
+
+	Parameters:
+		dl_ctx     - Context to register the routines with.
+		types      - Routines to register.
+		type_count - Number of entries in types.
+
+	Return:
+		DL_ERROR_OK on success, DL_ERROR_TYPE_NOT_FOUND if a type is not loaded in dl_ctx or DL_ERROR_TYPE_MISMATCH if
+		the loaded type do not match the type that the routines were generated from. Nothing is registered on error.
+
+	Note:
+		The types need to be loaded before the routines are registered.
+*/
+dl_error_t DL_DLL_EXPORT dl_txt_gen_register( dl_ctx_t dl_ctx, const dl_txt_gen_type* types, size_t type_count );
+
+/*
+	Function: dl_txt_gen_hash
+		Hash used by the generated perfect hashes mapping member-names to member-index.
+*/
+static inline uint32_t dl_txt_gen_hash( const char* str, size_t len, uint32_t seed )
+{
+	uint32_t hash = 2166136261u ^ seed;
+	for( size_t i = 0; i < len; ++i )
+		hash = ( hash ^ (uint8_t)str[i] ) * 16777619u;
+	// ... fnv1a do not mix the low bits well enough to mask them, finish with the murmur3 finalizer ...
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6Bu;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35u;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+/*
+	Macro: DL_TXT_GEN_PTR_SIZE_SELECT
+		Select between a value for 32- and 64-bit pointers, used for sizes and offsets that depend on pointer-size.
+*/
+#define DL_TXT_GEN_PTR_SIZE_SELECT( value32, value64 ) ( sizeof(void*) == 8 ? (value64) : (value32) )
+
+// ... pack support, errors in these are reported via the same longjmp as in dl_txt_pack and they do not return ...
+
+/*
+	Function: dl_txt_gen_pack_next_key
+		Read the next member-key of an instance. Returns 0 and reads the closing '}' when there are no more members.
+		The key is only valid until more text is read.
+*/
+int  DL_DLL_EXPORT dl_txt_gen_pack_next_key( dl_txt_gen_pack_t pack_ctx, const char** key, size_t* key_len );
+
+/*
+	Function: dl_txt_gen_pack_unknown_key
+		Handle a key that is not a member of type, reads "__subdata" or fails.
+*/
+void DL_DLL_EXPORT dl_txt_gen_pack_unknown_key( dl_txt_gen_pack_t pack_ctx, dl_typeid_t type, const char* key, size_t key_len );
+
+/*
+	Function: dl_txt_gen_pack_set_twice
+		Fail with DL_ERROR_TXT_MEMBER_SET_TWICE for member_index of type.
+*/
+void DL_DLL_EXPORT dl_txt_gen_pack_set_twice( dl_txt_gen_pack_t pack_ctx, dl_typeid_t type, uint32_t member_index );
+
+/*
+	Function: dl_txt_gen_pack_value_separator
+		Read the ':' between a member-key and its value.
+*/
+void DL_DLL_EXPORT dl_txt_gen_pack_value_separator( dl_txt_gen_pack_t pack_ctx );
+
+/*
+	Function: dl_txt_gen_pack_defaults
+		Write default values for all members of type that are not set in members_set, fails if a member without
+		default value is not set.
+*/
+void DL_DLL_EXPORT dl_txt_gen_pack_defaults( dl_txt_gen_pack_t pack_ctx, dl_typeid_t type, size_t instance_pos, const uint64_t* members_set );
+
+/*
+	Function: dl_txt_gen_pack_member
+		Pack member_index of type with the generic, non generated, code.
+*/
+void DL_DLL_EXPORT dl_txt_gen_pack_member( dl_txt_gen_pack_t pack_ctx, dl_typeid_t type, uint32_t member_index, size_t instance_pos );
+
+/*
+	Function: dl_txt_gen_pack_begin_struct
+		Begin packing a struct-member of type at pos. Returns 1 if '{' was read and the generated routine for type
+		should be called, 0 if the member was written as an array of values and already has been packed.
+*/
+int  DL_DLL_EXPORT dl_txt_gen_pack_begin_struct( dl_txt_gen_pack_t pack_ctx, dl_typeid_t type, size_t pos );
+
+void DL_DLL_EXPORT dl_txt_gen_pack_int8  ( dl_txt_gen_pack_t pack_ctx, size_t pos );
+void DL_DLL_EXPORT dl_txt_gen_pack_int16 ( dl_txt_gen_pack_t pack_ctx, size_t pos );
+void DL_DLL_EXPORT dl_txt_gen_pack_int32 ( dl_txt_gen_pack_t pack_ctx, size_t pos );
+void DL_DLL_EXPORT dl_txt_gen_pack_int64 ( dl_txt_gen_pack_t pack_ctx, size_t pos );
+void DL_DLL_EXPORT dl_txt_gen_pack_uint8 ( dl_txt_gen_pack_t pack_ctx, size_t pos );
+void DL_DLL_EXPORT dl_txt_gen_pack_uint16( dl_txt_gen_pack_t pack_ctx, size_t pos );
+void DL_DLL_EXPORT dl_txt_gen_pack_uint32( dl_txt_gen_pack_t pack_ctx, size_t pos );
+void DL_DLL_EXPORT dl_txt_gen_pack_uint64( dl_txt_gen_pack_t pack_ctx, size_t pos );
+void DL_DLL_EXPORT dl_txt_gen_pack_fp32  ( dl_txt_gen_pack_t pack_ctx, size_t pos );
+void DL_DLL_EXPORT dl_txt_gen_pack_fp64  ( dl_txt_gen_pack_t pack_ctx, size_t pos );
+
+// ... unpack support ...
+
+/*
+	Function: dl_txt_gen_unpack_key
+		Write the key of a member, key is the member-name including quotes.
+*/
+void DL_DLL_EXPORT dl_txt_gen_unpack_key( dl_txt_gen_unpack_t unpack_ctx, const char* key, size_t key_len );
+
+/*
+	Function: dl_txt_gen_unpack_end_member
+		Write what follows a member, last is non-zero for the last member of a type.
+*/
+void DL_DLL_EXPORT dl_txt_gen_unpack_end_member( dl_txt_gen_unpack_t unpack_ctx, int last );
+
+/*
+	Function: dl_txt_gen_unpack_member
+		Unpack member_index of type, key included, with the generic, non generated, code.
+*/
+void DL_DLL_EXPORT dl_txt_gen_unpack_member( dl_txt_gen_unpack_t unpack_ctx, dl_typeid_t type, uint32_t member_index, const uint8_t* instance_data );
+
+/*
+	Function: dl_txt_gen_unpack_begin_struct
+		Write the opening of a struct-member, the generated routine for the type of the member is called after this.
+*/
+void DL_DLL_EXPORT dl_txt_gen_unpack_begin_struct( dl_txt_gen_unpack_t unpack_ctx );
+
+/*
+	Function: dl_txt_gen_unpack_end_struct
+		Write the closing of a struct-member.
+*/
+void DL_DLL_EXPORT dl_txt_gen_unpack_end_struct( dl_txt_gen_unpack_t unpack_ctx );
+
+void DL_DLL_EXPORT dl_txt_gen_unpack_int64 ( dl_txt_gen_unpack_t unpack_ctx, int64_t  value );
+void DL_DLL_EXPORT dl_txt_gen_unpack_uint64( dl_txt_gen_unpack_t unpack_ctx, uint64_t value );
+void DL_DLL_EXPORT dl_txt_gen_unpack_fp32  ( dl_txt_gen_unpack_t unpack_ctx, float    value );
+void DL_DLL_EXPORT dl_txt_gen_unpack_fp64  ( dl_txt_gen_unpack_t unpack_ctx, double   value );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DL_DL_TXT_GEN_H_INCLUDED
@@ -97,6 +97,54 @@ dl_error_t DL_DLL_EXPORT dl_context_write_txt_type_library( dl_ctx_t dl_ctx, cha
 */
 dl_error_t DL_DLL_EXPORT dl_context_write_type_library_c_header( dl_ctx_t dl_ctx, const char* module_name, char* out_header, size_t out_header_size, size_t* produced_bytes );
 
+/*
+	Function: dl_context_write_type_library_txt_gen
+		Write all types loaded in dl_ctx as a c++-header with text pack/unpack-routines specialized per type, see dl_txt_gen.h.
+		Member-keys are matched with a perfect hash generated per type and members are read and written at fixed offsets.
+
+	Parameters:
+		dl_ctx          - dl-context to write to buffer.
+		module_name     - name of generated module, everything from the first '.' is skipped. The header defines the function
+		                  <module_name>_txt_gen_register( dl_ctx_t ) that registers the routines with a context.
+		out_header      - buffer to write header to.
+		out_header_size - size of out_header.
+		produced_bytes  - number of bytes that would have been written to out_header if it was large enough.
+
+	Return:
+		DL_ERROR_OK on success.
+
+	Note:
+		Only struct-types get routines, unions are always handled by the generic code. Integer, floating point and struct-members
+		are handled by the generated code while enums, strings, pointers, arrays and bitfields call back to the generic code.
+
+		This function do not have the same rules of memory allocation and might allocate memory behind the scenes.
+*/
+dl_error_t DL_DLL_EXPORT dl_context_write_type_library_txt_gen( dl_ctx_t dl_ctx, const char* module_name, char* out_header, size_t out_header_size, size_t* produced_bytes );
+
+/*
+	Function: dl_context_write_type_library_bin_gen
+		Write all types loaded in dl_ctx as a c++-header with store- and patch-routines specialized per type, see dl_bin_gen.h.
+		Pointers, strings and arrays are visited in straight-line code and subtypes are stored/patched by calling their routines directly.
+
+	Parameters:
+		dl_ctx          - dl-context to write to buffer.
+		module_name     - name of generated module, everything from the first '.' is skipped. The header defines the function
+		                  <module_name>_bin_gen_register( dl_ctx_t ) that registers the routines with a context.
+		out_header      - buffer to write header to.
+		out_header_size - size of out_header.
+		produced_bytes  - number of bytes that would have been written to out_header if it was large enough.
+
+	Return:
+		DL_ERROR_OK on success.
+
+	Note:
+		Only struct-types get routines, unions are always handled by the generic code. Members of union-type, pointers to
+		unions and arrays of strings, pointers and unions call back to the generic code.
+
+		This function do not have the same rules of memory allocation and might allocate memory behind the scenes.
+*/
+dl_error_t DL_DLL_EXPORT dl_context_write_type_library_bin_gen( dl_ctx_t dl_ctx, const char* module_name, char* out_header, size_t out_header_size, size_t* produced_bytes );
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -98,8 +98,10 @@ dl_error_t DL_DLL_EXPORT dl_util_load_from_stream( dl_ctx_t dl_ctx,       dl_typ
 		Utility function that loads an dl-instance from file to a specified memory-area.
 
 	Note:
-		This function allocates memory internally by use of malloc/free and should therefore
-		be used accordingly.
+		A binary file in current platform endian and ptr-size is read with one read, straight to out_instance, and
+		patched there without any allocation. Binary files in other endian or larger ptr-size are converted inplace
+		in out_instance. Only text-files and binary files with smaller ptr-size than current platform is read to a
+		temporary buffer allocated via allocator.
 
 	Parameters:
 		dl_ctx            	- Context to use for operations.
@@ -107,7 +109,9 @@ dl_error_t DL_DLL_EXPORT dl_util_load_from_stream( dl_ctx_t dl_ctx,       dl_typ
 		filename          	- Path to file to load from.
 		filetype          	- Type of file to read, see EDLUtilFileType.
 		out_instance      	- Pointer to area to load instance to.
-		out_instance_size 	- Size of buffer pointed to by _ppInstance
+		out_instance_size 	- Size of buffer pointed to by out_instance. For binary files this need to be large enough to hold
+							  the instance as stored in file and as converted to current platform.
+		out_type          	- Ptr where to store type found in file, 0x0 to ignore.
 		allocator 			- Allocator for doing temp file allocations. 0x0 / nullpointer is also
 					   valid and will default to using malloc (default behavior of dl).
 
@@ -119,6 +123,68 @@ dl_error_t DL_DLL_EXPORT dl_util_load_from_file_inplace( dl_ctx_t     dl_ctx,
 										   void*        out_instance, size_t              out_instance_size,
 										   dl_typeid_t* out_type, dl_allocator *allocator );
 
+/*
+	Enum: dl_util_mmap_flags_t
+		Flags controlling how a file is mapped by dl_util_load_from_file_mmap.
+
+	DL_UTIL_MMAP_FLAG_DEFAULT  - Pages are read from file as they are accessed.
+	DL_UTIL_MMAP_FLAG_POPULATE - Read all pages while mapping, i.e. MAP_POPULATE where supported.
+	DL_UTIL_MMAP_FLAG_WILLNEED - Hint the os to start reading the whole file ahead of access, i.e. madvise( MADV_WILLNEED ).
+*/
+typedef enum
+{
+	DL_UTIL_MMAP_FLAG_DEFAULT  = 0,
+	DL_UTIL_MMAP_FLAG_POPULATE = 1 << 0,
+	DL_UTIL_MMAP_FLAG_WILLNEED = 1 << 1
+} dl_util_mmap_flags_t;
+
+/*
+	Struct: dl_util_mapping_t
+		A file mapped by dl_util_load_from_file_mmap, release with dl_util_unmap.
+*/
+typedef struct dl_util_mapping
+{
+	void*  address;
+	size_t size;
+} dl_util_mapping_t;
+
+/*
+	Function: dl_util_load_from_file_mmap
+		Utility function that maps a binary dl-instance from file to memory and loads it inplace in the mapping.
+
+	Note:
+		The file is mapped private, copy-on-write, so only pages that are written when patching pointers, or converting
+		the instance, are copied. Pages without pointers, or all pages of an instance made self-relative by
+		dl_instance_make_self_relative, is shared with the file-cache and other processes mapping the same file.
+		Instances in other endian or larger ptr-size than current platform are converted inplace in the mapping, instances
+		with smaller ptr-size can not be loaded via this function.
+
+	Parameters:
+		dl_ctx       - Context to use for operations.
+		type         - Type expected to be found in file, set to 0 if not known.
+		filename     - Path to file to load from.
+		mmap_flags   - Combination of flags from dl_util_mmap_flags_t.
+		out_mapping  - Mapping to release with dl_util_unmap when the instance is not used any more.
+		out_instance - Pointer to fill with loaded instance, points into the mapping.
+		out_type     - TypeID of instance found in file, can be set to 0x0.
+
+	Returns:
+		DL_ERROR_OK on success. On error nothing is left mapped.
+*/
+dl_error_t DL_DLL_EXPORT dl_util_load_from_file_mmap( dl_ctx_t           dl_ctx,       dl_typeid_t  type,
+													  const char*        filename,     unsigned int mmap_flags,
+													  dl_util_mapping_t* out_mapping,  void**       out_instance,
+													  dl_typeid_t*       out_type );
+
+/*
+	Function: dl_util_unmap
+		Release a file mapped by dl_util_load_from_file_mmap, all instances loaded from the mapping is invalid after this.
+
+	Parameters:
+		mapping - Mapping to release, reset to empty.
+*/
+void DL_DLL_EXPORT dl_util_unmap( dl_util_mapping_t* mapping );
+
 /*
 	Function: dl_util_store_to_file
 		Utility function that writes an instance to file.
@@ -20,6 +20,9 @@ dl_error_t dl_context_create( dl_ctx_t* dl_ctx, dl_create_params_t* create_param
 
 	ctx->error_msg_func = create_params->error_msg_func;
 	ctx->error_msg_ctx  = create_params->error_msg_ctx;
+	ctx->store_reloc_table = create_params->store_reloc_table != 0;
+	ctx->txt_unpack_flags  = create_params->txt_unpack_flags;
+	ctx->txt_unpack_indent = create_params->txt_unpack_indent;
 
 	*dl_ctx = ctx;
 
@@ -33,15 +36,170 @@ dl_error_t dl_context_destroy(dl_ctx_t dl_ctx)
 	dl_free( &dl_ctx->alloc, dl_ctx->enum_ids );
 	dl_free( &dl_ctx->alloc, dl_ctx->enum_descs );
 	dl_free( &dl_ctx->alloc, dl_ctx->member_descs );
+	dl_free( &dl_ctx->alloc, dl_ctx->member_lookup );
 	dl_free( &dl_ctx->alloc, dl_ctx->enum_value_descs );
 	dl_free( &dl_ctx->alloc, dl_ctx->enum_alias_descs );
 	dl_free( &dl_ctx->alloc, dl_ctx->typedata_strings );
 	dl_free( &dl_ctx->alloc, dl_ctx->default_data );
 	dl_free( &dl_ctx->alloc, dl_ctx->c_includes );
+	dl_free( &dl_ctx->alloc, dl_ctx->type_lookup.slots );
+	dl_free( &dl_ctx->alloc, dl_ctx->enum_lookup.slots );
+	dl_free( &dl_ctx->alloc, dl_ctx->txt_gen );
+	dl_free( &dl_ctx->alloc, dl_ctx->bin_gen );
+	dl_free( &dl_ctx->alloc, dl_ctx->type_plans );
+	dl_free( &dl_ctx->alloc, dl_ctx->plan_ops );
+	dl_free( &dl_ctx->alloc, dl_ctx->plan_copies );
+	dl_free( &dl_ctx->alloc, dl_ctx->type_hot );
+	dl_free( &dl_ctx->alloc, dl_ctx->member_hot );
 	dl_free( &dl_ctx->alloc, dl_ctx );
 	return DL_ERROR_OK;
 }
 
+static void dl_internal_typeid_lookup_insert_no_grow( dl_typeid_lookup* lookup, const dl_typeid_t* ids, uint32_t index )
+{
+	dl_typeid_t type_id = ids[index];
+	uint32_t    mask    = lookup->capacity - 1;
+	for( uint32_t slot = dl_internal_typeid_lookup_hash( type_id ) & mask; ; slot = ( slot + 1 ) & mask )
+	{
+		uint32_t curr = lookup->slots[slot];
+		if( curr == UINT32_MAX )
+		{
+			lookup->slots[slot] = index;
+			++lookup->count;
+			return;
+		}
+		if( ids[curr] == type_id )
+			return; // first loaded type wins, same as the old linear search.
+	}
+}
+
+void dl_internal_typeid_lookup_insert( dl_allocator* alloc, dl_typeid_lookup* lookup, const dl_typeid_t* ids, uint32_t index )
+{
+	// keep load-factor below 3/4
+	if( ( lookup->count + 1 ) * 4 > lookup->capacity * 3 )
+	{
+		uint32_t* old_slots = lookup->slots;
+		uint32_t  old_cap   = lookup->capacity;
+
+		lookup->capacity = old_cap == 0 ? 64 : old_cap * 2;
+		lookup->slots    = (uint32_t*)dl_alloc( alloc, sizeof( uint32_t ) * lookup->capacity );
+		lookup->count    = 0;
+		memset( lookup->slots, 0xFF, sizeof( uint32_t ) * lookup->capacity );
+
+		for( uint32_t i = 0; i < old_cap; ++i )
+			if( old_slots[i] != UINT32_MAX )
+				dl_internal_typeid_lookup_insert_no_grow( lookup, ids, old_slots[i] );
+
+		dl_free( alloc, old_slots );
+	}
+
+	dl_internal_typeid_lookup_insert_no_grow( lookup, ids, index );
+}
+
+void dl_internal_typeid_lookup_remove( dl_typeid_lookup* lookup, const dl_typeid_t* ids, uint32_t index )
+{
+	if( lookup->capacity == 0 )
+		return;
+
+	uint32_t mask = lookup->capacity - 1;
+	uint32_t slot = dl_internal_typeid_lookup_hash( ids[index] ) & mask;
+	while( lookup->slots[slot] != index )
+	{
+		if( lookup->slots[slot] == UINT32_MAX )
+			return; // not in table, i.e. it was shadowed by an earlier type with the same id.
+		slot = ( slot + 1 ) & mask;
+	}
+
+	// backward shift deletion, move up entries in the probe-sequence so that no tombstones are needed.
+	uint32_t hole = slot;
+	for( uint32_t next = ( hole + 1 ) & mask; lookup->slots[next] != UINT32_MAX; next = ( next + 1 ) & mask )
+	{
+		uint32_t home = dl_internal_typeid_lookup_hash( ids[ lookup->slots[next] ] ) & mask;
+		// can the entry in 'next' be moved to 'hole' without ending up before its home-slot?
+		if( ( ( next - home ) & mask ) >= ( ( next - hole ) & mask ) )
+		{
+			lookup->slots[hole] = lookup->slots[next];
+			hole = next;
+		}
+	}
+	lookup->slots[hole] = UINT32_MAX;
+	--lookup->count;
+}
+
+/**
+ * Verify that all generated types match the loaded types, used before registering any routines so that nothing is
+ * registered on error.
+ */
+template <typename GEN_TYPE>
+static dl_error_t dl_internal_gen_verify_types( dl_ctx_t dl_ctx, const GEN_TYPE* types, size_t type_count )
+{
+	for( size_t i = 0; i < type_count; ++i )
+	{
+		const dl_type_desc* type = dl_internal_find_type( dl_ctx, types[i].type );
+		if( type == 0x0 )
+			return DL_ERROR_TYPE_NOT_FOUND;
+		if( type->size[DL_PTR_SIZE_HOST] != types[i].size || type->member_count != types[i].member_count || ( type->flags & DL_TYPE_FLAG_IS_UNION ) )
+			return DL_ERROR_TYPE_MISMATCH;
+	}
+	return DL_ERROR_OK;
+}
+
+/**
+ * Grow an array of generated routines, parallel to type_descs, to cover all loaded types.
+ */
+template <typename GEN_FUNCS>
+static dl_error_t dl_internal_gen_grow( dl_ctx_t dl_ctx, GEN_FUNCS** funcs, size_t* count )
+{
+	if( *count >= dl_ctx->type_count )
+		return DL_ERROR_OK;
+
+	GEN_FUNCS* new_funcs = (GEN_FUNCS*)dl_realloc( &dl_ctx->alloc, *funcs, sizeof( GEN_FUNCS ) * dl_ctx->type_count, sizeof( GEN_FUNCS ) * *count );
+	if( new_funcs == 0x0 )
+		return DL_ERROR_OUT_OF_LIBRARY_MEMORY;
+	memset( new_funcs + *count, 0x0, sizeof( GEN_FUNCS ) * ( dl_ctx->type_count - *count ) );
+	*funcs = new_funcs;
+	*count = dl_ctx->type_count;
+	return DL_ERROR_OK;
+}
+
+dl_error_t dl_txt_gen_register( dl_ctx_t dl_ctx, const dl_txt_gen_type* types, size_t type_count )
+{
+	dl_error_t err = dl_internal_gen_verify_types( dl_ctx, types, type_count );
+	if( err != DL_ERROR_OK )
+		return err;
+
+	err = dl_internal_gen_grow( dl_ctx, &dl_ctx->txt_gen, &dl_ctx->txt_gen_count );
+	if( err != DL_ERROR_OK )
+		return err;
+
+	for( size_t i = 0; i < type_count; ++i )
+	{
+		dl_txt_gen_funcs* funcs = &dl_ctx->txt_gen[ dl_internal_find_type( dl_ctx, types[i].type ) - dl_ctx->type_descs ];
+		funcs->pack   = types[i].pack;
+		funcs->unpack = types[i].unpack;
+	}
+	return DL_ERROR_OK;
+}
+
+dl_error_t dl_bin_gen_register( dl_ctx_t dl_ctx, const dl_bin_gen_type* types, size_t type_count )
+{
+	dl_error_t err = dl_internal_gen_verify_types( dl_ctx, types, type_count );
+	if( err != DL_ERROR_OK )
+		return err;
+
+	err = dl_internal_gen_grow( dl_ctx, &dl_ctx->bin_gen, &dl_ctx->bin_gen_count );
+	if( err != DL_ERROR_OK )
+		return err;
+
+	for( size_t i = 0; i < type_count; ++i )
+	{
+		dl_bin_gen_funcs* funcs = &dl_ctx->bin_gen[ dl_internal_find_type( dl_ctx, types[i].type ) - dl_ctx->type_descs ];
+		funcs->store = types[i].store;
+		funcs->patch = types[i].patch;
+	}
+	return DL_ERROR_OK;
+}
+
 dl_error_t dl_instance_load( dl_ctx_t             dl_ctx,          dl_typeid_t  type_id,
                              void*                instance,        size_t instance_size,
                              const unsigned char* packed_instance, size_t packed_instance_size,
@@ -55,6 +213,7 @@ dl_error_t dl_instance_load( dl_ctx_t             dl_ctx,          dl_typeid_t
 	if( header->version != DL_INSTANCE_VERSION )        return DL_ERROR_VERSION_MISMATCH;
 	if( header->root_instance_type != type_id )         return DL_ERROR_TYPE_MISMATCH;
 	if( header->instance_size > instance_size )         return DL_ERROR_BUFFER_TO_SMALL;
+	if( dl_internal_packed_instance_size( header ) > packed_instance_size ) return DL_ERROR_MALFORMED_DATA;
 
 	const dl_type_desc* root_type = dl_internal_find_type( dl_ctx, header->root_instance_type );
 	if( root_type == 0x0 )
@@ -69,73 +228,152 @@ dl_error_t dl_instance_load( dl_ctx_t             dl_ctx,          dl_typeid_t
 	// memmove is needed!
 	memmove( instance, packed_instance + sizeof(dl_data_header), header->instance_size );
 
-	dl_internal_patch_instance( dl_ctx, root_type, (uint8_t*)instance, 0x0, (uintptr_t)instance );
+	// self-relative pointers are valid wherever the instance is copied to so they need no patching.
+	// relocation table is stored after the instance-data so it is still intact after the memmove above.
+	if( header->flags & DL_DATA_HEADER_FLAG_SELF_RELATIVE )
+		{}
+	else if( header->flags & DL_DATA_HEADER_FLAG_HAS_RELOC_TABLE )
+	{
+		const uint32_t* relocs = (const uint32_t*)( packed_instance + sizeof(dl_data_header) + dl_internal_reloc_table_offset( header ) );
+		dl_internal_patch_relocs( (uint8_t*)instance, relocs, header->reloc_count, (uintptr_t)instance );
+	}
+	else
+		dl_internal_patch_instance( dl_ctx, root_type, (uint8_t*)instance, 0x0, (uintptr_t)instance );
 
 	if( consumed )
-		*consumed = (size_t)header->instance_size + sizeof(dl_data_header);
+		*consumed = dl_internal_packed_instance_size( header );
 
 	return DL_ERROR_OK;
 }
 
-dl_error_t DL_DLL_EXPORT dl_instance_load_inplace( dl_ctx_t       dl_ctx,          dl_typeid_t type_id,
-												   unsigned char* packed_instance, size_t      packed_instance_size,
-												   void**         loaded_instance, size_t*     consumed)
+dl_error_t dl_internal_instance_load_detached_header( dl_ctx_t dl_ctx,        dl_typeid_t type_id, const dl_data_header* header,
+													  uint8_t* instance_data, size_t      instance_data_size )
 {
-	dl_data_header* header = (dl_data_header*)packed_instance;
-
-	if( packed_instance_size < sizeof(dl_data_header) ) return DL_ERROR_MALFORMED_DATA;
 	if( header->id == DL_INSTANCE_ID_SWAPED )           return DL_ERROR_ENDIAN_MISMATCH;
 	if( header->id != DL_INSTANCE_ID )                  return DL_ERROR_MALFORMED_DATA;
 	if( header->version != DL_INSTANCE_VERSION )        return DL_ERROR_VERSION_MISMATCH;
 	if( header->root_instance_type != type_id )         return DL_ERROR_TYPE_MISMATCH;
+	if( dl_internal_packed_instance_size( header ) - sizeof(dl_data_header) > instance_data_size ) return DL_ERROR_MALFORMED_DATA;
 
 	const dl_type_desc* type = dl_internal_find_type(dl_ctx, header->root_instance_type);
 	if( type == 0x0 )
 		return DL_ERROR_TYPE_NOT_FOUND;
 
+	// self-relative instances need no patching and instance_data is never written to.
+	if( header->flags & DL_DATA_HEADER_FLAG_SELF_RELATIVE )
+		{}
+	else if( header->flags & DL_DATA_HEADER_FLAG_HAS_RELOC_TABLE )
+	{
+		const uint32_t* relocs = (const uint32_t*)( instance_data + dl_internal_reloc_table_offset( header ) );
+		dl_internal_patch_relocs( instance_data, relocs, header->reloc_count, (uintptr_t)instance_data );
+	}
+	else
+		dl_internal_patch_instance( dl_ctx, type, instance_data, 0x0, (uintptr_t)instance_data );
+
+	return DL_ERROR_OK;
+}
+
+dl_error_t DL_DLL_EXPORT dl_instance_load_inplace( dl_ctx_t       dl_ctx,          dl_typeid_t type_id,
+												   unsigned char* packed_instance, size_t      packed_instance_size,
+												   void**         loaded_instance, size_t*     consumed)
+{
+	dl_data_header* header = (dl_data_header*)packed_instance;
+
+	if( packed_instance_size < sizeof(dl_data_header) ) return DL_ERROR_MALFORMED_DATA;
+
 	uint8_t* instance_ptr = packed_instance + sizeof(dl_data_header);
-	dl_internal_patch_instance( dl_ctx, type, instance_ptr, 0x0, (uintptr_t)instance_ptr );
+	dl_error_t err = dl_internal_instance_load_detached_header( dl_ctx, type_id, header, instance_ptr, packed_instance_size - sizeof(dl_data_header) );
+	if( err != DL_ERROR_OK )
+		return err;
 
 	*loaded_instance = instance_ptr;
 
 	if( consumed )
-		*consumed = header->instance_size + sizeof(dl_data_header);
+		*consumed = dl_internal_packed_instance_size( header );
 
 	return DL_ERROR_OK;
 }
 
+dl_error_t DL_DLL_EXPORT dl_instance_make_self_relative( dl_ctx_t       dl_ctx,          dl_typeid_t type,
+														 unsigned char* packed_instance, size_t      packed_instance_size )
+{
+	dl_data_header* header = (dl_data_header*)packed_instance;
+
+	if( packed_instance_size < sizeof(dl_data_header) ) return DL_ERROR_MALFORMED_DATA;
+	if( header->id == DL_INSTANCE_ID_SWAPED )           return DL_ERROR_ENDIAN_MISMATCH;
+	if( header->id != DL_INSTANCE_ID )                  return DL_ERROR_MALFORMED_DATA;
+	if( header->version != DL_INSTANCE_VERSION )        return DL_ERROR_VERSION_MISMATCH;
+	if( header->root_instance_type != type )            return DL_ERROR_TYPE_MISMATCH;
+	if( dl_internal_packed_instance_size( header ) > packed_instance_size ) return DL_ERROR_MALFORMED_DATA;
+	if( ( header->is_64_bit_ptr != 0 ) != ( sizeof(void*) == 8 ) ) return DL_ERROR_UNSUPPORTED_OPERATION;
+
+	if( header->flags & DL_DATA_HEADER_FLAG_SELF_RELATIVE )
+		return DL_ERROR_OK;
+
+	const dl_type_desc* root_type = dl_internal_find_type( dl_ctx, header->root_instance_type );
+	if( root_type == 0x0 )
+		return DL_ERROR_TYPE_NOT_FOUND;
+
+	uint8_t* instance_ptr = packed_instance + sizeof(dl_data_header);
+	if( header->flags & DL_DATA_HEADER_FLAG_HAS_RELOC_TABLE )
+	{
+		const uint32_t* relocs = (const uint32_t*)( instance_ptr + dl_internal_reloc_table_offset( header ) );
+		dl_internal_make_relocs_self_relative( instance_ptr, relocs, header->reloc_count );
+	}
+	else
+		dl_internal_make_self_relative( dl_ctx, root_type, instance_ptr );
+
+	// the relocation table, if any, is kept as is so that the packed size stays the same.
+	header->flags |= DL_DATA_HEADER_FLAG_SELF_RELATIVE;
+	return DL_ERROR_OK;
+}
+
 struct CDLBinStoreContext
 {
-	CDLBinStoreContext( uint8_t* out_data, size_t out_data_size, bool is_dummy, dl_allocator alloc )
-	    : written_ptrs(alloc)
+	CDLBinStoreContext( dl_ctx_t dl_ctx, uint8_t* out_data, size_t out_data_size, bool is_dummy, bool store_relocs, dl_allocator alloc )
+	    : dl_ctx(dl_ctx)
+		, written_ptrs(alloc)
+		, written_ptrs_index(alloc)
 		, strings(alloc)
+		, strings_index(alloc)
+		, relocs(alloc)
+		, store_relocs(store_relocs)
 	{
 		dl_binary_writer_init( &writer, out_data, out_data_size, is_dummy, DL_ENDIAN_HOST, DL_ENDIAN_HOST, DL_PTR_SIZE_HOST );
 	}
 
-	uintptr_t FindWrittenPtr( void* ptr )
+	// call before writing a pointer at current position in writer.
+	void AddReloc()
 	{
-		for (size_t i = 0; i < written_ptrs.Len(); ++i)
-			if( written_ptrs[i].ptr == ptr )
-				return written_ptrs[i].pos;
+		if( store_relocs )
+			relocs.Add( (uint32_t)dl_binary_writer_tell( &writer ) );
+	}
 
-		return (uintptr_t)-1;
+	uintptr_t FindWrittenPtr( void* ptr )
+	{
+		uint32_t index = written_ptrs_index.Find( dl_internal_hash_pointer( ptr ), [this, ptr]( uint32_t i ) { return written_ptrs[i].ptr == ptr; } );
+		return index == UINT32_MAX ? (uintptr_t)-1 : written_ptrs[index].pos;
 	}
 
 	void AddWrittenPtr( const void* ptr, uintptr_t pos )
 	{
+		written_ptrs_index.Insert( dl_internal_hash_pointer( ptr ), (uint32_t)written_ptrs.Len() );
 		written_ptrs.Add( { pos, ptr } );
 	}
 
 	uint32_t GetStringOffset(const char* str, uint32_t length, uint32_t hash)
 	{
-		for (size_t i = 0; i < strings.Len(); ++i)
-			if (strings[i].hash == hash && strings[i].length == length && strcmp(str, strings[i].str) == 0)
-				return strings[i].offset;
+		uint32_t index = strings_index.Find( hash, [this, str, length]( uint32_t i ) { return strings[i].length == length && memcmp( str, strings[i].str, length ) == 0; } );
+		return index == UINT32_MAX ? 0 : strings[index].offset;
+	}
 
-		return 0;
+	void AddString( const char* str, uint32_t length, uint32_t hash, uint32_t offset )
+	{
+		strings_index.Insert( hash, (uint32_t)strings.Len() );
+		strings.Add( { str, length, hash, offset } );
 	}
 
+	dl_ctx_t         dl_ctx; // only used by the dl_bin_gen_store_*-functions called from generated code.
 	dl_binary_writer writer;
 
 	struct SWrittenPtr
@@ -144,6 +382,7 @@ struct CDLBinStoreContext
 		const void* ptr;
 	};
 	CArrayStatic<SWrittenPtr, 128> written_ptrs;
+	CHashIndexStatic<256>          written_ptrs_index;
 
 	struct SString
 	{
@@ -153,11 +392,16 @@ struct CDLBinStoreContext
 		uint32_t offset;
 	};
 	CArrayStatic<SString, 128> strings;
+	CHashIndexStatic<256>      strings_index;
+
+	dl_reloc_array relocs;
+	bool           store_relocs;
 };
 
 static void dl_internal_store_string( const uint8_t* instance, CDLBinStoreContext* store_ctx )
 {
 	char* str = *(char**)instance;
+	store_ctx->AddReloc();
 	if( str == 0x0 )
 	{
 		dl_binary_writer_write( &store_ctx->writer, &DL_NULL_PTR_OFFSET[ DL_PTR_SIZE_HOST ], sizeof(uintptr_t) );
@@ -172,7 +416,7 @@ static void dl_internal_store_string( const uint8_t* instance, CDLBinStoreContex
 		dl_binary_writer_seek_end(&store_ctx->writer);
 		offset = dl_binary_writer_tell(&store_ctx->writer);
 		dl_binary_writer_write(&store_ctx->writer, str, length + 1);
-		store_ctx->strings.Add( {str, length, hash, (uint32_t) offset} );
+		store_ctx->AddString( str, length, hash, (uint32_t) offset );
 		dl_binary_writer_seek_set(&store_ctx->writer, pos);
 	}
 	dl_binary_writer_write( &store_ctx->writer, &offset, sizeof(uintptr_t) );
@@ -180,7 +424,12 @@ static void dl_internal_store_string( const uint8_t* instance, CDLBinStoreContex
 
 static dl_error_t dl_internal_instance_store( dl_ctx_t dl_ctx, const dl_type_desc* type, uint8_t* instance, CDLBinStoreContext* store_ctx );
 
-static dl_error_t dl_internal_store_ptr( dl_ctx_t dl_ctx, uint8_t* instance, const dl_type_desc* sub_type, CDLBinStoreContext* store_ctx )
+/**
+ * Store the instance pointed to by the pointer at instance, if not already stored, and write its offset.
+ * store_func( data, offset ) is called to store the pointed to instance at offset, size is the aligned size of the instance.
+ */
+template <typename STORE_FUNC>
+static dl_error_t dl_internal_store_ptr_with( uint8_t* instance, uintptr_t size, uint32_t alignment, CDLBinStoreContext* store_ctx, STORE_FUNC store_func )
 {
 	uint8_t* data = *(uint8_t**)instance;
 	uintptr_t offset = store_ctx->FindWrittenPtr( data );
@@ -194,10 +443,7 @@ static dl_error_t dl_internal_store_ptr( dl_ctx_t dl_ctx, uint8_t* instance, con
 	{
 		uintptr_t pos = dl_binary_writer_tell( &store_ctx->writer );
 		dl_binary_writer_seek_end( &store_ctx->writer );
-
-		// const dl_type_desc* sub_type = dl_internal_find_type( dl_ctx, member->type_id );
-		uintptr_t size = dl_internal_align_up( sub_type->size[DL_PTR_SIZE_HOST], sub_type->alignment[DL_PTR_SIZE_HOST] );
-		dl_binary_writer_align( &store_ctx->writer, sub_type->alignment[DL_PTR_SIZE_HOST] );
+		dl_binary_writer_align( &store_ctx->writer, alignment );
 
 		offset = dl_binary_writer_tell( &store_ctx->writer );
 
@@ -206,24 +452,34 @@ static dl_error_t dl_internal_store_ptr( dl_ctx_t dl_ctx, uint8_t* instance, con
 
 		store_ctx->AddWrittenPtr(data, offset);
 
-		dl_error_t err = dl_internal_instance_store(dl_ctx, sub_type, data, store_ctx);
+		dl_error_t err = store_func( data, offset );
 		if (DL_ERROR_OK != err)
 			return err;
 		dl_binary_writer_seek_set( &store_ctx->writer, pos );
 	}
 
+	store_ctx->AddReloc();
 	dl_binary_writer_write( &store_ctx->writer, &offset, sizeof(uintptr_t) );
 	return DL_ERROR_OK;
 }
 
+static dl_error_t dl_internal_store_ptr( dl_ctx_t dl_ctx, uint8_t* instance, const dl_type_desc* sub_type, CDLBinStoreContext* store_ctx )
+{
+	const dl_type_hot* sub_hot = dl_internal_type_hot( dl_ctx, sub_type );
+	uintptr_t size = dl_internal_align_up( sub_hot->size, sub_hot->alignment );
+	return dl_internal_store_ptr_with( instance, size, sub_hot->alignment, store_ctx,
+		[dl_ctx, sub_type, store_ctx]( uint8_t* data, uintptr_t ) { return dl_internal_instance_store( dl_ctx, sub_type, data, store_ctx ); } );
+}
+
 static dl_error_t dl_internal_store_array( dl_ctx_t dl_ctx, dl_type_storage_t storage_type, const dl_type_desc* sub_type, uint8_t* instance, uint32_t count, uintptr_t size, CDLBinStoreContext* store_ctx )
 {
 	switch( storage_type )
 	{
 		case DL_TYPE_STORAGE_STRUCT:
 		{
-			uintptr_t size_ = sub_type->size[DL_PTR_SIZE_HOST];
-			if( sub_type->flags & DL_TYPE_FLAG_HAS_SUBDATA )
+			const dl_type_hot* sub_hot = dl_internal_type_hot( dl_ctx, sub_type );
+			uintptr_t size_ = sub_hot->size;
+			if( sub_hot->flags & DL_TYPE_FLAG_HAS_SUBDATA )
 			{
 				for (uint32_t elem = 0; elem < count; ++elem)
 				{
@@ -251,10 +507,12 @@ static dl_error_t dl_internal_store_array( dl_ctx_t dl_ctx, dl_type_storage_t st
 	return DL_ERROR_OK;
 }
 
-static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_desc* member, uint8_t* instance, CDLBinStoreContext* store_ctx )
+static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_type_plan_op* op, uint8_t* instance, CDLBinStoreContext* store_ctx )
 {
-	dl_type_atom_t    atom_type    = member->AtomType();
-	dl_type_storage_t storage_type = member->StorageType();
+	dl_type_atom_t    atom_type    = op->AtomType();
+	dl_type_storage_t storage_type = op->StorageType();
+	const dl_member_desc* member   = &dl_ctx->member_descs[op->member];
+	const dl_type_desc*   sub_type = dl_internal_plan_op_sub_type( dl_ctx, op );
 
 	switch ( atom_type )
 	{
@@ -264,7 +522,6 @@ static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_des
 			{
 				case DL_TYPE_STORAGE_STRUCT:
 				{
-					const dl_type_desc* sub_type = dl_internal_find_type( dl_ctx, member->type_id );
 					if( sub_type == 0x0 )
 					{
 						dl_log_error( dl_ctx, "Could not find subtype for member %s", dl_internal_member_name( dl_ctx, member ) );
@@ -280,7 +537,6 @@ static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_des
 					break;
 				case DL_TYPE_STORAGE_PTR:
 				{
-					const dl_type_desc* sub_type = dl_internal_find_type( dl_ctx, member->type_id );
 					if( sub_type == 0x0 )
 					{
 						dl_log_error( dl_ctx, "Could not find subtype for member %s", dl_internal_member_name( dl_ctx, member ) );
@@ -293,7 +549,7 @@ static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_des
 				break;
 				default: // default is a standard pod-type
 					DL_ASSERT( member->IsSimplePod() );
-					dl_binary_writer_write( &store_ctx->writer, instance, member->size[DL_PTR_SIZE_HOST] );
+					dl_binary_writer_write( &store_ctx->writer, instance, dl_ctx->member_hot[op->member].size );
 					break;
 			}
 		}
@@ -301,12 +557,10 @@ static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_des
 
 		case DL_TYPE_ATOM_INLINE_ARRAY:
 		{
-			const dl_type_desc* sub_type = 0x0;
-			uint32_t count = member->inline_array_cnt();
+			uint32_t count = op->count;
 			if( storage_type == DL_TYPE_STORAGE_STRUCT ||
 				storage_type == DL_TYPE_STORAGE_PTR )
 			{
-				sub_type = dl_internal_find_type(dl_ctx, member->type_id);
 				if (sub_type == 0x0)
 				{
 					dl_log_error(dl_ctx, "Could not find subtype for member %s", dl_internal_member_name(dl_ctx, member));
@@ -314,7 +568,7 @@ static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_des
 				}
 			}
 			else if( storage_type != DL_TYPE_STORAGE_STR )
-				count = member->size[DL_PTR_SIZE_HOST];
+				count = dl_ctx->member_hot[op->member].size;
 
 			dl_internal_store_array( dl_ctx, storage_type, sub_type, instance, count, 1, store_ctx );
 		}
@@ -323,7 +577,6 @@ static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_des
 		case DL_TYPE_ATOM_ARRAY:
 		{
 			uintptr_t size = 0;
-			const dl_type_desc* sub_type = 0x0;
 
 			uint8_t* data_ptr = instance;
 			uint32_t count    = *(uint32_t*)( data_ptr + sizeof(void*) );
@@ -340,15 +593,14 @@ static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_des
 				switch(storage_type)
 				{
 					case DL_TYPE_STORAGE_STRUCT:
-						sub_type = dl_internal_find_type( dl_ctx, member->type_id );
-						size = dl_internal_align_up( sub_type->size[DL_PTR_SIZE_HOST], sub_type->alignment[DL_PTR_SIZE_HOST] );
-						dl_binary_writer_align( &store_ctx->writer, sub_type->alignment[DL_PTR_SIZE_HOST] );
-						break;
-					case DL_TYPE_STORAGE_PTR:
-						sub_type = dl_internal_find_type( dl_ctx, member->type_id );
-						/*fallthrough*/
+					{
+						const dl_type_hot* sub_hot = dl_internal_type_hot( dl_ctx, sub_type );
+						size = dl_internal_align_up( sub_hot->size, sub_hot->alignment );
+						dl_binary_writer_align( &store_ctx->writer, sub_hot->alignment );
+					}
+					break;
 					default:
-						size = dl_pod_size( member->StorageType() );
+						size = dl_pod_size( storage_type );
 						dl_binary_writer_align( &store_ctx->writer, size );
 				}
 
@@ -366,6 +618,7 @@ static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_des
 			}
 
 			// make room for ptr
+			store_ctx->AddReloc();
 			dl_binary_writer_write( &store_ctx->writer, &offset, sizeof(uintptr_t) );
 
 			// write count
@@ -374,7 +627,7 @@ static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_des
 		return DL_ERROR_OK;
 
 		case DL_TYPE_ATOM_BITFIELD:
-			dl_binary_writer_write( &store_ctx->writer, instance, member->size[DL_PTR_SIZE_HOST] );
+			dl_binary_writer_write( &store_ctx->writer, instance, dl_ctx->member_hot[op->member].size );
 		break;
 
 		default:
@@ -387,12 +640,16 @@ static dl_error_t dl_internal_store_member( dl_ctx_t dl_ctx, const dl_member_des
 
 static dl_error_t dl_internal_instance_store( dl_ctx_t dl_ctx, const dl_type_desc* type, uint8_t* instance, CDLBinStoreContext* store_ctx )
 {
-	bool last_was_bitfield = false;
-
-	dl_binary_writer_align( &store_ctx->writer, type->alignment[DL_PTR_SIZE_HOST] );
+	const dl_type_hot* hot = dl_internal_type_hot( dl_ctx, type );
+	dl_binary_writer_align( &store_ctx->writer, hot->alignment );
 
 	uintptr_t instance_pos = dl_binary_writer_tell( &store_ctx->writer );
-	if( type->flags & DL_TYPE_FLAG_IS_UNION )
+
+	const dl_bin_gen_funcs* gen = dl_internal_find_bin_gen( dl_ctx, type );
+	if( gen != 0x0 && gen->store != 0x0 )
+		return gen->store( store_ctx, instance, instance_pos );
+
+	if( hot->flags & DL_TYPE_FLAG_IS_UNION )
 	{
 		size_t type_offset = dl_internal_union_type_offset( dl_ctx, type, DL_PTR_SIZE_HOST );
 
@@ -405,7 +662,8 @@ static dl_error_t dl_internal_instance_store( dl_ctx_t dl_ctx, const dl_type_des
 			return DL_ERROR_MALFORMED_DATA;
 		}
 
-		dl_error_t err = dl_internal_store_member( dl_ctx, member, instance + member->offset[DL_PTR_SIZE_HOST], store_ctx );
+		dl_type_plan_op op = dl_internal_plan_op_from_member( dl_ctx, member );
+		dl_error_t err = dl_internal_store_member( dl_ctx, &op, instance + dl_internal_member_hot( dl_ctx, member )->offset, store_ctx );
 		if( err != DL_ERROR_OK )
 			return err;
 
@@ -414,25 +672,134 @@ static dl_error_t dl_internal_instance_store( dl_ctx_t dl_ctx, const dl_type_des
 	}
 	else
 	{
-		for( uint32_t member_index = 0; member_index < type->member_count; ++member_index )
+		const dl_type_plan* plan = dl_internal_type_plan( dl_ctx, type );
+
+		// ... all plain data first, the order only matter for members with subdata and where the writer is left ...
+		const dl_type_plan_copy* copies = &dl_ctx->plan_copies[plan->copy_start];
+		for( uint32_t copy_index = 0; copy_index < plan->copy_count; ++copy_index )
+		{
+			dl_binary_writer_seek_set( &store_ctx->writer, instance_pos + copies[copy_index].offset );
+			dl_binary_writer_write( &store_ctx->writer, instance + copies[copy_index].offset, copies[copy_index].size );
+		}
+
+		const dl_type_plan_op* ops = &dl_ctx->plan_ops[plan->op_start];
+		for( uint32_t op_index = 0; op_index < plan->op_count; ++op_index )
 		{
-			const dl_member_desc* member = dl_get_type_member( dl_ctx, type, member_index );
+			const dl_type_plan_op* op = &ops[op_index];
+			dl_binary_writer_seek_set( &store_ctx->writer, instance_pos + op->offset[DL_PTR_SIZE_HOST] );
+			dl_error_t err = dl_internal_store_member( dl_ctx, op, instance + op->offset[DL_PTR_SIZE_HOST], store_ctx );
+			if( err != DL_ERROR_OK )
+				return err;
+		}
+
+		// ... leave the writer after the last member, as if all members were stored in order, arrays of structs depend on it ...
+		if( plan->ends_with_copy && plan->op_count > 0 )
+			dl_binary_writer_seek_set( &store_ctx->writer, instance_pos + copies[plan->copy_count - 1].offset + copies[plan->copy_count - 1].size );
+	}
+
+	return DL_ERROR_OK;
+}
+
+// ... support for store-routines generated by dltlc, see dl_bin_gen.h ...
+
+void dl_bin_gen_store_write( dl_bin_gen_store_t store_ctx, size_t pos, const void* data, size_t size )
+{
+	dl_binary_writer_seek_set( &store_ctx->writer, pos );
+	dl_binary_writer_write( &store_ctx->writer, data, size );
+}
+
+void dl_bin_gen_store_str( dl_bin_gen_store_t store_ctx, size_t pos, const uint8_t* str )
+{
+	dl_binary_writer_seek_set( &store_ctx->writer, pos );
+	dl_internal_store_string( str, store_ctx );
+}
+
+dl_error_t dl_bin_gen_store_ptr( dl_bin_gen_store_t store_ctx, size_t pos, const uint8_t* ptr, uint32_t size, uint32_t alignment, dl_bin_gen_store_func store )
+{
+	dl_binary_writer_seek_set( &store_ctx->writer, pos );
+	return dl_internal_store_ptr_with( (uint8_t*)ptr, size, alignment, store_ctx,
+		[store_ctx, store]( uint8_t* data, uintptr_t offset ) { return store( store_ctx, data, offset ); } );
+}
 
-			if( !last_was_bitfield || member->AtomType() != DL_TYPE_ATOM_BITFIELD )
+dl_error_t dl_bin_gen_store_array( dl_bin_gen_store_t store_ctx, size_t pos, const uint8_t* array, uint32_t element_size, uint32_t element_alignment, dl_bin_gen_store_func store )
+{
+	const uint8_t* data  = *(const uint8_t* const*)array;
+	uint32_t       count = *(const uint32_t*)( array + sizeof(void*) );
+
+	uintptr_t offset = DL_NULL_PTR_OFFSET[ DL_PTR_SIZE_HOST ];
+	if( count > 0 )
+	{
+		dl_binary_writer_seek_end( &store_ctx->writer );
+		dl_binary_writer_align( &store_ctx->writer, element_alignment );
+		offset = dl_binary_writer_tell( &store_ctx->writer );
+
+		// reserve space for array so subdata is placed correctly
+		dl_binary_writer_reserve( &store_ctx->writer, (size_t)count * element_size );
+
+		if( store == 0x0 )
+			dl_binary_writer_write( &store_ctx->writer, data, (size_t)count * element_size );
+		else
+		{
+			for( uint32_t elem = 0; elem < count; ++elem )
 			{
-				dl_binary_writer_seek_set( &store_ctx->writer, instance_pos + member->offset[DL_PTR_SIZE_HOST] );
-				dl_error_t err = dl_internal_store_member( dl_ctx, member, instance + member->offset[DL_PTR_SIZE_HOST], store_ctx );
+				// ... padding between elements is zeroed the same way as by the generic code ...
+				dl_binary_writer_align( &store_ctx->writer, element_alignment );
+				dl_error_t err = store( store_ctx, data + (size_t)elem * element_size, offset + (size_t)elem * element_size );
 				if( err != DL_ERROR_OK )
 					return err;
 			}
-
-			last_was_bitfield = member->AtomType() == DL_TYPE_ATOM_BITFIELD;
 		}
 	}
 
+	dl_binary_writer_seek_set( &store_ctx->writer, pos );
+	store_ctx->AddReloc();
+	dl_binary_writer_write( &store_ctx->writer, &offset, sizeof(uintptr_t) );
+	dl_binary_writer_write( &store_ctx->writer, &count, sizeof(uint32_t) );
 	return DL_ERROR_OK;
 }
 
+dl_error_t dl_bin_gen_store_member( dl_bin_gen_store_t store_ctx, dl_typeid_t type_id, uint32_t member_index, const uint8_t* instance, size_t instance_pos )
+{
+	dl_ctx_t dl_ctx = store_ctx->dl_ctx;
+	const dl_member_desc* member = dl_get_type_member( dl_ctx, dl_internal_find_type( dl_ctx, type_id ), member_index );
+	dl_type_plan_op op = dl_internal_plan_op_from_member( dl_ctx, member );
+	dl_binary_writer_seek_set( &store_ctx->writer, instance_pos + member->offset[DL_PTR_SIZE_HOST] );
+	return dl_internal_store_member( dl_ctx, &op, (uint8_t*)instance + member->offset[DL_PTR_SIZE_HOST], store_ctx );
+}
+
+static void dl_internal_init_data_header( dl_data_header* header, dl_typeid_t type_id )
+{
+	header->id = DL_INSTANCE_ID;
+	header->version = DL_INSTANCE_VERSION;
+	header->root_instance_type = type_id;
+	header->instance_size = 0;
+	header->is_64_bit_ptr = sizeof(void*) == 8 ? 1 : 0;
+	header->flags = 0;
+	header->pad[0] = header->pad[1] = 0;
+	header->reloc_count = 0;
+}
+
+/**
+ * Store instance and, if requested, the relocation table after it. instance_size, flags and reloc_count in header is
+ * updated and the writer is left at the end of all written data.
+ */
+static dl_error_t dl_internal_store_root( dl_ctx_t dl_ctx, const dl_type_desc* type, const void* instance, CDLBinStoreContext* store_ctx, dl_data_header* header )
+{
+	dl_binary_writer_reserve( &store_ctx->writer, type->size[DL_PTR_SIZE_HOST] );
+	store_ctx->AddWrittenPtr(instance, 0); // if pointer refere to root-node, it can be found at offset 0
+
+	dl_error_t err = dl_internal_instance_store( dl_ctx, type, (uint8_t*)instance, store_ctx );
+	dl_binary_writer_seek_end( &store_ctx->writer );
+	header->instance_size = (uint32_t)dl_binary_writer_tell( &store_ctx->writer );
+
+	if( err == DL_ERROR_OK && store_ctx->store_relocs )
+	{
+		header->flags      |= DL_DATA_HEADER_FLAG_HAS_RELOC_TABLE;
+		header->reloc_count = dl_internal_write_reloc_table( &store_ctx->writer, &store_ctx->relocs );
+	}
+	return err;
+}
+
 dl_error_t dl_instance_store( dl_ctx_t       dl_ctx,     dl_typeid_t type_id,         const void* instance,
 							  unsigned char* out_buffer, size_t      out_buffer_size, size_t*     produced_bytes )
 {
@@ -443,14 +810,8 @@ dl_error_t dl_instance_store( dl_ctx_t       dl_ctx,     dl_typeid_t type_id,
 	if( type == 0x0 )
 		return DL_ERROR_TYPE_NOT_FOUND;
 
-	// write header
 	dl_data_header header;
-	header.id = DL_INSTANCE_ID;
-	header.version = DL_INSTANCE_VERSION;
-	header.root_instance_type = type_id;
-	header.instance_size = 0;
-	header.is_64_bit_ptr = sizeof(void*) == 8 ? 1 : 0;
-	header.pad[0] = header.pad[1] = header.pad[2] = 0;
+	dl_internal_init_data_header( &header, type_id );
 
 	unsigned char* store_ctx_buffer      = 0x0;
 	size_t         store_ctx_buffer_size = 0;
@@ -458,33 +819,71 @@ dl_error_t dl_instance_store( dl_ctx_t       dl_ctx,     dl_typeid_t type_id,
 
 	if( out_buffer_size > 0 )
 	{
-		memcpy(out_buffer, &header, sizeof(dl_data_header));
 		store_ctx_buffer      = out_buffer + sizeof(dl_data_header);
 		store_ctx_buffer_size = out_buffer_size - sizeof(dl_data_header);
 	}
 
-	CDLBinStoreContext store_context( store_ctx_buffer, store_ctx_buffer_size, store_ctx_is_dummy, dl_ctx->alloc );
-
-	dl_binary_writer_reserve( &store_context.writer, type->size[DL_PTR_SIZE_HOST] );
-	store_context.AddWrittenPtr(instance, 0); // if pointer refere to root-node, it can be found at offset 0
+	CDLBinStoreContext store_context( dl_ctx, store_ctx_buffer, store_ctx_buffer_size, store_ctx_is_dummy, dl_ctx->store_reloc_table, dl_ctx->alloc );
 
-	dl_error_t err = dl_internal_instance_store( dl_ctx, type, (uint8_t*)instance, &store_context );
+	dl_error_t err = dl_internal_store_root( dl_ctx, type, instance, &store_context, &header );
 
-	// write instance size!
-	dl_data_header* out_header = (dl_data_header*)out_buffer;
-	dl_binary_writer_seek_end( &store_context.writer );
-	if( out_buffer )
-		out_header->instance_size = (uint32_t)dl_binary_writer_tell( &store_context.writer );
+	// write header, instance size is known now!
+	if( out_buffer_size > 0 )
+		memcpy(out_buffer, &header, sizeof(dl_data_header));
 
 	if( produced_bytes )
 		*produced_bytes = (uint32_t)dl_binary_writer_tell( &store_context.writer ) + sizeof(dl_data_header);
 
-	if( out_buffer_size > 0 && out_header->instance_size > out_buffer_size )
+	if( out_buffer_size > 0 && dl_internal_packed_instance_size( &header ) > out_buffer_size )
 		return DL_ERROR_BUFFER_TO_SMALL;
 
 	return err;
 }
 
+dl_error_t dl_instance_store_alloc( dl_ctx_t        dl_ctx,     dl_typeid_t type_id, const void* instance,
+									unsigned char** out_buffer, size_t*     out_buffer_size )
+{
+	const dl_type_desc* type = dl_internal_find_type( dl_ctx, type_id );
+	if( type == 0x0 )
+		return DL_ERROR_TYPE_NOT_FOUND;
+
+	CDLBinStoreContext store_context( dl_ctx, 0x0, 0, false, dl_ctx->store_reloc_table, dl_ctx->alloc );
+	dl_binary_writer_init_alloc( &store_context.writer, &dl_ctx->alloc, sizeof(dl_data_header) );
+
+	dl_data_header stored_header;
+	dl_internal_init_data_header( &stored_header, type_id );
+	dl_error_t err = dl_internal_store_root( dl_ctx, type, instance, &store_context, &stored_header );
+
+	// make sure that reserved but unwritten space at the end is allocated as well, written_size includes the relocation table if any.
+	size_t written_size = dl_binary_writer_tell( &store_context.writer );
+	dl_binary_writer_grow( &store_context.writer, written_size );
+
+	uint8_t* buffer      = store_context.writer.data ? store_context.writer.data - sizeof(dl_data_header) : 0x0;
+	size_t   buffer_size = store_context.writer.data_size + sizeof(dl_data_header);
+
+	if( err == DL_ERROR_OK && store_context.writer.data_size < written_size )
+		err = DL_ERROR_OUT_OF_INSTANCE_MEMORY;
+
+	if( err != DL_ERROR_OK )
+	{
+		if( buffer )
+			dl_free( &dl_ctx->alloc, buffer );
+		return err;
+	}
+
+	// ... shrink to what was actually used ...
+	size_t stored_size = written_size + sizeof(dl_data_header);
+	uint8_t* shrunk = (uint8_t*)dl_realloc( &dl_ctx->alloc, buffer, stored_size, buffer_size );
+	if( shrunk != 0x0 )
+		buffer = shrunk;
+
+	memcpy( buffer, &stored_header, sizeof(dl_data_header) );
+
+	*out_buffer      = buffer;
+	*out_buffer_size = stored_size;
+	return DL_ERROR_OK;
+}
+
 dl_error_t dl_instance_calc_size( dl_ctx_t dl_ctx, dl_typeid_t type, void* instance, size_t* out_size )
 {
 	return dl_instance_store( dl_ctx, type, instance, 0x0, 0, out_size );
@@ -52,7 +52,7 @@ inline void* dl_realloc( dl_allocator* alloc, void* ptr, size_t size, size_t old
 	void* new_ptr = dl_alloc( alloc, size );
 	if( ptr != 0x0 )
 	{
-		memcpy( new_ptr, ptr, old_size );
+		memcpy( new_ptr, ptr, old_size < size ? old_size : size );
 		dl_free( alloc, ptr );
 	}
 	return new_ptr;
@@ -22,6 +22,11 @@ struct dl_binary_writer
 	size_t        needed_size;
 	uint8_t*      data;
 	size_t        data_size;
+	dl_allocator* alloc;        ///< if set, data is grown via this allocator when writing past data_size.
+	size_t        alloc_header; ///< bytes allocated in front of data when growing, i.e. data - alloc_header is the allocation.
+	void        (*flush_func)( const uint8_t* data, size_t size, void* flush_ctx ); ///< if set, data is flushed to this when full.
+	void*         flush_ctx;
+	size_t        flushed;      ///< bytes passed to flush_func, these are not included in pos and needed_size.
 };
 
 static inline void dl_binary_writer_init( dl_binary_writer* writer,
@@ -37,6 +42,71 @@ static inline void dl_binary_writer_init( dl_binary_writer* writer,
 	writer->needed_size    = 0;
 	writer->data           = out_data;
 	writer->data_size      = out_data_size;
+	writer->alloc          = 0x0;
+	writer->alloc_header   = 0;
+	writer->flush_func     = 0x0;
+	writer->flush_ctx      = 0x0;
+	writer->flushed        = 0;
+}
+
+/**
+ * Make writer allocate and grow its own buffer via alloc, leaving header_size bytes in front of the written data
+ * for the caller to fill. The buffer, starting at data - header_size, is owned by the caller after the write is done.
+ */
+static inline void dl_binary_writer_init_alloc( dl_binary_writer* writer, dl_allocator* alloc, size_t header_size )
+{
+	writer->dummy        = false;
+	writer->data         = 0x0;
+	writer->data_size    = 0;
+	writer->alloc        = alloc;
+	writer->alloc_header = header_size;
+}
+
+/**
+ * Make writer pass the data written to flush_func each time data is full instead of growing it, after which writing
+ * continues at the start of data. Only sequential writes via dl_binary_writer_write() are supported in this mode and
+ * the last written data need to be passed on with dl_binary_writer_flush() when done.
+ */
+static inline void dl_binary_writer_init_flush( dl_binary_writer* writer, void (*flush_func)( const uint8_t*, size_t, void* ), void* flush_ctx )
+{
+	writer->flush_func = flush_func;
+	writer->flush_ctx  = flush_ctx;
+	writer->flushed    = 0;
+}
+
+static inline void dl_binary_writer_flush( dl_binary_writer* writer )
+{
+	if( writer->pos > 0 )
+		writer->flush_func( writer->data, writer->pos, writer->flush_ctx );
+	writer->flushed    += writer->pos;
+	writer->pos         = 0;
+	writer->needed_size = 0;
+}
+
+/**
+ * Make sure that writer->data can hold at least min_size bytes if writer is growable. The new memory is zeroed
+ * so that padding-bytes that are never written are deterministic.
+ */
+static inline void dl_binary_writer_grow( dl_binary_writer* writer, size_t min_size )
+{
+	if( writer->alloc == 0x0 || min_size <= writer->data_size )
+		return;
+
+	size_t new_size = writer->data_size * 2;
+	if( new_size < min_size )
+		new_size = min_size;
+	if( new_size < 256 )
+		new_size = 256;
+
+	uint8_t* old_alloc = writer->data ? writer->data - writer->alloc_header : 0x0;
+	size_t   old_size  = writer->data ? writer->data_size + writer->alloc_header : 0;
+	uint8_t* new_alloc = (uint8_t*)dl_realloc( writer->alloc, old_alloc, new_size + writer->alloc_header, old_size );
+	if( new_alloc == 0x0 )
+		return; // out of memory, writes will be skipped and caller has to check needed_size against data_size.
+
+	writer->data = new_alloc + writer->alloc_header;
+	memset( writer->data + writer->data_size, 0x0, new_size - writer->data_size );
+	writer->data_size = new_size;
 }
 
 static inline void   dl_binary_writer_seek_set( dl_binary_writer* writer, size_t pos ) { writer->pos  = pos;                 DL_LOG_BIN_WRITER_VERBOSE("Seek Set: " DL_PINT_FMT_STR, writer->pos); }
@@ -51,6 +121,23 @@ static inline void dl_binary_writer_update_needed_size( dl_binary_writer* writer
 
 static inline void dl_binary_writer_write( dl_binary_writer* writer, const void* data, size_t size )
 {
+	if( writer->pos + size > writer->data_size )
+	{
+		if( writer->flush_func != 0x0 )
+		{
+			dl_binary_writer_flush( writer );
+			if( size > writer->data_size )
+			{
+				// ... does not fit at all, pass it straight on ...
+				writer->flush_func( (const uint8_t*)data, size, writer->flush_ctx );
+				writer->flushed += size;
+				return;
+			}
+		}
+		else
+			dl_binary_writer_grow( writer, writer->pos + size );
+	}
+
 	if( !writer->dummy && ( writer->pos + size <= writer->data_size ) )
 	{
 		switch( size )
@@ -153,21 +240,18 @@ static inline void dl_binary_writer_write_array( dl_binary_writer* writer, const
 		}
 	}
 
-	if( writer->source_endian != writer->target_endian )
+	if( writer->source_endian != writer->target_endian && elem_size > 1 )
 	{
-		for(size_t i = 0; i < count; ++i)
-		{
-			switch( elem_size )
-			{
-				case 1: dl_binary_writer_write_1byte( writer, (const uint8_t*)array + i * elem_size ); break;
-				case 2: dl_binary_writer_write_2byte( writer, (const uint8_t*)array + i * elem_size ); break;
-				case 4: dl_binary_writer_write_4byte( writer, (const uint8_t*)array + i * elem_size ); break;
-				case 8: dl_binary_writer_write_8byte( writer, (const uint8_t*)array + i * elem_size ); break;
-				default:
-					DL_ASSERT( false && "unhandled case!" );
-					break;
-			}
-		}
+		// swap the whole array straight into the output buffer instead of writing element by element.
+		size_t size = elem_size * count;
+		if( writer->pos + size > writer->data_size )
+			dl_binary_writer_grow( writer, writer->pos + size );
+
+		if( !writer->dummy && ( writer->pos + size <= writer->data_size ) )
+			dl_swap_endian_array( writer->data + writer->pos, array, count, elem_size );
+
+		writer->pos += size;
+		dl_binary_writer_update_needed_size( writer );
 	}
 	else
 		dl_binary_writer_write( writer, array, elem_size * count );
@@ -208,6 +292,9 @@ static inline void dl_binary_writer_write_string( dl_binary_writer* writer, cons
 
 static inline void dl_binary_writer_write_zero( dl_binary_writer* writer, size_t bytes )
 {
+	if( writer->pos + bytes > writer->data_size )
+		dl_binary_writer_grow( writer, writer->pos + bytes );
+
 	if( !writer->dummy )
 	{
 		DL_LOG_BIN_WRITER_VERBOSE("Write zero: " DL_PINT_FMT_STR " + " DL_PINT_FMT_STR, writer->pos, bytes);
@@ -233,7 +320,10 @@ static inline uint64_t dl_binary_writer_read_uint64( dl_binary_writer* writer )
 static inline void dl_binary_writer_align( dl_binary_writer* writer, size_t align )
 {
 	size_t alignment = dl_internal_align_up( writer->pos, align );
-	if( !writer->dummy && alignment != writer->pos )
+	if( alignment > writer->data_size )
+		dl_binary_writer_grow( writer, alignment );
+
+	if( !writer->dummy && alignment != writer->pos && alignment <= writer->data_size )
 	{
 		DL_LOG_BIN_WRITER_VERBOSE( "Align: " DL_PINT_FMT_STR " + " DL_PINT_FMT_STR " (" DL_PINT_FMT_STR ")", writer->pos, alignment - writer->pos, align );
 		memset( writer->data + writer->pos, 0x0, alignment - writer->pos);
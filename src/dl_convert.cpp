@@ -39,15 +39,19 @@ public:
 		, src_ptr_size(src_ptr_size)
 		, target_ptr_size(tgt_ptr_size)
 	    , instances(allocator)
+	    , instances_index(allocator)
 	    , m_lPatchOffset(allocator)
 	{}
 
+	void AddInstance( const SInstance& inst )
+	{
+		instances_index.Insert( dl_internal_hash_pointer( inst.address ), (uint32_t)instances.Len() );
+		instances.Add( inst );
+	}
+
 	bool IsSwapped( const uint8_t* ptr )
 	{
-		for(unsigned int i = 0; i < instances.Len(); ++i)
-			if(ptr == instances[i].address)
-				return true;
-		return false;
+		return instances_index.Find( dl_internal_hash_pointer( ptr ), [this, ptr]( uint32_t i ) { return instances[i].address == ptr; } ) != UINT32_MAX;
 	}
 
 	dl_endian_t src_endian;
@@ -56,6 +60,7 @@ public:
 	dl_ptr_size_t target_ptr_size;
 
 	CArrayStatic<SInstance, 128> instances;
+	CHashIndexStatic<256>        instances_index; // index into instances by address, only valid until instances are sorted.
 
 	struct PatchPos
 	{
@@ -77,6 +82,7 @@ static inline void dl_swap_header( dl_data_header* header )
 	header->version            = dl_swap_endian_uint32( header->version );
 	header->root_instance_type = dl_swap_endian_uint32( header->root_instance_type );
 	header->instance_size      = dl_swap_endian_uint32( header->instance_size );
+	header->reloc_count        = dl_swap_endian_uint32( header->reloc_count );
 }
 
 static uintptr_t dl_internal_read_ptr_data( const uint8_t* data,
@@ -183,7 +189,7 @@ static void dl_internal_convert_collect_instances_from_str( const uint8_t*
 {
 	uintptr_t offset = dl_internal_read_ptr_data( member_data, convert_ctx.src_endian, convert_ctx.src_ptr_size );
 	if(offset != DL_NULL_PTR_OFFSET[convert_ctx.src_ptr_size])
-		convert_ctx.instances.Add(SInstance(base_data + offset, 0x0, 1337, dl_make_type(DL_TYPE_ATOM_POD, DL_TYPE_STORAGE_STR)));
+		convert_ctx.AddInstance(SInstance(base_data + offset, 0x0, 1337, dl_make_type(DL_TYPE_ATOM_POD, DL_TYPE_STORAGE_STR)));
 }
 
 static void dl_internal_convert_collect_instances_from_ptr( dl_ctx_t              ctx,
@@ -199,7 +205,7 @@ static void dl_internal_convert_collect_instances_from_ptr( dl_ctx_t
 		const uint8_t* ptr_data = base_data + offset;
 		if(!convert_ctx.IsSwapped(ptr_data))
 		{
-			convert_ctx.instances.Add(SInstance(ptr_data, sub_type, 0, dl_make_type(DL_TYPE_ATOM_POD, DL_TYPE_STORAGE_PTR)));
+			convert_ctx.AddInstance(SInstance(ptr_data, sub_type, 0, dl_make_type(DL_TYPE_ATOM_POD, DL_TYPE_STORAGE_PTR)));
 			dl_internal_convert_collect_instances(ctx, sub_type, base_data + offset, base_data, convert_ctx);
 		}
 	}
@@ -243,14 +249,15 @@ static void dl_internal_convert_collect_instances_from_ptr_array( dl_ctx_t
 		dl_internal_convert_collect_instances_from_ptr( ctx, sub_type, array_data + (elem * ptr_size), base_data, convert_ctx );
 }
 
-static dl_error_t dl_internal_convert_collect_instances_from_member( dl_ctx_t              ctx,
-																	 const dl_member_desc* member,
-																	 const uint8_t*        member_data,
-																	 const uint8_t*        base_data,
-																	 SConvertContext&      convert_ctx )
+static dl_error_t dl_internal_convert_collect_instances_from_member( dl_ctx_t               ctx,
+																	 const dl_type_plan_op* op,
+																	 const uint8_t*         member_data,
+																	 const uint8_t*         base_data,
+																	 SConvertContext&       convert_ctx )
 {
-	dl_type_atom_t    atom_type    = member->AtomType();
-	dl_type_storage_t storage_type = member->StorageType();
+	dl_type_atom_t      atom_type    = op->AtomType();
+	dl_type_storage_t   storage_type = op->StorageType();
+	const dl_type_desc* sub_type     = dl_internal_plan_op_sub_type( ctx, op );
 
 	switch(atom_type)
 	{
@@ -262,10 +269,10 @@ static dl_error_t dl_internal_convert_collect_instances_from_member( dl_ctx_t
 					dl_internal_convert_collect_instances_from_str( member_data, base_data, convert_ctx );
 				break;
 				case DL_TYPE_STORAGE_PTR:
-					dl_internal_convert_collect_instances_from_ptr( ctx, dl_internal_find_type(ctx, member->type_id), member_data, base_data, convert_ctx );
+					dl_internal_convert_collect_instances_from_ptr( ctx, sub_type, member_data, base_data, convert_ctx );
 				break;
 				case DL_TYPE_STORAGE_STRUCT:
-					dl_internal_convert_collect_instances(ctx, dl_internal_find_type(ctx, member->type_id), member_data, base_data, convert_ctx);
+					dl_internal_convert_collect_instances(ctx, sub_type, member_data, base_data, convert_ctx);
 				break;
 				default:
 					break;
@@ -279,27 +286,27 @@ static dl_error_t dl_internal_convert_collect_instances_from_member( dl_ctx_t
 				case DL_TYPE_STORAGE_STRUCT:
 					dl_internal_convert_collect_instances_from_struct_array( ctx,
 																			 member_data,
-																			 member->inline_array_cnt(),
-																			 dl_internal_find_type(ctx, member->type_id),
+																			 op->count,
+																			 sub_type,
 																			 base_data,
 																			 convert_ctx );
 					break;
 				case DL_TYPE_STORAGE_STR:
 					dl_internal_convert_collect_instances_from_str_array( member_data,
-																		  member->inline_array_cnt(),
+																		  op->count,
 																		  base_data,
 																		  convert_ctx );
 					break;
 				case DL_TYPE_STORAGE_PTR:
 					dl_internal_convert_collect_instances_from_ptr_array( ctx,
 																		  member_data,
-																		  member->inline_array_cnt(),
-																		  dl_internal_find_type(ctx, member->type_id),
+																		  op->count,
+																		  sub_type,
 																		  base_data,
 																		  convert_ctx );
 					break;
 				default:
-					DL_ASSERT(member->IsSimplePod());
+					DL_ASSERT(ctx->member_descs[op->member].IsSimplePod());
 					// ignore
 			}
 		}
@@ -317,7 +324,6 @@ static dl_error_t dl_internal_convert_collect_instances_from_member( dl_ctx_t
 			}
 
 			const uint8_t* array_data = base_data + offset;
-			const dl_type_desc* sub_type = 0x0;
 
 			switch(storage_type)
 			{
@@ -325,7 +331,6 @@ static dl_error_t dl_internal_convert_collect_instances_from_member( dl_ctx_t
 					dl_internal_convert_collect_instances_from_str_array(array_data, array_count, base_data, convert_ctx);
 					break;
 				case DL_TYPE_STORAGE_PTR:
-					sub_type = dl_internal_find_type(ctx, member->type_id);
 					dl_internal_convert_collect_instances_from_ptr_array( ctx,
 																		  array_data,
 																		  array_count,
@@ -335,7 +340,6 @@ static dl_error_t dl_internal_convert_collect_instances_from_member( dl_ctx_t
 					break;
 				case DL_TYPE_STORAGE_STRUCT:
 				{
-					sub_type = dl_internal_find_type(ctx, member->type_id);
 					dl_internal_convert_collect_instances_from_struct_array( ctx,
 																			 array_data,
 																			 array_count,
@@ -345,11 +349,11 @@ static dl_error_t dl_internal_convert_collect_instances_from_member( dl_ctx_t
 				}
 				break;
 				default:
-					DL_ASSERT(member->IsSimplePod());
+					DL_ASSERT(ctx->member_descs[op->member].IsSimplePod());
 					break;
 			}
 
-			convert_ctx.instances.Add(SInstance(array_data, sub_type, array_count, member->type));
+			convert_ctx.AddInstance(SInstance(array_data, sub_type, array_count, op->type));
 		}
 		break;
 
@@ -382,16 +386,18 @@ static dl_error_t dl_internal_convert_collect_instances( dl_ctx_t            dl_
 			return DL_ERROR_MALFORMED_DATA;
 		const uint8_t* member_data = instance + member->offset[convert_ctx.src_ptr_size];
 
-		return dl_internal_convert_collect_instances_from_member( dl_ctx, member, member_data, base_data, convert_ctx );
+		dl_type_plan_op op = dl_internal_plan_op_from_member( dl_ctx, member );
+		return dl_internal_convert_collect_instances_from_member( dl_ctx, &op, member_data, base_data, convert_ctx );
 	}
 	else
 	{
-		for( uint32_t member_index = 0; member_index < type->member_count; ++member_index )
+		const dl_type_plan* plan = dl_internal_type_plan( dl_ctx, type );
+		const dl_type_plan_op* ops = &dl_ctx->plan_ops[plan->op_start];
+		for( uint32_t op_index = 0; op_index < plan->op_count; ++op_index )
 		{
-			const dl_member_desc* member = dl_get_type_member( dl_ctx, type, member_index );
-			const uint8_t* member_data = instance + member->offset[convert_ctx.src_ptr_size];
+			const uint8_t* member_data = instance + ops[op_index].offset[convert_ctx.src_ptr_size];
 
-			dl_error_t err = dl_internal_convert_collect_instances_from_member( dl_ctx, member, member_data, base_data, convert_ctx );
+			dl_error_t err = dl_internal_convert_collect_instances_from_member( dl_ctx, &ops[op_index], member_data, base_data, convert_ctx );
 			if( err != DL_ERROR_OK )
 				return err;
 		}
@@ -490,7 +496,7 @@ static dl_error_t dl_internal_convert_write_member( dl_ctx_t              ctx,
 			{
 				case DL_TYPE_STORAGE_STRUCT:
 				{
-					const dl_type_desc* sub_type = dl_internal_find_type(ctx, member->type_id);
+					const dl_type_desc* sub_type = dl_internal_member_sub_type( ctx, member );
 					if(sub_type == 0x0)
 						return DL_ERROR_TYPE_NOT_FOUND;
 					dl_internal_convert_write_struct( ctx, member_data, sub_type, conv_ctx, writer );
@@ -516,7 +522,7 @@ static dl_error_t dl_internal_convert_write_member( dl_ctx_t              ctx,
 			{
 				case DL_TYPE_STORAGE_STRUCT:
 				{
-					const dl_type_desc* sub_type = dl_internal_find_type(ctx, member->type_id);
+					const dl_type_desc* sub_type = dl_internal_member_sub_type( ctx, member );
 					if(sub_type == 0x0)
 						return DL_ERROR_TYPE_NOT_FOUND;
 
@@ -793,6 +799,7 @@ static dl_error_t dl_internal_convert_write_instance( dl_ctx_t          dl_ctx,
 #include <algorithm>
 
 bool dl_internal_sort_pred( const SInstance& i1, const SInstance& i2 ) { return i1.address < i2.address; }
+static bool dl_internal_address_pred( const SInstance& inst, const uint8_t* address ) { return inst.address < address; }
 
 dl_error_t dl_internal_convert_no_header( dl_ctx_t       dl_ctx,
                                           unsigned char* packed_instance, unsigned char* packed_instance_base,
@@ -807,13 +814,12 @@ dl_error_t dl_internal_convert_no_header( dl_ctx_t       dl_ctx,
 
 	SConvertContext conv_ctx( src_endian, out_endian, src_ptr_size, out_ptr_size, dl_ctx->alloc );
 
-	conv_ctx.instances.Add(SInstance(packed_instance, root_type, 0x0, dl_make_type(DL_TYPE_ATOM_POD, DL_TYPE_STORAGE_STRUCT)));
+	conv_ctx.AddInstance(SInstance(packed_instance, root_type, 0x0, dl_make_type(DL_TYPE_ATOM_POD, DL_TYPE_STORAGE_STRUCT)));
 	dl_error_t err = dl_internal_convert_collect_instances(dl_ctx, root_type, packed_instance, packed_instance_base, conv_ctx);
 
-	// TODO: we need to sort the instances here after their offset!
-
-	SInstance* insts = &conv_ctx.instances[0];
-	std::sort( insts, insts + conv_ctx.instances.Len(), dl_internal_sort_pred );
+	SInstance* insts     = &conv_ctx.instances[0];
+	SInstance* insts_end = insts + conv_ctx.instances.Len();
+	std::sort( insts, insts_end, dl_internal_sort_pred );
 
 	const void* last_address = 0;
 	for(unsigned int i = 0; i < conv_ctx.instances.Len(); ++i)
@@ -832,19 +838,14 @@ dl_error_t dl_internal_convert_no_header( dl_ctx_t       dl_ctx,
 		{
 			SConvertContext::PatchPos& pp = conv_ctx.m_lPatchOffset[i];
 
-			// find new offset
+			// find new offset, instances are sorted by address so the first instance at the old address is the one
+			// that was written, i.e. not a merged string.
 			uintptr_t new_offset = (uintptr_t)-1;
 
-			for( size_t j = 0; j < conv_ctx.instances.Len(); ++j )
-			{
-				uintptr_t old_offset = (uintptr_t)(conv_ctx.instances[j].address - packed_instance_base);
-
-				if(old_offset == pp.old_offset)
-				{
-					new_offset = conv_ctx.instances[j].offset_after_patch;
-					break;
-				}
-			}
+			const uint8_t* old_address = packed_instance_base + pp.old_offset;
+			SInstance* inst = std::lower_bound( insts, insts_end, old_address, dl_internal_address_pred );
+			if( inst != insts_end && inst->address == old_address )
+				new_offset = inst->offset_after_patch;
 
 			DL_ASSERT(new_offset != (uintptr_t)-1 && "We should have found the instance!");
 
@@ -875,6 +876,7 @@ static dl_error_t dl_internal_convert_instance( dl_ctx_t       dl_ctx,
 	if( header->root_instance_type != type &&
 		header->root_instance_type != dl_swap_endian_uint32(type) ) return DL_ERROR_TYPE_MISMATCH;
 	if( out_ptr_size != 4 && out_ptr_size != 8 )                    return DL_ERROR_INVALID_PARAMETER;
+	if( header->flags & DL_DATA_HEADER_FLAG_SELF_RELATIVE )         return DL_ERROR_UNSUPPORTED_OPERATION;
 
 	dl_ptr_size_t src_ptr_size = header->is_64_bit_ptr != 0 ? DL_PTR_SIZE_64BIT : DL_PTR_SIZE_32BIT;
 	dl_ptr_size_t dst_ptr_size;
@@ -928,6 +930,10 @@ static dl_error_t dl_internal_convert_instance( dl_ctx_t       dl_ctx,
 		new_header->root_instance_type = type;
 		new_header->instance_size      = uint32_t(*out_size);
 		new_header->is_64_bit_ptr      = out_ptr_size == 4 ? 0 : 1;
+		new_header->flags              = 0; // relocation table is not converted, loading will fall back to patching by type.
+		new_header->pad[0]             = 0;
+		new_header->pad[1]             = 0;
+		new_header->reloc_count        = 0;
 
 		if(DL_ENDIAN_HOST != out_endian)
 			dl_swap_header(new_header);
@@ -1,6 +1,8 @@
 #include "dl_patch_ptr.h"
 #include "dl_types.h"
 
+#include <algorithm>
+
 struct dl_patched_ptrs
 {
 	CArrayStatic<const uint8_t*, 128> addresses;
@@ -35,21 +37,102 @@ static uintptr_t dl_internal_patch_ptr( uint8_t* ptrptr, uintptr_t patch_distanc
 	return *ptr;
 }
 
-void dl_internal_patch_struct( dl_ctx_t            ctx,
-							   const dl_type_desc* type,
-							   uint8_t*            struct_data,
-							   uintptr_t           base_address,
-							   uintptr_t           patch_distance,
-							   dl_patched_ptrs*    patched_ptrs );
+/**
+ * Visitor used when traversing an instance to patch all pointers by patch_distance.
+ */
+struct dl_patch_visitor
+{
+	uintptr_t patch_distance;
+
+	uintptr_t visit( uint8_t* ptrptr ) { return dl_internal_patch_ptr( ptrptr, patch_distance ); }
+};
+
+/**
+ * Visitor used when traversing an unpatched instance to record the offset of all pointers, the instance is left untouched.
+ */
+struct dl_collect_relocs_visitor
+{
+	const uint8_t*  base_address;
+	dl_reloc_array* relocs;
+
+	uintptr_t visit( uint8_t* ptrptr )
+	{
+		relocs->Add( (uint32_t)( ptrptr - base_address ) );
+
+		union { uint8_t* src; uintptr_t* ptr; };
+		src = ptrptr;
+		return *ptr == DL_NULL_PTR_OFFSET[DL_PTR_SIZE_HOST] ? 0x0 : *ptr;
+	}
+};
+
+static uintptr_t dl_internal_make_ptr_self_relative( uint8_t* ptrptr, uint8_t* instance )
+{
+	union { uint8_t* src; uintptr_t* ptr; intptr_t* rel; };
+	src = ptrptr;
+	uintptr_t offset = *ptr;
+	if( offset == DL_NULL_PTR_OFFSET[DL_PTR_SIZE_HOST] )
+	{
+		*rel = DL_SELF_RELATIVE_NULL_OFFSET;
+		return 0x0;
+	}
+	*rel = (intptr_t)offset - (intptr_t)( ptrptr - instance );
+	return offset;
+}
+
+/**
+ * Visitor used when traversing an unpatched instance to make all pointers relative to themselves. Returns the
+ * original offset so that traversal can continue into subdata.
+ */
+struct dl_self_relative_visitor
+{
+	uint8_t* instance;
 
+	uintptr_t visit( uint8_t* ptrptr ) { return dl_internal_make_ptr_self_relative( ptrptr, instance ); }
+};
+
+template <typename VISITOR>
+static void dl_internal_patch_struct( dl_ctx_t            ctx,
+									  const dl_type_desc* type,
+									  uint8_t*            struct_data,
+									  uintptr_t           base_address,
+									  VISITOR*            visitor,
+									  dl_patched_ptrs*    patched_ptrs );
+
+/**
+ * Patch struct_data with generated routines if there are any registered for type, returns false if the generic
+ * code should be used. Generated routines only patch pointers and are not used with other visitors.
+ */
+template <typename VISITOR>
+static bool dl_internal_patch_struct_gen( dl_ctx_t, const dl_type_desc*, uint8_t*, uintptr_t, VISITOR*, dl_patched_ptrs* )
+{
+	return false;
+}
+
+static bool dl_internal_patch_struct_gen( dl_ctx_t            ctx,
+										  const dl_type_desc* type,
+										  uint8_t*            struct_data,
+										  uintptr_t           base_address,
+										  dl_patch_visitor*   visitor,
+										  dl_patched_ptrs*    patched_ptrs )
+{
+	const dl_bin_gen_funcs* gen = dl_internal_find_bin_gen( ctx, type );
+	if( gen == 0x0 || gen->patch == 0x0 )
+		return false;
+
+	dl_bin_gen_patch_ctx patch_ctx = { ctx, base_address, visitor->patch_distance, patched_ptrs };
+	gen->patch( &patch_ctx, struct_data );
+	return true;
+}
+
+template <typename VISITOR>
 static void dl_internal_patch_ptr_instance( dl_ctx_t            ctx,
 		   	   	   	   	   	   	   	   	    const dl_type_desc* sub_type,
 											uint8_t*            ptr_data,
 											uintptr_t           base_address,
-											uintptr_t           patch_distance,
+											VISITOR*            visitor,
 											dl_patched_ptrs*    patched_ptrs )
 {
-	uintptr_t offset = dl_internal_patch_ptr( ptr_data, patch_distance );
+	uintptr_t offset = visitor->visit( ptr_data );
 	if( offset == 0x0 )
 		return;
 
@@ -58,52 +141,58 @@ static void dl_internal_patch_ptr_instance( dl_ctx_t            ctx,
 		return;
 
 	patched_ptrs->add( ptr );
-	dl_internal_patch_struct( ctx, sub_type, ptr, base_address, patch_distance, patched_ptrs );
+	dl_internal_patch_struct( ctx, sub_type, ptr, base_address, visitor, patched_ptrs );
 }
 
-static void dl_internal_patch_str_array( uint8_t* array_data, uint32_t count, uintptr_t patch_distance )
+template <typename VISITOR>
+static void dl_internal_patch_str_array( uint8_t* array_data, uint32_t count, VISITOR* visitor )
 {
 	for( uint32_t index = 0; index < count; ++index )
-		dl_internal_patch_ptr( array_data + index * sizeof(char*), patch_distance );
+		visitor->visit( array_data + index * sizeof(char*) );
 }
 
+template <typename VISITOR>
 static void dl_internal_patch_ptr_array( dl_ctx_t            ctx,
 								  	  	 uint8_t*            array_data,
 										 uint32_t            count,
 										 const dl_type_desc* sub_type,
 										 uintptr_t           base_address,
-										 uintptr_t           patch_distance,
+										 VISITOR*            visitor,
 										 dl_patched_ptrs*    patched_ptrs )
 {
 	for( uint32_t index = 0; index < count; ++index )
-		dl_internal_patch_ptr_instance( ctx, sub_type, array_data + index * sizeof(void*), base_address, patch_distance, patched_ptrs );
+		dl_internal_patch_ptr_instance( ctx, sub_type, array_data + index * sizeof(void*), base_address, visitor, patched_ptrs );
 }
 
+template <typename VISITOR>
 static void dl_internal_patch_struct_array( dl_ctx_t            ctx,
 									 	 	const dl_type_desc* type,
 											uint8_t*            array_data,
 											uint32_t            count,
 											uintptr_t           base_address,
-											uintptr_t           patch_distance,
+											VISITOR*            visitor,
 											dl_patched_ptrs*    patched_ptrs )
 {
-	uint32_t size = dl_internal_align_up( type->size[DL_PTR_SIZE_HOST], type->alignment[DL_PTR_SIZE_HOST] );
+	const dl_type_hot* hot = dl_internal_type_hot( ctx, type );
+	uint32_t size = dl_internal_align_up( hot->size, hot->alignment );
 	for( uint32_t index = 0; index < count; ++index )
 	{
 		uint8_t* struct_data = array_data + index * size;
-		dl_internal_patch_struct( ctx, type, struct_data, base_address, patch_distance, patched_ptrs );
+		dl_internal_patch_struct( ctx, type, struct_data, base_address, visitor, patched_ptrs );
 	}
 }
 
-static void dl_internal_patch_member( dl_ctx_t              ctx,
-								      const dl_member_desc* member,
-								      uint8_t*              member_data,
-								      uintptr_t             base_address,
-								      uintptr_t             patch_distance,
-								      dl_patched_ptrs*      patched_ptrs )
+template <typename VISITOR>
+static void dl_internal_patch_op( dl_ctx_t               ctx,
+								  const dl_type_plan_op* op,
+								  uint8_t*               member_data,
+								  uintptr_t              base_address,
+								  VISITOR*               visitor,
+								  dl_patched_ptrs*       patched_ptrs )
 {
-	dl_type_atom_t    atom_type    = member->AtomType();
-	dl_type_storage_t storage_type = member->StorageType();
+	dl_type_atom_t      atom_type    = op->AtomType();
+	dl_type_storage_t   storage_type = op->StorageType();
+	const dl_type_desc* sub_type     = dl_internal_plan_op_sub_type( ctx, op );
 
 	switch( atom_type )
 	{
@@ -112,22 +201,22 @@ static void dl_internal_patch_member( dl_ctx_t              ctx,
 			switch( storage_type )
 			{
 				case DL_TYPE_STORAGE_STR:
-					dl_internal_patch_ptr( member_data, patch_distance );
+					visitor->visit( member_data );
 				break;
 				case DL_TYPE_STORAGE_PTR:
 					dl_internal_patch_ptr_instance( ctx,
-													dl_internal_find_type( ctx, member->type_id ),
+													sub_type,
 													member_data,
 													base_address,
-													patch_distance,
+													visitor,
 													patched_ptrs );
 				break;
 				case DL_TYPE_STORAGE_STRUCT:
 					dl_internal_patch_struct( ctx,
-											  dl_internal_find_type( ctx, member->type_id ),
+											  sub_type,
 											  member_data,
 											  base_address,
-											  patch_distance,
+											  visitor,
 											  patched_ptrs );
 				break;
 				default:
@@ -141,24 +230,24 @@ static void dl_internal_patch_member( dl_ctx_t              ctx,
 			switch( storage_type )
 			{
 				case DL_TYPE_STORAGE_STR:
-					dl_internal_patch_str_array( member_data, member->inline_array_cnt(), patch_distance );
+					dl_internal_patch_str_array( member_data, op->count, visitor );
 				break;
 				case DL_TYPE_STORAGE_PTR:
 					dl_internal_patch_ptr_array( ctx,
 												 member_data,
-												 member->inline_array_cnt(),
-												 dl_internal_find_type( ctx, member->type_id ),
+												 op->count,
+												 sub_type,
 												 base_address,
-												 patch_distance,
+												 visitor,
 												 patched_ptrs );
 				break;
 				case DL_TYPE_STORAGE_STRUCT:
 					dl_internal_patch_struct_array( ctx,
-													dl_internal_find_type( ctx, member->type_id ),
+													sub_type,
 													member_data,
-													member->inline_array_cnt(),
+													op->count,
 													base_address,
-													patch_distance,
+													visitor,
 													patched_ptrs );
 				break;
 				default:
@@ -169,7 +258,7 @@ static void dl_internal_patch_member( dl_ctx_t              ctx,
 
 		case DL_TYPE_ATOM_ARRAY:
 		{
-			uintptr_t offset = dl_internal_patch_ptr( member_data, patch_distance );
+			uintptr_t offset = visitor->visit( member_data );
 
 			union { uint8_t* src; uint32_t ptr; };
 			src = member_data + sizeof( void* );
@@ -181,24 +270,24 @@ static void dl_internal_patch_member( dl_ctx_t              ctx,
 				switch( storage_type )
 				{
 					case DL_TYPE_STORAGE_STR:
-						dl_internal_patch_str_array( array_data, count, patch_distance );
+						dl_internal_patch_str_array( array_data, count, visitor );
 					break;
 					case DL_TYPE_STORAGE_PTR:
 						dl_internal_patch_ptr_array( ctx,
 													 array_data,
 													 count,
-													 dl_internal_find_type( ctx, member->type_id ),
+													 sub_type,
 													 base_address,
-													 patch_distance,
+													 visitor,
 													 patched_ptrs );
 					break;
 					case DL_TYPE_STORAGE_STRUCT:
 						dl_internal_patch_struct_array( ctx,
-														dl_internal_find_type( ctx, member->type_id ),
+														sub_type,
 														array_data,
 														count,
 														base_address,
-														patch_distance,
+														visitor,
 														patched_ptrs );
 					break;
 					default:
@@ -212,11 +301,12 @@ static void dl_internal_patch_member( dl_ctx_t              ctx,
 	}
 }
 
+template <typename VISITOR>
 static void dl_internal_patch_union( dl_ctx_t            ctx,
 									 const dl_type_desc* type,
 									 uint8_t*            union_data,
 									 uintptr_t           base_address,
-									 uintptr_t           patch_distance,
+									 VISITOR*            visitor,
 									 dl_patched_ptrs*    patched_ptrs )
 {
 	DL_ASSERT(type->flags & DL_TYPE_FLAG_IS_UNION);
@@ -226,30 +316,44 @@ static void dl_internal_patch_union( dl_ctx_t            ctx,
 	uint32_t union_type = *((uint32_t*)(union_data + type_offset));
 	const dl_member_desc* member = dl_internal_union_type_to_member(ctx, type, union_type);
 	DL_ASSERT(member->offset[DL_PTR_SIZE_HOST] == 0);
-	dl_internal_patch_member( ctx, member, union_data, base_address, patch_distance, patched_ptrs );
+	dl_type_plan_op op = dl_internal_plan_op_from_member( ctx, member );
+	dl_internal_patch_op( ctx, &op, union_data, base_address, visitor, patched_ptrs );
+}
+
+/**
+ * Patch all members of a non-union type by its plan.
+ */
+template <typename VISITOR>
+static void dl_internal_patch_plan( dl_ctx_t            ctx,
+									const dl_type_desc* type,
+									uint8_t*            struct_data,
+									uintptr_t           base_address,
+									VISITOR*            visitor,
+									dl_patched_ptrs*    patched_ptrs )
+{
+	const dl_type_plan* plan = dl_internal_type_plan( ctx, type );
+	const dl_type_plan_op* ops = &ctx->plan_ops[plan->op_start];
+	for( uint32_t op_index = 0; op_index < plan->op_count; ++op_index )
+		dl_internal_patch_op( ctx, &ops[op_index], struct_data + ops[op_index].offset[DL_PTR_SIZE_HOST], base_address, visitor, patched_ptrs );
 }
 
-void dl_internal_patch_struct( dl_ctx_t            ctx,
-							   const dl_type_desc* type,
-							   uint8_t*            struct_data,
-							   uintptr_t           base_address,
-							   uintptr_t           patch_distance,
-							   dl_patched_ptrs*    patched_ptrs )
+template <typename VISITOR>
+static void dl_internal_patch_struct( dl_ctx_t            ctx,
+									  const dl_type_desc* type,
+									  uint8_t*            struct_data,
+									  uintptr_t           base_address,
+									  VISITOR*            visitor,
+									  dl_patched_ptrs*    patched_ptrs )
 {
-	if( type->flags & DL_TYPE_FLAG_HAS_SUBDATA )
+	uint32_t flags = dl_internal_type_hot( ctx, type )->flags;
+	if( flags & DL_TYPE_FLAG_HAS_SUBDATA )
 	{
-		if( type->flags & DL_TYPE_FLAG_IS_UNION )
+		if( flags & DL_TYPE_FLAG_IS_UNION )
 		{
-			dl_internal_patch_union(ctx, type, struct_data, base_address, patch_distance, patched_ptrs);
-		}
-		else
-		{
-			for( uint32_t member_index = 0; member_index < type->member_count; ++member_index )
-			{
-				const dl_member_desc* member = dl_get_type_member( ctx, type, member_index );
-				dl_internal_patch_member( ctx, member, struct_data + member->offset[DL_PTR_SIZE_HOST], base_address, patch_distance, patched_ptrs );
-			}
+			dl_internal_patch_union(ctx, type, struct_data, base_address, visitor, patched_ptrs);
 		}
+		else if( !dl_internal_patch_struct_gen( ctx, type, struct_data, base_address, visitor, patched_ptrs ) )
+			dl_internal_patch_plan( ctx, type, struct_data, base_address, visitor, patched_ptrs );
 	}
 }
 
@@ -260,7 +364,9 @@ void dl_internal_patch_member( dl_ctx_t              ctx,
 							   uintptr_t             patch_distance )
 {
 	dl_patched_ptrs patched(ctx->alloc);
-	dl_internal_patch_member( ctx, member, member_data, base_address, patch_distance, &patched );
+	dl_patch_visitor visitor = { patch_distance };
+	dl_type_plan_op op = dl_internal_plan_op_from_member( ctx, member );
+	dl_internal_patch_op( ctx, &op, member_data, base_address, &visitor, &patched );
 }
 
 void dl_internal_patch_instance( dl_ctx_t            ctx,
@@ -272,18 +378,91 @@ void dl_internal_patch_instance( dl_ctx_t            ctx,
 	dl_patched_ptrs patched(ctx->alloc);
 	patched.add( instance );
 
+	dl_patch_visitor visitor = { patch_distance };
+
 	if( type->flags & DL_TYPE_FLAG_IS_UNION )
 	{
-		dl_internal_patch_union(ctx, type, instance, base_address, patch_distance, &patched);
+		dl_internal_patch_union(ctx, type, instance, base_address, &visitor, &patched);
 	}
-	else
-	{
-		for( uint32_t member_index = 0; member_index < type->member_count; ++member_index )
-		{
-			const dl_member_desc* member = dl_get_type_member( ctx, type, member_index );
-			uint8_t*   member_data = instance + member->offset[DL_PTR_SIZE_HOST];
+	else if( !dl_internal_patch_struct_gen( ctx, type, instance, base_address, &visitor, &patched ) )
+		dl_internal_patch_plan( ctx, type, instance, base_address, &visitor, &patched );
+}
 
-			dl_internal_patch_member( ctx, member, member_data, base_address, patch_distance, &patched );
-		}
+// ... support for patch-routines generated by dltlc, see dl_bin_gen.h ...
+
+int dl_bin_gen_patch_first_visit( dl_bin_gen_patch_t patch_ctx, const uint8_t* ptr )
+{
+	if( patch_ctx->patched_ptrs->patched( ptr ) )
+		return 0;
+	patch_ctx->patched_ptrs->add( ptr );
+	return 1;
+}
+
+void dl_bin_gen_patch_member( dl_bin_gen_patch_t patch_ctx, dl_typeid_t type_id, uint32_t member_index, uint8_t* instance )
+{
+	dl_ctx_t ctx = patch_ctx->dl_ctx;
+	const dl_member_desc* member = dl_get_type_member( ctx, dl_internal_find_type( ctx, type_id ), member_index );
+	dl_type_plan_op op = dl_internal_plan_op_from_member( ctx, member );
+	dl_patch_visitor visitor = { patch_ctx->patch_distance };
+	dl_internal_patch_op( ctx, &op, instance + member->offset[DL_PTR_SIZE_HOST], patch_ctx->base_address, &visitor, patch_ctx->patched_ptrs );
+}
+
+void dl_internal_collect_member_relocs( dl_ctx_t              ctx,
+										const dl_member_desc* member,
+										uint8_t*              member_data,
+										dl_reloc_array*       relocs )
+{
+	dl_patched_ptrs patched(ctx->alloc);
+	dl_collect_relocs_visitor visitor = { member_data, relocs };
+	dl_type_plan_op op = dl_internal_plan_op_from_member( ctx, member );
+	dl_internal_patch_op( ctx, &op, member_data, (uintptr_t)member_data, &visitor, &patched );
+}
+
+void dl_internal_patch_relocs( uint8_t*        instance,
+							   const uint32_t* relocs,
+							   uint32_t        reloc_count,
+							   uintptr_t       patch_distance )
+{
+	for( uint32_t i = 0; i < reloc_count; ++i )
+		dl_internal_patch_ptr( instance + relocs[i], patch_distance );
+}
+
+void dl_internal_make_self_relative( dl_ctx_t            ctx,
+									 const dl_type_desc* type,
+									 uint8_t*            instance )
+{
+	dl_patched_ptrs patched(ctx->alloc);
+	patched.add( instance );
+
+	dl_self_relative_visitor visitor = { instance };
+
+	if( type->flags & DL_TYPE_FLAG_IS_UNION )
+	{
+		dl_internal_patch_union(ctx, type, instance, (uintptr_t)instance, &visitor, &patched);
 	}
+	else
+		dl_internal_patch_plan( ctx, type, instance, (uintptr_t)instance, &visitor, &patched );
+}
+
+void dl_internal_make_relocs_self_relative( uint8_t*        instance,
+											const uint32_t* relocs,
+											uint32_t        reloc_count )
+{
+	for( uint32_t i = 0; i < reloc_count; ++i )
+		dl_internal_make_ptr_self_relative( instance + relocs[i], instance );
+}
+
+uint32_t dl_internal_write_reloc_table( dl_binary_writer* writer, dl_reloc_array* relocs )
+{
+	// sorted offsets gives linear memory access when patching and dropping duplicates makes sure that no
+	// pointer get patched twice.
+	uint32_t* begin = relocs->m_Ptr;
+	uint32_t* end   = begin + relocs->Len();
+	std::sort( begin, end );
+	uint32_t reloc_count = (uint32_t)( std::unique( begin, end ) - begin );
+
+	dl_binary_writer_seek_end( writer );
+	dl_binary_writer_align( writer, sizeof(uint32_t) );
+	dl_binary_writer_write( writer, begin, reloc_count * sizeof(uint32_t) );
+	return reloc_count;
 }
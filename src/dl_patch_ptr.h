@@ -2,6 +2,12 @@
 #define DL_PATCH_PTR_H_INCLUDED
 
 #include "dl_types.h"
+#include "dl_binary_writer.h"
+
+/**
+ * Offsets, relative to the start of an instance, to all pointers in the instance.
+ */
+typedef CArrayStatic<uint32_t, 128> dl_reloc_array;
 
 /**
  * Patch all pointers in an instance.
@@ -33,4 +39,63 @@ void dl_internal_patch_member( dl_ctx_t                ctx,
 								 uintptr_t             base_address,
 								 uintptr_t             patch_distance );
 
+/**
+ * Collect offsets to all pointers in a member that is stored with pointers as offsets, i.e. not patched.
+ * Offsets are relative to member_data and appended to relocs.
+ *
+ * @param ctx dl-context containing all types used in member.
+ * @param member member desc of member to collect pointers from.
+ * @param member_data pointer to member data, pointers in subdata is expected to be relative to this.
+ * @param relocs array to append offsets to.
+ */
+void dl_internal_collect_member_relocs( dl_ctx_t              ctx,
+										const dl_member_desc* member,
+										uint8_t*              member_data,
+										dl_reloc_array*       relocs );
+
+/**
+ * Patch all pointers in an instance by iterating a relocation table, no type-information is needed.
+ *
+ * @param instance pointer to instance to patch.
+ * @param relocs offsets from instance to all pointers to patch.
+ * @param reloc_count number of entries in relocs.
+ * @param patch_distance distance in bytes to patch all pointers.
+ */
+void dl_internal_patch_relocs( uint8_t*        instance,
+							   const uint32_t* relocs,
+							   uint32_t        reloc_count,
+							   uintptr_t       patch_distance );
+
+/**
+ * Convert all pointers in an unpatched instance, i.e. pointers stored as offsets from instance, to be relative to
+ * the pointer itself. Null-pointers are stored as DL_SELF_RELATIVE_NULL_OFFSET.
+ *
+ * @param ctx dl-context containing all types used in type.
+ * @param type type desc of instance to convert.
+ * @param instance pointer to instance to convert.
+ */
+void dl_internal_make_self_relative( dl_ctx_t            ctx,
+									 const dl_type_desc* type,
+									 uint8_t*            instance );
+
+/**
+ * Same as dl_internal_make_self_relative() but iterating a relocation table instead of traversing the instance.
+ *
+ * @param instance pointer to instance to convert.
+ * @param relocs offsets from instance to all pointers to convert.
+ * @param reloc_count number of entries in relocs.
+ */
+void dl_internal_make_relocs_self_relative( uint8_t*        instance,
+											const uint32_t* relocs,
+											uint32_t        reloc_count );
+
+/**
+ * Sort relocs, remove duplicates and write them as a relocation table, aligned to 4 bytes, at the end of writer.
+ *
+ * @param writer writer to write table to.
+ * @param relocs offsets to write, will be sorted.
+ * @return number of entries written.
+ */
+uint32_t dl_internal_write_reloc_table( dl_binary_writer* writer, dl_reloc_array* relocs );
+
 #endif // DL_PATCH_PTR_H_INCLUDED
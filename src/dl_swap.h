@@ -3,6 +3,9 @@
 #ifndef DL_DL_SWAP_H_INCLUDED
 #define DL_DL_SWAP_H_INCLUDED
 
+#include <string.h> // for memcpy
+#include "dl_config.h"
+
 static inline int8_t  dl_swap_endian_int8 ( int8_t  val ) { return val; }
 static inline int16_t dl_swap_endian_int16( int16_t val ) { return (int16_t)( ( ( val & 0x00FF ) << 8 )  | ( ( val & 0xFF00 ) >> 8 ) ); }
 static inline int32_t dl_swap_endian_int32( int32_t val ) { return ( ( val & 0x00FF ) << 24 ) | ( ( val & 0xFF00 ) << 8) | ( ( val >> 8 ) & 0xFF00 ) | ( ( val >> 24 ) & 0x00FF ); }
@@ -44,4 +47,130 @@ static inline double dl_swap_endian_fp64( double f )
 	return conv.m_fp64;
 }
 
+// ... bulk swap of arrays, vectorized with SSE2 or AVX2 when the compiler targets them ...
+#if !defined(DL_SWAP_NO_SIMD)
+#  if defined(__AVX2__)
+#    define DL_SWAP_AVX2 1
+#  endif
+#  if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#    define DL_SWAP_SSE2 1
+#  endif
+#endif
+
+#if defined(DL_SWAP_AVX2)
+#  include <immintrin.h>
+#elif defined(DL_SWAP_SSE2)
+#  include <emmintrin.h>
+#endif
+
+#if defined(DL_SWAP_SSE2) && !defined(DL_SWAP_AVX2)
+static inline __m128i dl_swap_endian_16x8_sse2( __m128i v ) { return _mm_or_si128( _mm_slli_epi16( v, 8 ), _mm_srli_epi16( v, 8 ) ); }
+#endif
+
+/**
+ * Swap endianness of count 2-byte elements from src to dst. dst and src may be the same or overlap with dst before
+ * src, as is the case when converting inplace, since every block is read before it is written.
+ */
+static inline void dl_swap_endian_array16( void* dst, const void* src, size_t count )
+{
+	uint8_t*       d = (uint8_t*)dst;
+	const uint8_t* s = (const uint8_t*)src;
+	size_t i = 0;
+#if defined(DL_SWAP_AVX2)
+	const __m256i mask = _mm256_setr_epi8( 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+										   1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 );
+	for( ; i + 16 <= count; i += 16 )
+		_mm256_storeu_si256( (__m256i*)( d + i * 2 ), _mm256_shuffle_epi8( _mm256_loadu_si256( (const __m256i*)( s + i * 2 ) ), mask ) );
+#elif defined(DL_SWAP_SSE2)
+	for( ; i + 8 <= count; i += 8 )
+		_mm_storeu_si128( (__m128i*)( d + i * 2 ), dl_swap_endian_16x8_sse2( _mm_loadu_si128( (const __m128i*)( s + i * 2 ) ) ) );
+#endif
+	for( ; i < count; ++i )
+	{
+		uint16_t v;
+		memcpy( &v, s + i * 2, 2 );
+		v = dl_swap_endian_uint16( v );
+		memcpy( d + i * 2, &v, 2 );
+	}
+}
+
+/**
+ * Swap endianness of count 4-byte elements from src to dst, see dl_swap_endian_array16() for overlap-rules.
+ */
+static inline void dl_swap_endian_array32( void* dst, const void* src, size_t count )
+{
+	uint8_t*       d = (uint8_t*)dst;
+	const uint8_t* s = (const uint8_t*)src;
+	size_t i = 0;
+#if defined(DL_SWAP_AVX2)
+	const __m256i mask = _mm256_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+										   3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+	for( ; i + 8 <= count; i += 8 )
+		_mm256_storeu_si256( (__m256i*)( d + i * 4 ), _mm256_shuffle_epi8( _mm256_loadu_si256( (const __m256i*)( s + i * 4 ) ), mask ) );
+#elif defined(DL_SWAP_SSE2)
+	for( ; i + 4 <= count; i += 4 )
+	{
+		// swap 16-bit halves of every 32-bit element and then the bytes within the halves.
+		__m128i v = _mm_loadu_si128( (const __m128i*)( s + i * 4 ) );
+		v = _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, _MM_SHUFFLE( 2, 3, 0, 1 ) ), _MM_SHUFFLE( 2, 3, 0, 1 ) );
+		_mm_storeu_si128( (__m128i*)( d + i * 4 ), dl_swap_endian_16x8_sse2( v ) );
+	}
+#endif
+	for( ; i < count; ++i )
+	{
+		uint32_t v;
+		memcpy( &v, s + i * 4, 4 );
+		v = dl_swap_endian_uint32( v );
+		memcpy( d + i * 4, &v, 4 );
+	}
+}
+
+/**
+ * Swap endianness of count 8-byte elements from src to dst, see dl_swap_endian_array16() for overlap-rules.
+ */
+static inline void dl_swap_endian_array64( void* dst, const void* src, size_t count )
+{
+	uint8_t*       d = (uint8_t*)dst;
+	const uint8_t* s = (const uint8_t*)src;
+	size_t i = 0;
+#if defined(DL_SWAP_AVX2)
+	const __m256i mask = _mm256_setr_epi8( 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+										   7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 );
+	for( ; i + 4 <= count; i += 4 )
+		_mm256_storeu_si256( (__m256i*)( d + i * 8 ), _mm256_shuffle_epi8( _mm256_loadu_si256( (const __m256i*)( s + i * 8 ) ), mask ) );
+#elif defined(DL_SWAP_SSE2)
+	for( ; i + 2 <= count; i += 2 )
+	{
+		// reverse the 16-bit words of every 64-bit element and then the bytes within the words.
+		__m128i v = _mm_loadu_si128( (const __m128i*)( s + i * 8 ) );
+		v = _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, _MM_SHUFFLE( 0, 1, 2, 3 ) ), _MM_SHUFFLE( 0, 1, 2, 3 ) );
+		_mm_storeu_si128( (__m128i*)( d + i * 8 ), dl_swap_endian_16x8_sse2( v ) );
+	}
+#endif
+	for( ; i < count; ++i )
+	{
+		uint64_t v;
+		memcpy( &v, s + i * 8, 8 );
+		v = dl_swap_endian_uint64( v );
+		memcpy( d + i * 8, &v, 8 );
+	}
+}
+
+/**
+ * Swap endianness of count elements of elem_size bytes from src to dst, see dl_swap_endian_array16() for overlap-rules.
+ */
+static inline void dl_swap_endian_array( void* dst, const void* src, size_t count, size_t elem_size )
+{
+	switch( elem_size )
+	{
+		case 1: memmove( dst, src, count ); break;
+		case 2: dl_swap_endian_array16( dst, src, count ); break;
+		case 4: dl_swap_endian_array32( dst, src, count ); break;
+		case 8: dl_swap_endian_array64( dst, src, count ); break;
+		default:
+			DL_ASSERT( false && "unhandled case!" );
+			break;
+	}
+}
+
 #endif // DL_DL_SWAP_H_INCLUDED
@@ -2,150 +2,113 @@
 
 #include "dl_types.h"
 #include <dl/dl_txt.h>
+#include <dl/dl_txt_gen.h>
 #include "dl_binary_writer.h"
 #include "dl_patch_ptr.h"
 #include "dl_txt_read.h"
+#include "dl_swap.h"
 
 #include <stdlib.h>
 #include <limits.h>
-#include <float.h>
-#include <limits>
 
-#if defined(_MSC_VER)
-// TODO: any better/faster way to do this, especially strtof?
-#  if _MSC_VER < 1800 // strtof was defined first in MSVC2013
-	float strtof(const char* str, char** endptr)
+struct dl_txt_pack_ctx
+{
+	explicit dl_txt_pack_ctx(dl_allocator alloc)
+	    : subdata(alloc)
+		, subdata_index(alloc)
+		, subinstances(alloc)
+		, subinstances_index(alloc)
+		, relocs(alloc)
+		, array_scratch(alloc)
+		, names(alloc)
 	{
-		return (float)strtod( str, endptr );
 	}
-#  endif
-#endif
 
-inline double dl_strtod(const char* str, char** endptr)
-{
-	double res = strtod(str, endptr);
-	if(str == *endptr)
+	// call before writing a pointer at pos in writer.
+	void AddReloc( size_t pos )
 	{
-		float sign = 1.0f;
-		switch(str[0])
-		{
-			case '-':
-				sign  = -1.0f;
-				++str;
-				break;
-			case '+':
-				sign  = 1.0f;
-				++str;
-				break;
-			default:
-				break;
-		}
-#if defined(_MSC_VER) && _MSC_VER < 1800 // older versions of strtod() on msvc did not parse inf
-		if(_strnicmp("infinity", str, 8) == 0)
-		{
-			*endptr = (char*)str + 8;
-			return std::numeric_limits<double>::infinity() * sign;
-		}
-		if(_strnicmp("inf", str, 3) == 0)
-		{
-			*endptr = (char*)str + 3;
-			return std::numeric_limits<double>::infinity() * sign;
-		}
-		if(_strnicmp("nan", str, 3) == 0)
-		{
-			*endptr = (char*)str + 3;
-			return std::numeric_limits<double>::quiet_NaN() * sign;
-		}
-#endif
-			if( tolower(str[1]) == 'a' &&
-			    tolower(str[2]) == 'x' &&
-			   !isalnum(str[3]) )
-			{
-				*endptr = (char*)str + 3;
-				return DBL_MAX * sign;
-			}
-			if( tolower(str[1]) == 'i' &&
-			    tolower(str[2]) == 'n' &&
-			   !isalnum(str[3]))
-			{
-				*endptr = (char*)str + 3;
-				return DBL_MIN * sign;
-			}
+		if( store_relocs )
+			relocs.Add( (uint32_t)pos );
 	}
-	return res;
-}
 
-inline float dl_strtof(const char* str, char** endptr)
-{
-	float res = strtof(str, endptr);
-	if(str == *endptr)
+	static uint32_t HashName( dl_substr name )
 	{
-		float sign = 1.0f;
-		switch(str[0])
-		{
-			case '-':
-				sign  = -1.0f;
-				++str;
-				break;
-			case '+':
-				sign  = 1.0f;
-				++str;
-				break;
-			default:
-				break;
-		}
-#if defined(_MSC_VER) && _MSC_VER < 1800 // older versions of strtod() on msvc did not parse inf
-		if(_strnicmp("infinity", str, 8) == 0)
-		{
-			*endptr = (char*)str + 8;
-			return std::numeric_limits<float>::infinity() * sign;
-		}
-		if(_strnicmp("inf", str, 3) == 0)
-		{
-			*endptr = (char*)str + 3;
-			return std::numeric_limits<float>::infinity() * sign;
-		}
-		if(_strnicmp("nan", str, 3) == 0)
-		{
-			*endptr = (char*)str + 3;
-			return std::numeric_limits<float>::quiet_NaN() * sign;
-		}
-#endif
-			if( tolower(str[1]) == 'a' &&
-			    tolower(str[2]) == 'x' &&
-			   !isalnum(str[3]) )
-			{
-				*endptr = (char*)str + 3;
-				return FLT_MAX * sign;
-			}
-			if( tolower(str[1]) == 'i' &&
-			    tolower(str[2]) == 'n' &&
-			   !isalnum(str[3]))
-			{
-				*endptr = (char*)str + 3;
-				return FLT_MIN * sign;
-			}
+		return dl_internal_hash_buffer( (const uint8_t*)name.str, (size_t)name.len );
 	}
-	return res;
-}
 
-struct dl_txt_pack_ctx
-{
-	explicit dl_txt_pack_ctx(dl_allocator alloc)
-	    : subdata(alloc)
+	static bool NameEqual( dl_substr a, dl_substr b )
+	{
+		return a.len == b.len && strncmp( a.str, b.str, (size_t)a.len ) == 0;
+	}
+
+	// copy name to names, the text it points to might be gone when reading from a stream.
+	uint32_t StoreName( dl_substr name )
+	{
+		uint32_t offset = (uint32_t)names.Len();
+		for( int i = 0; i < name.len; ++i )
+			names.Add( name.str[i] );
+		return offset;
+	}
+
+	dl_substr Name( uint32_t offset, int len )
+	{
+		return { names.m_Ptr + offset, len };
+	}
+
+	void AddSubData( dl_substr name, const dl_type_desc* type, size_t patch_pos )
+	{
+		subdata_index.Insert( HashName( name ), (uint32_t)subdata.Len() );
+		subdata.Add( { StoreName( name ), name.len, type, patch_pos } );
+	}
+
+	dl_substr SubDataName( size_t i )
+	{
+		return Name( subdata[i].name, subdata[i].name_len );
+	}
+
+	// return index of the first pointer referencing name or UINT32_MAX if there is none.
+	uint32_t FindSubData( dl_substr name )
 	{
+		return subdata_index.Find( HashName( name ), [this, name]( uint32_t i ) { return NameEqual( SubDataName( i ), name ); } );
 	}
 
+	void AddSubInstance( dl_substr name, size_t pos )
+	{
+		subinstances_index.Insert( HashName( name ), (uint32_t)subinstances.Len() );
+		subinstances.Add( { StoreName( name ), name.len, pos } );
+	}
+
+	// return index of the first instance in "__subdata" named name or UINT32_MAX if there is none.
+	uint32_t FindSubInstance( dl_substr name )
+	{
+		return subinstances_index.Find( HashName( name ), [this, name]( uint32_t i ) { return NameEqual( Name( subinstances[i].name, subinstances[i].name_len ), name ); } );
+	}
+
+	dl_ctx_t dl_ctx; // only used by the dl_txt_gen_pack_*-functions called from generated code.
 	dl_txt_read_ctx read_ctx;
 	dl_binary_writer* writer;
-	const char* subdata_pos;
+	bool subdata_found; // "__subdata" is kept in read_ctx.pin until parsed by dl_txt_pack_finalize_subdata().
 	struct SSubData
 	{
-		dl_substr name;
+		uint32_t name; // offset in names
+		int name_len;
 		const dl_type_desc* type;
 		size_t patch_pos;
 	}; 
 	CArrayStatic<SSubData, 256> subdata;
+	CHashIndexStatic<256>       subdata_index;
+	struct SSubInstance
+	{
+		uint32_t name; // offset in names
+		int name_len;
+		size_t pos;
+	};
+	CArrayStatic<SSubInstance, 256> subinstances;
+	CHashIndexStatic<256>           subinstances_index;
+	dl_reloc_array relocs;
+	bool           store_relocs;
+	CArrayStatic<size_t, 64> array_scratch; // offsets to strings in the string-array currently being parsed.
+	CArrayStatic<char, 1024> names;         // names of subdata referenced by pointers and of instances in "__subdata".
 };
 
 static void dl_txt_pack_eat_and_write_int8( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx )
@@ -199,8 +162,8 @@ static void dl_txt_pack_eat_and_write_uint64( dl_ctx_t dl_ctx, dl_txt_pack_ctx*
 static void dl_txt_pack_eat_and_write_fp32( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx )
 {
 	dl_txt_eat_white( &packctx->read_ctx );
-	char* next = 0x0;
-	float v = dl_strtof( packctx->read_ctx.iter, &next );
+	const char* next = 0x0;
+	float v = dl_txt_parse_fp32( packctx->read_ctx.iter, &next );
 	if( packctx->read_ctx.iter == next )
 		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "expected a value of type 'fp32'" );
 	packctx->read_ctx.iter = next;
@@ -210,8 +173,8 @@ static void dl_txt_pack_eat_and_write_fp32( dl_ctx_t dl_ctx, dl_txt_pack_ctx* pa
 static void dl_txt_pack_eat_and_write_fp64( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx )
 {
 	dl_txt_eat_white( &packctx->read_ctx );
-	char* next = 0x0;
-	double v = dl_strtod( packctx->read_ctx.iter, &next );
+	const char* next = 0x0;
+	double v = dl_txt_parse_fp64( packctx->read_ctx.iter, &next );
 	if( packctx->read_ctx.iter == next )
 		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "expected a value of type 'fp64'" );
 	packctx->read_ctx.iter = next;
@@ -223,6 +186,7 @@ static bool dl_txt_pack_eat_and_write_null(dl_txt_pack_ctx* packctx)
 	dl_txt_eat_white( &packctx->read_ctx );
 	if( strncmp( packctx->read_ctx.iter, "null", 4 ) == 0 )
 	{
+		packctx->AddReloc( dl_binary_writer_tell( packctx->writer ) );
 		dl_binary_writer_write_ptr( packctx->writer, (uintptr_t)-1 );
 		packctx->read_ctx.iter += 4;
 		return true;
@@ -230,46 +194,66 @@ static bool dl_txt_pack_eat_and_write_null(dl_txt_pack_ctx* packctx)
 	return false;
 }
 
-static void dl_txt_pack_eat_and_write_string( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx )
+/**
+ * Eat a string, or null, and write the string-data at the end of the writer. Returns the position of the written
+ * string or (size_t)-1 for null, the writer-position is left at the end of the writer.
+ */
+static size_t dl_txt_pack_eat_and_write_string_data( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx )
 {
 	dl_txt_eat_white( &packctx->read_ctx );
-	if( dl_txt_pack_eat_and_write_null(packctx) )
-		return;
+	if( strncmp( packctx->read_ctx.iter, "null", 4 ) == 0 )
+	{
+		packctx->read_ctx.iter += 4;
+		return (size_t)-1;
+	}
 
 	dl_substr str = dl_txt_eat_string( &packctx->read_ctx );
 	if( str.str == 0x0 )
 		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "expected a value of type 'string' or 'null'" );
 
-	size_t curr = dl_binary_writer_tell( packctx->writer );
 	dl_binary_writer_seek_end( packctx->writer );
 	size_t strpos = dl_binary_writer_tell( packctx->writer );
-	for( int i = 0; i < str.len; ++i )
+	const char* iter    = str.str;
+	const char* str_end = str.str + str.len;
+	while( true )
 	{
-		if( str.str[i] == '\\' )
+		// ... copy everything up to the next escape in one go ...
+		const char* esc = (const char*)memchr( iter, '\\', (size_t)( str_end - iter ) );
+		if( esc == 0x0 )
 		{
-			++i;
-			switch( str.str[i] )
-			{
-				case '\'':
-				case '\"':
-				case '\\':
-					dl_binary_writer_write_uint8( packctx->writer, (uint8_t)str.str[i] );
-					break;
-				case 'n': dl_binary_writer_write_uint8( packctx->writer, '\n' ); break;
-				case 'r': dl_binary_writer_write_uint8( packctx->writer, '\r' ); break;
-				case 't': dl_binary_writer_write_uint8( packctx->writer, '\t' ); break;
-				case 'b': dl_binary_writer_write_uint8( packctx->writer, '\b' ); break;
-				case 'f': dl_binary_writer_write_uint8( packctx->writer, '\f' ); break;
-					break;
-				default:
-					DL_ASSERT( false && "unhandled escape!" );
-			}
+			dl_binary_writer_write( packctx->writer, iter, (size_t)( str_end - iter ) );
+			break;
 		}
-		else
-			dl_binary_writer_write_uint8( packctx->writer, (uint8_t)str.str[i] );
+		dl_binary_writer_write( packctx->writer, iter, (size_t)( esc - iter ) );
+
+		iter = esc + 1;
+		switch( *iter )
+		{
+			case '\'':
+			case '\"':
+			case '\\':
+				dl_binary_writer_write_uint8( packctx->writer, (uint8_t)*iter );
+				break;
+			case 'n': dl_binary_writer_write_uint8( packctx->writer, '\n' ); break;
+			case 'r': dl_binary_writer_write_uint8( packctx->writer, '\r' ); break;
+			case 't': dl_binary_writer_write_uint8( packctx->writer, '\t' ); break;
+			case 'b': dl_binary_writer_write_uint8( packctx->writer, '\b' ); break;
+			case 'f': dl_binary_writer_write_uint8( packctx->writer, '\f' ); break;
+			default:
+				DL_ASSERT( false && "unhandled escape!" );
+		}
+		++iter;
 	}
 	dl_binary_writer_write_uint8( packctx->writer, '\0' );
+	return strpos;
+}
+
+static void dl_txt_pack_eat_and_write_string( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx )
+{
+	size_t curr = dl_binary_writer_tell( packctx->writer );
+	size_t strpos = dl_txt_pack_eat_and_write_string_data( dl_ctx, packctx );
 	dl_binary_writer_seek_set( packctx->writer, curr );
+	packctx->AddReloc( curr );
 	dl_binary_writer_write( packctx->writer, &strpos, sizeof(size_t) );
 }
 
@@ -309,7 +293,8 @@ static void dl_txt_pack_eat_and_write_ptr( dl_ctx_t dl_ctx, dl_txt_pack_ctx* pac
 	if( ptr.str == 0x0 )
 		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_INVALID_MEMBER_TYPE, "expected string" );
 
-	packctx->subdata.Add({ ptr, type, patch_pos });
+	packctx->AddReloc( patch_pos ); // written in dl_txt_pack_finalize_subdata()
+	packctx->AddSubData( ptr, type, patch_pos );
 }
 
 static void dl_txt_pack_validate_c_symbol_key( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, dl_substr symbol )
@@ -323,144 +308,105 @@ static void dl_txt_pack_validate_c_symbol_key( dl_ctx_t dl_ctx, dl_txt_pack_ctx*
 
 static void dl_txt_pack_eat_and_write_struct( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, const dl_type_desc* type );
 
-static void dl_txt_pack_eat_and_write_array( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, const dl_member_desc* member, uint32_t array_length )
+/**
+ * Step to the next element of the array currently being parsed, eating the ',' separating it from the previous
+ * element. Returns false when ']' is found, i.e. the array is done, ']' is left for the caller to eat.
+ * A trailing ',' before ']' is accepted.
+ */
+static inline bool dl_txt_pack_array_next_element( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, uint32_t* array_length, uint32_t max_length )
 {
+	dl_txt_eat_white( &packctx->read_ctx );
+	if( *array_length > 0 && *packctx->read_ctx.iter != ']' )
+	{
+		dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
+		dl_txt_eat_white( &packctx->read_ctx );
+	}
+
+	if( *packctx->read_ctx.iter == ']' )
+		return false;
+
+	if( *array_length == max_length )
+		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "to many elements in inline array, max %u", max_length );
+
+	++*array_length;
+	return true;
+}
+
+/**
+ * Parse array elements until ']' and write them one after the other starting at the current writer-position, that
+ * is expected to be array_pos. Returns the number of elements found, parsing more than max_length elements is an error.
+ */
+static uint32_t dl_txt_pack_eat_and_write_array( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, const dl_member_desc* member, size_t array_pos, uint32_t max_length )
+{
+	uint32_t array_length = 0;
 	switch( member->StorageType() )
 	{
 		case DL_TYPE_STORAGE_INT8:
-		{
-			for( uint32_t i = 0; i < array_length - 1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_int8( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_int8( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_INT16:
-		{
-			for( uint32_t i = 0; i < array_length - 1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_int16( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_int16( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_INT32:
-		{
-			for( uint32_t i = 0; i < array_length -1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_int32( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_int32( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_INT64:
-		{
-			for( uint32_t i = 0; i < array_length - 1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_int64( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_int64( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_UINT8:
-		{
-			for( uint32_t i = 0; i < array_length - 1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_uint8( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_uint8( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_UINT16:
-		{
-			for( uint32_t i = 0; i < array_length - 1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_uint16( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_uint16( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_UINT32:
-		{
-			for( uint32_t i = 0; i < array_length - 1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_uint32( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_uint32( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_UINT64:
-		{
-			for( uint32_t i = 0; i < array_length - 1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_uint64( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_uint64( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_FP32:
-		{
-			for( uint32_t i = 0; i < array_length - 1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_fp32( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_fp32( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_FP64:
-		{
-			for( uint32_t i = 0; i < array_length - 1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_fp64( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_fp64( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_STR:
-		{
-			for( uint32_t i = 0; i < array_length - 1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_string( dl_ctx, packctx );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_string( dl_ctx, packctx );
-		}
-		break;
+			break;
 		case DL_TYPE_STORAGE_PTR:
 		{
-			const dl_type_desc* type = dl_internal_find_type( dl_ctx, member->type_id );
-			size_t array_pos = dl_binary_writer_tell( packctx->writer );
-			for( uint32_t i = 0; i < array_length - 1; ++i )
+			const dl_type_desc* type = dl_internal_member_sub_type( dl_ctx, member );
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 			{
-				dl_txt_pack_eat_and_write_ptr( dl_ctx, packctx, type, array_pos + i * sizeof(void*) );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
+				// ... the pointer itself is written in dl_txt_pack_finalize_subdata(), step past it ...
+				size_t patch_pos = array_pos + ( array_length - 1 ) * sizeof(void*);
+				dl_txt_pack_eat_and_write_ptr( dl_ctx, packctx, type, patch_pos );
+				dl_binary_writer_seek_set( packctx->writer, patch_pos + sizeof(void*) );
+				dl_binary_writer_update_needed_size( packctx->writer );
 			}
-			dl_txt_pack_eat_and_write_ptr( dl_ctx, packctx, type, array_pos + ( array_length - 1 ) * sizeof(void*) );
 		}
 		break;
 		case DL_TYPE_STORAGE_STRUCT:
 		{
-			const dl_type_desc* type = dl_internal_find_type( dl_ctx, member->type_id );
-			size_t array_pos = dl_binary_writer_tell( packctx->writer ); // TODO: this seek/set dance will only be needed if type has subptrs, optimize by making different code-paths?
-			for( uint32_t i = 0; i < array_length -1; ++i )
+			const dl_type_desc* type = dl_internal_member_sub_type( dl_ctx, member );
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 			{
-				dl_binary_writer_seek_set( packctx->writer, array_pos + i * type->size[DL_PTR_SIZE_HOST] );
+				dl_binary_writer_seek_set( packctx->writer, array_pos + ( array_length - 1 ) * type->size[DL_PTR_SIZE_HOST] );
 				dl_txt_pack_eat_and_write_struct( dl_ctx, packctx, type );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
 			}
-			dl_binary_writer_seek_set( packctx->writer, array_pos + (array_length - 1) * type->size[DL_PTR_SIZE_HOST] );
-			dl_txt_pack_eat_and_write_struct( dl_ctx, packctx, type );
+			dl_binary_writer_seek_set( packctx->writer, array_pos + array_length * type->size[DL_PTR_SIZE_HOST] );
 		}
 		break;
 		case DL_TYPE_STORAGE_ENUM_INT8:
@@ -476,24 +422,92 @@ static void dl_txt_pack_eat_and_write_array( dl_ctx_t dl_ctx, dl_txt_pack_ctx* p
 			if( edesc == 0x0 )
 				dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TYPE_NOT_FOUND, "couldn't find enum-type of <type_name_here>.%s", dl_internal_member_name( dl_ctx, member ) );
 
-			for( uint32_t i = 0; i < array_length -1; ++i )
-			{
+			while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, max_length ) )
 				dl_txt_pack_eat_and_write_enum( dl_ctx, packctx, edesc );
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ',' );
-			}
-			dl_txt_pack_eat_and_write_enum( dl_ctx, packctx, edesc );
 		}
 		break;
 		default:
 			DL_ASSERT(false);
 			break;
 	}
+	return array_length;
+}
+
+static const dl_substr dl_txt_eat_object_key( dl_txt_read_ctx* readctx );
+
+/**
+ * Parse an array of numbers written as raw bytes, i.e. { "__base64" : "<base64 of the elements in little endian>" },
+ * and write the elements starting at the current writer-position. Returns the number of elements, more than
+ * max_length elements is an error.
+ */
+static uint32_t dl_txt_pack_eat_and_write_base64_array( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, dl_type_storage_t storage, uint32_t max_length )
+{
+	dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '{' );
+	dl_txt_eat_white( &packctx->read_ctx );
+	dl_substr key = dl_txt_eat_object_key( &packctx->read_ctx );
+	if( key.len != 8 || strncmp( key.str, "__base64", 8 ) != 0 )
+		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_PARSE_ERROR, "expected \"__base64\" in array written as a map" );
+	dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ':' );
+	dl_txt_eat_white( &packctx->read_ctx );
+
+	dl_substr data = dl_txt_eat_string( &packctx->read_ctx );
+	if( data.str == 0x0 )
+		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "expected a base64-string" );
+
+	size_t data_len  = (size_t)data.len;
+	size_t elem_size = dl_pod_size( storage );
+	size_t pad       = data_len >= 4 ? (size_t)( data.str[data_len - 1] == '=' ) + (size_t)( data.str[data_len - 2] == '=' ) : 0;
+	size_t size      = data_len / 4 * 3 - pad;
+	if( data_len % 4 != 0 || size % elem_size != 0 )
+		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "base64-string of %u chars is not a whole number of %u byte elements", (unsigned int)data_len, (unsigned int)elem_size );
+	if( size / elem_size > max_length )
+		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "to many elements in inline array, max %u", max_length );
+
+	// ... decode in chunks that are a multiple of all element sizes to be able to swap in place on big endian hosts ...
+	uint8_t chunk[3 * 1024];
+	size_t decoded = 0;
+	for( size_t i = 0; i < data_len; i += sizeof(chunk) / 3 * 4 )
+	{
+		size_t chunk_len = data_len - i < sizeof(chunk) / 3 * 4 ? data_len - i : sizeof(chunk) / 3 * 4;
+		size_t chunk_size = dl_txt_parse_base64( data.str + i, chunk_len, chunk );
+		if( chunk_size == (size_t)-1 )
+			dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "invalid base64-string" );
+		if( DL_ENDIAN_HOST == DL_ENDIAN_BIG )
+			dl_swap_endian_array( chunk, chunk, chunk_size / elem_size, elem_size );
+		dl_binary_writer_write( packctx->writer, chunk, chunk_size );
+		decoded += chunk_size;
+	}
 
-    // handle trailing ,
-    dl_txt_eat_white( &packctx->read_ctx );
-    if(*packctx->read_ctx.iter == ',')
-        ++packctx->read_ctx.iter;
-    dl_txt_eat_white( &packctx->read_ctx );
+	// ... '=' in the middle of the string ...
+	if( decoded != size )
+		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "invalid base64-string" );
+
+	dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '}' );
+	return (uint32_t)( size / elem_size );
+}
+
+/**
+ * Parse a string-array until ']'. The string-data is written at the end of the writer as the strings are parsed and
+ * the offsets to them are kept in packctx->array_scratch until the array itself can be written after the last string.
+ * Returns the number of elements found and the position of the written array in array_pos.
+ */
+static uint32_t dl_txt_pack_eat_and_write_string_array( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, size_t* array_pos )
+{
+	packctx->array_scratch.Clear();
+
+	uint32_t array_length = 0;
+	while( dl_txt_pack_array_next_element( dl_ctx, packctx, &array_length, UINT32_MAX ) )
+		packctx->array_scratch.Add( dl_txt_pack_eat_and_write_string_data( dl_ctx, packctx ) );
+
+	dl_binary_writer_seek_end( packctx->writer );
+	dl_binary_writer_align( packctx->writer, sizeof(void*) );
+	*array_pos = dl_binary_writer_tell( packctx->writer );
+	for( uint32_t i = 0; i < array_length; ++i )
+	{
+		packctx->AddReloc( dl_binary_writer_tell( packctx->writer ) );
+		dl_binary_writer_write( packctx->writer, &packctx->array_scratch[i], sizeof(size_t) );
+	}
+	return array_length;
 }
 
 static void dl_txt_pack_array_item_size_align( dl_ctx_t dl_ctx,
@@ -506,7 +520,7 @@ static void dl_txt_pack_array_item_size_align( dl_ctx_t dl_ctx,
 	{
 		case DL_TYPE_STORAGE_STRUCT:
 		{
-			const dl_type_desc* type = dl_internal_find_type( dl_ctx, member->type_id );
+			const dl_type_desc* type = dl_internal_member_sub_type( dl_ctx, member );
 			*size = type->size[DL_PTR_SIZE_HOST];
 			*align = type->alignment[DL_PTR_SIZE_HOST];
 			break;
@@ -518,6 +532,21 @@ static void dl_txt_pack_array_item_size_align( dl_ctx_t dl_ctx,
 	}
 }
 
+/**
+ * Skip a string quoted with ' or ", iter should point to the opening quote. Returns a pointer to the closing quote.
+ */
+static const char* dl_txt_skip_quoted_string( const char* iter, const char* end )
+{
+	char quote = *iter++;
+	while( iter != end && *iter != quote )
+	{
+		if( *iter == '\\' && iter + 1 != end )
+			++iter;
+		++iter;
+	}
+	return iter;
+}
+
 const char* dl_txt_skip_array( const char* iter, const char* end )
 {
 	iter = dl_txt_skip_white( iter, end );
@@ -534,6 +563,13 @@ const char* dl_txt_skip_array( const char* iter, const char* end )
 			case 0x0: return "\0";
 			case '[': ++depth; break;
 			case ']': --depth; break;
+			case '"':
+			case '\'':
+				// ... skip strings so that brackets, or what looks like comments, in them are not interpreted ...
+				iter = dl_txt_skip_quoted_string( iter, end );
+				if( iter == end )
+					return "\0";
+				break;
 			default: break;
 		}
 		++iter;
@@ -558,6 +594,13 @@ const char* dl_txt_skip_map( const char* iter, const char* end )
 			case 0x0: return "\0";
 			case '{': ++depth; break;
 			case '}': --depth; break;
+			case '"':
+			case '\'':
+				// ... skip strings so that brackets, or what looks like comments, in them are not interpreted ...
+				iter = dl_txt_skip_quoted_string( iter, end );
+				if( iter == end )
+					return "\0";
+				break;
 			default: break;
 		}
 		++iter;
@@ -587,120 +630,60 @@ const char* dl_txt_skip_string( const char* str, const char* end )
 	return str;
 }
 
-static uint32_t dl_txt_pack_find_array_length( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, const dl_member_desc* member )
+/**
+ * Count the elements of a struct-array by skimming the text up to the closing ']' without parsing it. at_end is set if
+ * the end of the text in the window was reached before ']'.
+ */
+static uint32_t dl_txt_pack_skim_struct_array_length( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, bool* at_end )
 {
 	const char* iter = packctx->read_ctx.iter;
 	const char* end  = packctx->read_ctx.end;
+	*at_end = false;
 
 	iter = dl_txt_skip_white( iter, end );
 	if( *iter == ']' )
 		return 0;
 
-	switch( member->StorageType() )
+	bool last_was_comma = false;
+	uint32_t array_length = 1;
+	while(true)
 	{
-		case DL_TYPE_STORAGE_INT8: // TODO: for pods there are no need to check array length!
-		case DL_TYPE_STORAGE_INT16:
-		case DL_TYPE_STORAGE_INT32:
-		case DL_TYPE_STORAGE_INT64:
-		case DL_TYPE_STORAGE_UINT8:
-		case DL_TYPE_STORAGE_UINT16:
-		case DL_TYPE_STORAGE_UINT32:
-		case DL_TYPE_STORAGE_UINT64:
-		case DL_TYPE_STORAGE_FP32:
-		case DL_TYPE_STORAGE_FP64:
-		case DL_TYPE_STORAGE_PTR:
-		case DL_TYPE_STORAGE_ENUM_INT8:
-		case DL_TYPE_STORAGE_ENUM_INT16:
-		case DL_TYPE_STORAGE_ENUM_INT32:
-		case DL_TYPE_STORAGE_ENUM_INT64:
-		case DL_TYPE_STORAGE_ENUM_UINT8:
-		case DL_TYPE_STORAGE_ENUM_UINT16:
-		case DL_TYPE_STORAGE_ENUM_UINT32:
-		case DL_TYPE_STORAGE_ENUM_UINT64:
-		 // TODO: bug, but in typelib build, there can't be any , in an enum-string.
-		{
-            bool last_was_comma = false;
-			uint32_t array_length = 1;
-			while(true)
-			{
-				iter = dl_txt_skip_white( iter, end );
-				switch( *iter )
-				{
-					case ',':
-						++array_length;
-						break;
-					case '\0':
-					case ']':
-						return last_was_comma ? array_length - 1 : array_length;
-                    // TODO: I guess one can fool this parser by adding a ] or , in a comment at "the right place(tm)"
-				}
-                last_was_comma = *iter == ',';
-				++iter;
-			}
-		}
-		break;
-		case DL_TYPE_STORAGE_STR:
+		iter = dl_txt_skip_white(iter, end);
+		switch( *iter )
 		{
-            bool last_was_comma = false;
-			uint32_t array_length = 1;
-			while(true)
-			{
-				iter = dl_txt_skip_white( iter, end );
-				switch( *iter )
-				{
-					case ',':
-						++array_length;
-						break;
-					case '"':
-						iter = dl_txt_skip_string( ++iter, end );
-						break;
-					case '\0':
-					case ']':
-						return last_was_comma ? array_length - 1 : array_length;
-                    // TODO: I guess one can fool this parser by adding a ] or , in a comment at "the right place(tm)"
-				}
-                last_was_comma = *iter == ',';
+			case ',':
+				++array_length;
 				++iter;
-			}
-		}
-		break;
-		case DL_TYPE_STORAGE_STRUCT:
-		{
-			bool last_was_comma = false;
-			uint32_t array_length = 1;
-			while(true)
-			{
-				iter = dl_txt_skip_white(iter, end);
-				switch( *iter )
-				{
-					case ',':
-						++array_length;
-						++iter;
-						last_was_comma = true;
-						break;
-					case '{':
-						last_was_comma = false;
-						iter = dl_txt_skip_map(iter, end);
-						break;
-					case '[':
-						last_was_comma = false;
-						iter = dl_txt_skip_array(iter, end);
-						break;
-					case '\0':
-					case ']':
-						return last_was_comma ? array_length - 1 : array_length;
-					default:
-						dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_PARSE_ERROR,
-									"Invalid txt-format, are you missing an '}' or an ']'?");
-					// TODO: I guess one can fool this parser by adding a ] or , in a comment at "the right place(tm)"
-				}
-			}
+				last_was_comma = true;
+				break;
+			case '{':
+				last_was_comma = false;
+				iter = dl_txt_skip_map(iter, end);
+				break;
+			case '[':
+				last_was_comma = false;
+				iter = dl_txt_skip_array(iter, end);
+				break;
+			case '\0':
+				*at_end = true;
+				return last_was_comma ? array_length - 1 : array_length;
+			case ']':
+				return last_was_comma ? array_length - 1 : array_length;
+			default:
+				dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_PARSE_ERROR,
+							"Invalid txt-format, are you missing an '}' or an ']'?");
 		}
-		break;
-		default:
-			DL_ASSERT(false);
 	}
-	return (uint32_t)-1;
+}
+
+static uint32_t dl_txt_pack_find_struct_array_length( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx )
+{
+	// ... when reading from a stream, read more and skim again until all of the array is in the window ...
+	bool at_end;
+	uint32_t array_length = dl_txt_pack_skim_struct_array_length( dl_ctx, packctx, &at_end );
+	while( at_end && dl_txt_read_more( &packctx->read_ctx ) )
+		array_length = dl_txt_pack_skim_struct_array_length( dl_ctx, packctx, &at_end );
+	return array_length;
 }
 
 static void dl_txt_pack_write_default_value( dl_ctx_t              dl_ctx,
@@ -766,12 +749,13 @@ static void dl_txt_pack_write_default_value( dl_ctx_t              dl_ctx,
 		dl_binary_writer_write( packctx->writer, member_default_value, member->size[DL_PTR_SIZE_HOST] );
 	}
 
+	uintptr_t subdata_pos = 0;
 	if( member_size != member->default_value_size )
 	{
 		uint8_t* subdata = member_default_value + member_size;
 		// ... sub ptrs, copy and patch ...
 		dl_binary_writer_seek_end( packctx->writer );
-		uintptr_t subdata_pos = dl_binary_writer_tell( packctx->writer );
+		subdata_pos = dl_binary_writer_tell( packctx->writer );
 
 		dl_binary_writer_write( packctx->writer, subdata, member->default_value_size - member_size );
 
@@ -779,6 +763,18 @@ static void dl_txt_pack_write_default_value( dl_ctx_t              dl_ctx,
 		if( !packctx->writer->dummy )
 			dl_internal_patch_member( dl_ctx, member, member_data, (uintptr_t)packctx->writer->data, subdata_pos - member_size );
 	}
+
+	if( packctx->store_relocs && member->AtomType() != DL_TYPE_ATOM_BITFIELD )
+	{
+		// ... pointers in the default-value is relative to the default-value, move offsets to where member and subdata was written ...
+		size_t reloc_start = packctx->relocs.Len();
+		dl_internal_collect_member_relocs( dl_ctx, member, member_default_value, &packctx->relocs );
+		for( size_t i = reloc_start; i < packctx->relocs.Len(); ++i )
+		{
+			uint32_t offset = packctx->relocs[i];
+			packctx->relocs[i] = offset < member_size ? (uint32_t)( member_pos + offset ) : (uint32_t)( subdata_pos + offset - member_size );
+		}
+	}
 }
 
 static void dl_txt_pack_member( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, size_t instance_pos, const dl_member_desc* member )
@@ -803,8 +799,8 @@ static void dl_txt_pack_member( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, size_
 				case DL_TYPE_STORAGE_FP32:   dl_txt_pack_eat_and_write_fp32( dl_ctx, packctx );   break;
 				case DL_TYPE_STORAGE_FP64:   dl_txt_pack_eat_and_write_fp64( dl_ctx, packctx );   break;
 				case DL_TYPE_STORAGE_STR:    dl_txt_pack_eat_and_write_string( dl_ctx, packctx ); break;
-				case DL_TYPE_STORAGE_PTR:    dl_txt_pack_eat_and_write_ptr( dl_ctx, packctx, dl_internal_find_type( dl_ctx, member->type_id ), member_pos ); break;
-				case DL_TYPE_STORAGE_STRUCT: dl_txt_pack_eat_and_write_struct( dl_ctx, packctx, dl_internal_find_type( dl_ctx, member->type_id ) ); break;
+				case DL_TYPE_STORAGE_PTR:    dl_txt_pack_eat_and_write_ptr( dl_ctx, packctx, dl_internal_member_sub_type( dl_ctx, member ), member_pos ); break;
+				case DL_TYPE_STORAGE_STRUCT: dl_txt_pack_eat_and_write_struct( dl_ctx, packctx, dl_internal_member_sub_type( dl_ctx, member ) ); break;
 				case DL_TYPE_STORAGE_ENUM_INT8:
 				case DL_TYPE_STORAGE_ENUM_INT16:
 				case DL_TYPE_STORAGE_ENUM_INT32:
@@ -828,50 +824,77 @@ static void dl_txt_pack_member( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, size_
 		break;
 		case DL_TYPE_ATOM_ARRAY:
 		{
-			dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '[' );
-			uint32_t array_length = dl_txt_pack_find_array_length( dl_ctx, packctx, member );
-			if( array_length == 0 )
+			uint32_t array_length = 0;
+			size_t array_pos = 0;
+
+			dl_txt_eat_white( &packctx->read_ctx );
+			if( *packctx->read_ctx.iter == '{' && dl_is_number_storage( member->StorageType() ) )
 			{
-				dl_binary_writer_write_pint( packctx->writer, (size_t)-1 );
-				dl_binary_writer_write_uint32( packctx->writer, 0 );
+				dl_binary_writer_seek_end( packctx->writer );
+				dl_binary_writer_align( packctx->writer, dl_pod_size( member->StorageType() ) );
+				array_pos = dl_binary_writer_tell( packctx->writer );
+				array_length = dl_txt_pack_eat_and_write_base64_array( dl_ctx, packctx, member->StorageType(), UINT32_MAX );
 			}
 			else
 			{
-				size_t element_size, element_align;
-				dl_txt_pack_array_item_size_align( dl_ctx, member, &element_size, &element_align );
-				size_t array_pos = dl_binary_writer_needed_size( packctx->writer );
-				array_pos = dl_internal_align_up( array_pos, element_align );
+				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '[' );
+				dl_txt_eat_white( &packctx->read_ctx );
+				if( *packctx->read_ctx.iter != ']' )
+				{
+					size_t element_size, element_align;
+					dl_txt_pack_array_item_size_align( dl_ctx, member, &element_size, &element_align );
 
-				dl_binary_writer_write_pint( packctx->writer, array_pos );
-				dl_binary_writer_write_uint32( packctx->writer, array_length );
-				dl_binary_writer_seek_end( packctx->writer );
-				dl_binary_writer_align( packctx->writer, element_align );
-				dl_binary_writer_reserve( packctx->writer, array_length * element_size );
-				dl_txt_pack_eat_and_write_array( dl_ctx, packctx, member, array_length );
+					const dl_type_desc* sub_type = member->StorageType() == DL_TYPE_STORAGE_STRUCT ? dl_internal_member_sub_type( dl_ctx, member ) : 0x0;
+					if( member->StorageType() == DL_TYPE_STORAGE_STR )
+					{
+						array_length = dl_txt_pack_eat_and_write_string_array( dl_ctx, packctx, &array_pos );
+					}
+					else if( sub_type != 0x0 && ( sub_type->flags & DL_TYPE_FLAG_HAS_SUBDATA ) )
+					{
+						// ... elements write their subdata at the end of the writer while being parsed, so the array need to be reserved up front ...
+						array_length = dl_txt_pack_find_struct_array_length( dl_ctx, packctx );
+						dl_binary_writer_seek_end( packctx->writer );
+						dl_binary_writer_align( packctx->writer, element_align );
+						array_pos = dl_binary_writer_tell( packctx->writer );
+						dl_binary_writer_reserve( packctx->writer, array_length * element_size );
+						dl_txt_pack_eat_and_write_array( dl_ctx, packctx, member, array_pos, array_length );
+					}
+					else
+					{
+						// ... no subdata, elements end up right after each other when written to the end of the writer as they are parsed ...
+						dl_binary_writer_seek_end( packctx->writer );
+						dl_binary_writer_align( packctx->writer, element_align );
+						array_pos = dl_binary_writer_tell( packctx->writer );
+						array_length = dl_txt_pack_eat_and_write_array( dl_ctx, packctx, member, array_pos, UINT32_MAX );
+					}
+				}
+				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ']' );
 			}
-			dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ']' );
+
+			dl_binary_writer_seek_set( packctx->writer, member_pos );
+			packctx->AddReloc( member_pos );
+			dl_binary_writer_write_pint( packctx->writer, array_length == 0 ? (size_t)-1 : array_pos );
+			dl_binary_writer_write_uint32( packctx->writer, array_length );
 		}
 		break;
 		case DL_TYPE_ATOM_INLINE_ARRAY:
 		{
-			dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '[' );
-			uint32_t array_length = dl_txt_pack_find_array_length( dl_ctx, packctx, member );
-			if(array_length > member->inline_array_cnt())
+			uint32_t array_length;
+			dl_txt_eat_white( &packctx->read_ctx );
+			bool base64 = *packctx->read_ctx.iter == '{' && dl_is_number_storage( member->StorageType() );
+			if( base64 )
+				array_length = dl_txt_pack_eat_and_write_base64_array( dl_ctx, packctx, member->StorageType(), member->inline_array_cnt() );
+			else
 			{
-				dl_txt_read_failed( dl_ctx,
-									&packctx->read_ctx,
-									DL_ERROR_MALFORMED_DATA,
-									"to many elements in inline array, %u > %u", array_length, member->inline_array_cnt() );
+				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '[' );
+				array_length = dl_txt_pack_eat_and_write_array( dl_ctx, packctx, member, member_pos, member->inline_array_cnt() );
 			}
 
-			if(array_length > 0)
-				dl_txt_pack_eat_and_write_array( dl_ctx, packctx, member, array_length );
-
 			switch(member->StorageType())
 			{
 				case DL_TYPE_STORAGE_STRUCT:
 				{
-					const dl_type_desc* sub_type = dl_internal_find_type(dl_ctx, member->type_id);
+					const dl_type_desc* sub_type = dl_internal_member_sub_type( dl_ctx, member );
 
 					// fill missing elements with defaults!
 					size_t current_member_array_position = member_pos + sub_type->size[DL_PTR_SIZE_HOST] * array_length;
@@ -894,12 +917,19 @@ static void dl_txt_pack_member( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, size_
 				{
 					// default type to zero!
 					uint32_t missing_elements = member->inline_array_cnt() - array_length;
+					if( member->StorageType() == DL_TYPE_STORAGE_STR || member->StorageType() == DL_TYPE_STORAGE_PTR )
+					{
+						// zeroed ptrs will still be patched by dl_internal_patch_instance(), keep table in sync with that.
+						for( uint32_t i = array_length; i < member->inline_array_cnt(); ++i )
+							packctx->AddReloc( member_pos + i * sizeof(void*) );
+					}
 					if(missing_elements > 0)
 						dl_binary_writer_write_zero(packctx->writer, missing_elements * dl_pod_size(member->StorageType()));
 				}
 			}
 
-			dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ']' );
+			if( !base64 )
+				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ']' );
 		}
 		break;
 		case DL_TYPE_ATOM_BITFIELD:
@@ -1003,6 +1033,58 @@ static const dl_substr dl_txt_eat_object_key( dl_txt_read_ctx* readctx )
 	return res;
 }
 
+/**
+ * Write default values of all members in type that are not set in members_set, fail if one of them has no default value.
+ */
+static void dl_txt_pack_write_missing_defaults( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, const dl_type_desc* type, size_t instance_pos, const uint64_t* members_set )
+{
+	for( uint32_t i = 0; i < type->member_count; ++i )
+	{
+		int member_bit_chunk = i / 64;
+		int member_bit_index = i % 64;
+		if( members_set[member_bit_chunk] & ( 1ULL << member_bit_index ) )
+			continue;
+
+		const dl_member_desc* member = dl_get_type_member( dl_ctx, type, i );
+		if( member->default_value_offset == UINT32_MAX )
+			dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_MISSING_MEMBER, "member %s.%s is not set and has no default value", dl_internal_type_name( dl_ctx, type ), dl_internal_member_name( dl_ctx, member ) );
+
+		size_t   member_pos = instance_pos + member->offset[DL_PTR_SIZE_HOST];
+		dl_txt_pack_write_default_value(dl_ctx, packctx, member, member_pos);
+	}
+}
+
+/**
+ * Handle keys starting with "__" that are reserved for dl, reads "__subdata" and fails on all others.
+ * @return false if member_name is not a reserved key.
+ */
+static bool dl_txt_pack_eat_reserved_key( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, const dl_type_desc* type, dl_substr member_name )
+{
+	if( member_name.str[0] != '_' || member_name.str[1] != '_' )
+		return false;
+
+	// ... members with __ are reserved for dl, check if __subdata map, otherwise warn ...
+	if( strncmp( "__subdata", member_name.str, 9 ) == 0 )
+	{
+		dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ':' );
+
+		if( packctx->subdata_found )
+			dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "\"__subdata\" set twice!" );
+
+		// ... read all of the map to the window if reading from a stream, it is kept there by the pin until parsed ...
+		const char* subdata_end = dl_txt_skip_map( packctx->read_ctx.iter, packctx->read_ctx.end );
+		while( *subdata_end == '\0' && dl_txt_read_more( &packctx->read_ctx ) )
+			subdata_end = dl_txt_skip_map( packctx->read_ctx.iter, packctx->read_ctx.end );
+
+		packctx->subdata_found = true;
+		packctx->read_ctx.pin  = packctx->read_ctx.iter;
+		packctx->read_ctx.iter = subdata_end;
+		return true;
+	}
+	dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_INVALID_MEMBER, "type %s has no member named %.*s", dl_internal_type_name( dl_ctx, type ), member_name.len, member_name.str );
+	return false;
+}
+
 static void dl_txt_pack_eat_and_write_struct( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, const dl_type_desc* type )
 {
 	uint64_t members_set[DL_MEMBERS_IN_TYPE_MAX / 64] = {0};
@@ -1023,6 +1105,14 @@ static void dl_txt_pack_eat_and_write_struct( dl_ctx_t dl_ctx, dl_txt_pack_ctx*
 	size_t instance_pos = dl_binary_writer_tell( packctx->writer );
 	dl_binary_writer_reserve( packctx->writer, type->size[DL_PTR_SIZE_HOST] );
 
+	// ... use routines generated by dltlc if registered for the type ...
+	const dl_txt_gen_funcs* gen = dl_internal_find_txt_gen( dl_ctx, type );
+	if( gen != 0x0 && gen->pack != 0x0 )
+	{
+		gen->pack( packctx, instance_pos );
+		return;
+	}
+
 	while( true )
 	{
 		// ... read all members ...
@@ -1035,25 +1125,16 @@ static void dl_txt_pack_eat_and_write_struct( dl_ctx_t dl_ctx, dl_txt_pack_ctx*
 		dl_txt_eat_white( &packctx->read_ctx );
 		dl_substr member_name = dl_txt_eat_object_key( &packctx->read_ctx );
 		if( member_name.str == 0x0 )
-			dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "expected map-key containing member name." );
-
-		if( member_name.str[0] == '_' && member_name.str[1] == '_' )
 		{
-			// ... members with __ are reserved for dl, check if __subdata map, otherwise warn ...
-			if( strncmp( "__subdata", member_name.str, 9 ) == 0 )
-			{
-				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ':' );
-
-				if( packctx->subdata_pos )
-					dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "\"__subdata\" set twice!" );
-
-				packctx->subdata_pos = packctx->read_ctx.iter;
-				packctx->read_ctx.iter = dl_txt_skip_map( packctx->read_ctx.iter, packctx->read_ctx.end );
-				continue;
-			}
-			dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_INVALID_MEMBER, "type %s has no member named %.*s", dl_internal_type_name( dl_ctx, type ), member_name.len, member_name.str );
+			// ... ']' or end of text where a key was expected is most likely a missing '}' ...
+			if( *packctx->read_ctx.iter == ']' || *packctx->read_ctx.iter == '\0' )
+				dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '}' );
+			dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "expected map-key containing member name." );
 		}
 
+		if( dl_txt_pack_eat_reserved_key( dl_ctx, packctx, type, member_name ) )
+			continue;
+
 		if( type->flags & DL_TYPE_FLAG_IS_UNION )
 		{
 			if( member_index != 0xFFFFFFFF )
@@ -1093,40 +1174,20 @@ static void dl_txt_pack_eat_and_write_struct( dl_ctx_t dl_ctx, dl_txt_pack_ctx*
 		dl_binary_writer_write_uint32( packctx->writer, dl_internal_typeid_of(dl_ctx, type) + member_index + 1 );
 	}
 	else
-	{
-		for( uint32_t i = 0; i < type->member_count; ++i )
-		{
-			int member_bit_chunk = i / 64;
-			int member_bit_index = i % 64;
-			if( members_set[member_bit_chunk] & ( 1ULL << member_bit_index ) )
-				continue;
-
-			const dl_member_desc* member = dl_get_type_member( dl_ctx, type, i );
-			if( member->default_value_offset == UINT32_MAX )
-				dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_MISSING_MEMBER, "member %s.%s is not set and has no default value", dl_internal_type_name( dl_ctx, type ), dl_internal_member_name( dl_ctx, member ) );
-
-			size_t   member_pos = instance_pos + member->offset[DL_PTR_SIZE_HOST];
-			dl_txt_pack_write_default_value(dl_ctx, packctx, member, member_pos);
-		}
-	}
+		dl_txt_pack_write_missing_defaults( dl_ctx, packctx, type, instance_pos, members_set );
 }
 
 static dl_error_t dl_txt_pack_finalize_subdata( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx )
 {
 	if( packctx->subdata.Len() == 0 )
 		return DL_ERROR_OK;
-	if( packctx->subdata_pos == 0x0 )
+	if( !packctx->subdata_found )
 		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_MISSING_SECTION, "instance has pointers but no \"__subdata\"-member" );
 
-	packctx->read_ctx.iter = packctx->subdata_pos;
+	packctx->read_ctx.iter = packctx->read_ctx.pin;
+	packctx->read_ctx.pin  = 0x0;
 
-	struct SSubInstance
-	{
-		dl_substr name;
-		size_t pos;
-	};
-	CArrayStatic<SSubInstance, 256> subinstances(dl_ctx->alloc);
-	subinstances.Add({ { "__root" , 6}, 0 });
+	packctx->AddSubInstance( { "__root", 6 }, 0 );
 
 	dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '{' );
 
@@ -1140,33 +1201,20 @@ static dl_error_t dl_txt_pack_finalize_subdata( dl_ctx_t dl_ctx, dl_txt_pack_ctx
 		if( subdata_name.str == 0x0 )
 			dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "expected map-key containing subdata instance-name." );
 
-		dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ':' );
-
-		size_t subdata_item = std::numeric_limits<size_t>::max();
-		for (size_t i = 0; i < packctx->subdata.Len(); ++i)
-		{
-			if( packctx->subdata[i].name.len != subdata_name.len )
-				continue;
-
-			if( strncmp( packctx->subdata[i].name.str, subdata_name.str, (size_t)subdata_name.len ) == 0 )
-			{
-				subdata_item = i;
-				break;
-			}
-		}
-
-		if (subdata_item == std::numeric_limits<size_t>::max())
+		// ... subdata_name is only valid until more text is read, i.e. until the next token is eaten ...
+		uint32_t subdata_item = packctx->FindSubData( subdata_name );
+		if( subdata_item == UINT32_MAX )
 			dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "non-used subdata." );
 		const dl_type_desc* type = packctx->subdata[subdata_item].type;
 
 		dl_binary_writer_seek_end( packctx->writer );
 		dl_binary_writer_align( packctx->writer, type->alignment[DL_PTR_SIZE_HOST] );
 		size_t inst_pos = dl_binary_writer_tell( packctx->writer );
+		packctx->AddSubInstance( subdata_name, inst_pos );
 
+		dl_txt_eat_char( dl_ctx, &packctx->read_ctx, ':' );
 		dl_txt_pack_eat_and_write_struct( dl_ctx, packctx, type );
 
-		subinstances.Add({ subdata_name, inst_pos });
-
 		dl_txt_eat_white( &packctx->read_ctx );
 		if( packctx->read_ctx.iter[0] == ',' )
 			++packctx->read_ctx.iter;
@@ -1178,22 +1226,13 @@ static dl_error_t dl_txt_pack_finalize_subdata( dl_ctx_t dl_ctx, dl_txt_pack_ctx
 
 	for( size_t i = 0; i < packctx->subdata.Len(); ++i )
 	{
-		bool found = false;
-		for( size_t j = 0; j < subinstances.Len(); ++j )
-		{
-			if( packctx->subdata[i].name.len != subinstances[j].name.len )
-				continue;
+		dl_substr name = packctx->SubDataName( i );
+		uint32_t subinstance = packctx->FindSubInstance( name );
+		if( subinstance == UINT32_MAX )
+			dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "referenced subdata \"%.*s\"", name.len, name.str );
 
-			if( strncmp( packctx->subdata[i].name.str, subinstances[j].name.str, (size_t)subinstances[j].name.len ) == 0 )
-			{
-				found = true;
-				dl_binary_writer_seek_set( packctx->writer, packctx->subdata[i].patch_pos );
-				dl_binary_writer_write_ptr( packctx->writer, subinstances[j].pos );
-			}
-		}
-
-		if( !found )
-			dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "referenced subdata \"%.*s\"", packctx->subdata[i].name.len, packctx->subdata[i].name.str );
+		dl_binary_writer_seek_set( packctx->writer, packctx->subdata[i].patch_pos );
+		dl_binary_writer_write_ptr( packctx->writer, packctx->subinstances[subinstance].pos );
 	}
 
 	return DL_ERROR_OK;
@@ -1236,6 +1275,40 @@ static const dl_type_desc* dl_txt_pack_inner( dl_ctx_t dl_ctx, dl_txt_pack_ctx*
 	return 0x0;
 }
 
+/**
+ * Pack the text in packctx->read_ctx to packctx->writer and fill in header, the header itself is not written.
+ */
+static dl_error_t dl_txt_pack_to_writer( dl_ctx_t dl_ctx, dl_txt_pack_ctx* packctx, dl_data_header* header )
+{
+	packctx->dl_ctx        = dl_ctx;
+	packctx->store_relocs  = dl_ctx->store_reloc_table;
+	packctx->subdata_found = false;
+	packctx->read_ctx.pin  = 0x0;
+	packctx->read_ctx.err  = DL_ERROR_OK;
+
+	const dl_type_desc* root_type = dl_txt_pack_inner( dl_ctx, packctx );
+	if( packctx->read_ctx.err != DL_ERROR_OK )
+	{
+		dl_report_error_location( dl_ctx, &packctx->read_ctx );
+		return packctx->read_ctx.err;
+	}
+
+	uint32_t instance_size = (uint32_t)dl_binary_writer_needed_size( packctx->writer );
+	uint32_t reloc_count   = 0;
+	if( packctx->store_relocs )
+		reloc_count = dl_internal_write_reloc_table( packctx->writer, &packctx->relocs );
+
+	memset(header, 0x0, sizeof(dl_data_header));
+	header->id                 = DL_INSTANCE_ID;
+	header->version            = DL_INSTANCE_VERSION;
+	header->root_instance_type = dl_internal_typeid_of( dl_ctx, root_type );
+	header->instance_size      = instance_size;
+	header->is_64_bit_ptr      = sizeof(void*) == 8 ? 1 : 0;
+	header->flags              = packctx->store_relocs ? DL_DATA_HEADER_FLAG_HAS_RELOC_TABLE : 0;
+	header->reloc_count        = reloc_count;
+	return DL_ERROR_OK;
+}
+
 dl_error_t dl_txt_pack( dl_ctx_t dl_ctx, const char* txt_instance, unsigned char* out_buffer, size_t out_buffer_size, size_t* produced_bytes )
 {
 	dl_binary_writer writer;
@@ -1248,39 +1321,179 @@ dl_error_t dl_txt_pack( dl_ctx_t dl_ctx, const char* txt_instance, unsigned char
 						   DL_PTR_SIZE_HOST );
 	dl_txt_pack_ctx packctx(dl_ctx->alloc);
 	packctx.writer  = &writer;
-	packctx.read_ctx.start = txt_instance;
-	packctx.read_ctx.end   = txt_instance + strlen(txt_instance); // TODO: pass to function!
-	packctx.read_ctx.iter  = txt_instance;
-	packctx.subdata_pos = 0x0;
-	packctx.read_ctx.err = DL_ERROR_OK;
-
-	const dl_type_desc* root_type = dl_txt_pack_inner( dl_ctx, &packctx );
-	if( packctx.read_ctx.err == DL_ERROR_OK )
-	{
-		// write header
-		if( out_buffer_size > 0 )
-		{
-			dl_data_header header;
-			memset(&header, 0x0, sizeof(dl_data_header));
-			header.id                 = DL_INSTANCE_ID;
-			header.version            = DL_INSTANCE_VERSION;
-			header.root_instance_type = dl_internal_typeid_of( dl_ctx, root_type );
-			header.instance_size      = (uint32_t)dl_binary_writer_needed_size( &writer );
-			header.is_64_bit_ptr      = sizeof(void*) == 8 ? 1 : 0;
-			memcpy( out_buffer, &header, sizeof(dl_data_header) );
-		}
+	packctx.read_ctx.start  = txt_instance;
+	packctx.read_ctx.end    = txt_instance + strlen(txt_instance);
+	packctx.read_ctx.iter   = txt_instance;
+	packctx.read_ctx.stream = 0x0;
 
-		if( produced_bytes )
-			*produced_bytes = (unsigned int)dl_binary_writer_needed_size( &writer ) + sizeof(dl_data_header);
-	}
-	else
+	dl_data_header header;
+	dl_error_t err = dl_txt_pack_to_writer( dl_ctx, &packctx, &header );
+	if( err != DL_ERROR_OK )
+		return err;
+
+	if( out_buffer_size > 0 )
+		memcpy( out_buffer, &header, sizeof(dl_data_header) );
+
+	if( produced_bytes )
+		*produced_bytes = (unsigned int)dl_binary_writer_needed_size( &writer ) + sizeof(dl_data_header);
+	return DL_ERROR_OK;
+}
+
+dl_error_t dl_internal_txt_pack_stream( dl_ctx_t        dl_ctx,     dl_txt_read_func read_func, void* read_ctx, dl_allocator* alloc,
+										unsigned char** out_buffer, size_t*          out_buffer_size )
+{
+	dl_binary_writer writer;
+	dl_binary_writer_init( &writer, 0x0, 0, false, DL_ENDIAN_HOST, DL_ENDIAN_HOST, DL_PTR_SIZE_HOST );
+	dl_binary_writer_init_alloc( &writer, alloc, sizeof(dl_data_header) );
+
+	dl_txt_read_stream stream;
+	stream.read_func     = read_func;
+	stream.read_func_ctx = read_ctx;
+	stream.alloc         = &dl_ctx->alloc;
+	stream.buffer        = (char*)dl_alloc( stream.alloc, 1 );
+	stream.buffer_size   = 0;
+	stream.lines_read    = 0;
+	stream.eof           = false;
+	stream.buffer[0]     = '\0';
+
+	dl_txt_pack_ctx packctx(dl_ctx->alloc);
+	packctx.writer  = &writer;
+	packctx.read_ctx.start  = stream.buffer;
+	packctx.read_ctx.end    = stream.buffer;
+	packctx.read_ctx.iter   = stream.buffer;
+	packctx.read_ctx.pin    = 0x0;
+	packctx.read_ctx.stream = &stream;
+	dl_txt_read_more( &packctx.read_ctx );
+
+	dl_data_header header;
+	dl_error_t err = dl_txt_pack_to_writer( dl_ctx, &packctx, &header );
+	dl_free( stream.alloc, stream.buffer );
+
+	// ... make sure that reserved but unwritten space at the end is allocated as well ...
+	size_t packed_size = dl_binary_writer_needed_size( &writer );
+	dl_binary_writer_grow( &writer, packed_size );
+
+	uint8_t* buffer      = writer.data ? writer.data - sizeof(dl_data_header) : 0x0;
+	size_t   buffer_size = writer.data_size + sizeof(dl_data_header);
+
+	if( err == DL_ERROR_OK && writer.data_size < packed_size )
+		err = DL_ERROR_OUT_OF_INSTANCE_MEMORY;
+
+	if( err != DL_ERROR_OK )
 	{
-		dl_report_error_location( dl_ctx, packctx.read_ctx.start, packctx.read_ctx.end, packctx.read_ctx.iter );
+		if( buffer )
+			dl_free( alloc, buffer );
+		return err;
 	}
-	return packctx.read_ctx.err;
+
+	// ... shrink to what was actually used ...
+	packed_size += sizeof(dl_data_header);
+	uint8_t* shrunk = (uint8_t*)dl_realloc( alloc, buffer, packed_size, buffer_size );
+	if( shrunk != 0x0 )
+		buffer = shrunk;
+
+	memcpy( buffer, &header, sizeof(dl_data_header) );
+
+	*out_buffer      = buffer;
+	*out_buffer_size = packed_size;
+	return DL_ERROR_OK;
+}
+
+dl_error_t dl_txt_pack_stream( dl_ctx_t dl_ctx, dl_txt_read_func read_func, void* read_ctx, unsigned char** out_buffer, size_t* out_buffer_size )
+{
+	return dl_internal_txt_pack_stream( dl_ctx, read_func, read_ctx, &dl_ctx->alloc, out_buffer, out_buffer_size );
 }
 
 dl_error_t dl_txt_pack_calc_size( dl_ctx_t dl_ctx, const char* txt_instance, size_t* out_instance_size )
 {
 	return dl_txt_pack( dl_ctx, txt_instance, 0x0, 0, out_instance_size );
 }
+
+// ... support for pack-routines generated by dltlc, see dl_txt_gen.h ...
+
+int dl_txt_gen_pack_next_key( dl_txt_gen_pack_t packctx, const char** key, size_t* key_len )
+{
+	dl_ctx_t dl_ctx = packctx->dl_ctx;
+
+	// ... same as the member-loop in dl_txt_pack_eat_and_write_struct() ...
+	dl_txt_eat_white( &packctx->read_ctx );
+	if( *packctx->read_ctx.iter == ',' ) ++packctx->read_ctx.iter;
+	dl_txt_eat_white( &packctx->read_ctx );
+	if( *packctx->read_ctx.iter == '}' )
+	{
+		dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '}' );
+		return 0;
+	}
+
+	dl_substr member_name = dl_txt_eat_object_key( &packctx->read_ctx );
+	if( member_name.str == 0x0 )
+	{
+		if( *packctx->read_ctx.iter == ']' || *packctx->read_ctx.iter == '\0' )
+			dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '}' );
+		dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_MALFORMED_DATA, "expected map-key containing member name." );
+	}
+
+	*key     = member_name.str;
+	*key_len = (size_t)member_name.len;
+	return 1;
+}
+
+void dl_txt_gen_pack_unknown_key( dl_txt_gen_pack_t packctx, dl_typeid_t type_id, const char* key, size_t key_len )
+{
+	dl_ctx_t dl_ctx = packctx->dl_ctx;
+	const dl_type_desc* type = dl_internal_find_type( dl_ctx, type_id );
+	dl_substr member_name = { key, (int)key_len };
+	if( dl_txt_pack_eat_reserved_key( dl_ctx, packctx, type, member_name ) )
+		return;
+
+	dl_txt_pack_validate_c_symbol_key( dl_ctx, packctx, member_name );
+	dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_INVALID_MEMBER, "type '%s' has no member named '%.*s'", dl_internal_type_name( dl_ctx, type ), member_name.len, member_name.str );
+}
+
+void dl_txt_gen_pack_set_twice( dl_txt_gen_pack_t packctx, dl_typeid_t type_id, uint32_t member_index )
+{
+	dl_ctx_t dl_ctx = packctx->dl_ctx;
+	const dl_type_desc* type = dl_internal_find_type( dl_ctx, type_id );
+	dl_txt_read_failed( dl_ctx, &packctx->read_ctx, DL_ERROR_TXT_MEMBER_SET_TWICE, "member '%s.%s' is set twice", dl_internal_type_name( dl_ctx, type ), dl_internal_member_name( dl_ctx, dl_get_type_member( dl_ctx, type, member_index ) ) );
+}
+
+void dl_txt_gen_pack_value_separator( dl_txt_gen_pack_t packctx )
+{
+	dl_txt_eat_char( packctx->dl_ctx, &packctx->read_ctx, ':' );
+}
+
+void dl_txt_gen_pack_defaults( dl_txt_gen_pack_t packctx, dl_typeid_t type_id, size_t instance_pos, const uint64_t* members_set )
+{
+	dl_txt_pack_write_missing_defaults( packctx->dl_ctx, packctx, dl_internal_find_type( packctx->dl_ctx, type_id ), instance_pos, members_set );
+}
+
+void dl_txt_gen_pack_member( dl_txt_gen_pack_t packctx, dl_typeid_t type_id, uint32_t member_index, size_t instance_pos )
+{
+	dl_ctx_t dl_ctx = packctx->dl_ctx;
+	dl_txt_pack_member( dl_ctx, packctx, instance_pos, dl_get_type_member( dl_ctx, dl_internal_find_type( dl_ctx, type_id ), member_index ) );
+}
+
+int dl_txt_gen_pack_begin_struct( dl_txt_gen_pack_t packctx, dl_typeid_t type_id, size_t pos )
+{
+	dl_ctx_t dl_ctx = packctx->dl_ctx;
+	dl_binary_writer_seek_set( packctx->writer, pos );
+	dl_txt_eat_white( &packctx->read_ctx );
+	if( *packctx->read_ctx.iter == '[' )
+	{
+		dl_txt_pack_eat_and_write_array_struct( dl_ctx, packctx, dl_internal_find_type( dl_ctx, type_id ) );
+		return 0;
+	}
+	dl_txt_eat_char( dl_ctx, &packctx->read_ctx, '{' );
+	return 1;
+}
+
+void dl_txt_gen_pack_int8  ( dl_txt_gen_pack_t packctx, size_t pos ) { dl_binary_writer_seek_set( packctx->writer, pos ); dl_txt_pack_eat_and_write_int8  ( packctx->dl_ctx, packctx ); }
+void dl_txt_gen_pack_int16 ( dl_txt_gen_pack_t packctx, size_t pos ) { dl_binary_writer_seek_set( packctx->writer, pos ); dl_txt_pack_eat_and_write_int16 ( packctx->dl_ctx, packctx ); }
+void dl_txt_gen_pack_int32 ( dl_txt_gen_pack_t packctx, size_t pos ) { dl_binary_writer_seek_set( packctx->writer, pos ); dl_txt_pack_eat_and_write_int32 ( packctx->dl_ctx, packctx ); }
+void dl_txt_gen_pack_int64 ( dl_txt_gen_pack_t packctx, size_t pos ) { dl_binary_writer_seek_set( packctx->writer, pos ); dl_txt_pack_eat_and_write_int64 ( packctx->dl_ctx, packctx ); }
+void dl_txt_gen_pack_uint8 ( dl_txt_gen_pack_t packctx, size_t pos ) { dl_binary_writer_seek_set( packctx->writer, pos ); dl_txt_pack_eat_and_write_uint8 ( packctx->dl_ctx, packctx ); }
+void dl_txt_gen_pack_uint16( dl_txt_gen_pack_t packctx, size_t pos ) { dl_binary_writer_seek_set( packctx->writer, pos ); dl_txt_pack_eat_and_write_uint16( packctx->dl_ctx, packctx ); }
+void dl_txt_gen_pack_uint32( dl_txt_gen_pack_t packctx, size_t pos ) { dl_binary_writer_seek_set( packctx->writer, pos ); dl_txt_pack_eat_and_write_uint32( packctx->dl_ctx, packctx ); }
+void dl_txt_gen_pack_uint64( dl_txt_gen_pack_t packctx, size_t pos ) { dl_binary_writer_seek_set( packctx->writer, pos ); dl_txt_pack_eat_and_write_uint64( packctx->dl_ctx, packctx ); }
+void dl_txt_gen_pack_fp32  ( dl_txt_gen_pack_t packctx, size_t pos ) { dl_binary_writer_seek_set( packctx->writer, pos ); dl_txt_pack_eat_and_write_fp32  ( packctx->dl_ctx, packctx ); }
+void dl_txt_gen_pack_fp64  ( dl_txt_gen_pack_t packctx, size_t pos ) { dl_binary_writer_seek_set( packctx->writer, pos ); dl_txt_pack_eat_and_write_fp64  ( packctx->dl_ctx, packctx ); }
@@ -2,8 +2,9 @@
 
 #include "dl_txt_read.h"
 
-#include <errno.h>
-#include <stdlib.h>
+#include <float.h>
+#include <limits.h>
+#include <string.h>
 
 struct dl_txt_binlit
 {
@@ -52,6 +53,85 @@ static dl_txt_binlit dl_txt_pack_eat_binlit(dl_txt_read_ctx* read_ctx, int max_b
 	}
 }
 
+static inline unsigned dl_txt_digit_value( char c, unsigned base )
+{
+	if( c >= '0' && c <= '9' )
+		return (unsigned)(c - '0');
+	if( base == 16 )
+	{
+		c = (char)(c | 0x20);
+		if( c >= 'a' && c <= 'f' )
+			return (unsigned)(c - 'a' + 10);
+	}
+	return 16;
+}
+
+struct dl_txt_uint
+{
+	uint64_t value;
+	bool     was_negative;
+	bool     was_overflow;
+};
+
+/**
+ * Parse an integer with the same syntax as strtoull(str, &next, 0), i.e. an optional sign followed by
+ * decimal, 0x-prefixed hex or 0-prefixed octal digits. The magnitude is returned as is, clamped to
+ * UINT64_MAX and flagged on overflow.
+ *
+ * @return pointer to first character after the parsed number, str if no number could be parsed.
+ */
+static const char* dl_txt_parse_uint( const char* str, dl_txt_uint* out )
+{
+	const char* iter = str;
+	out->value        = 0;
+	out->was_negative = false;
+	out->was_overflow = false;
+
+	if( *iter == '-' || *iter == '+' )
+		out->was_negative = *iter++ == '-';
+
+	unsigned base = 10;
+	if( iter[0] == '0' )
+	{
+		if( (iter[1] | 0x20) == 'x' && dl_txt_digit_value( iter[2], 16 ) < 16 )
+		{
+			base = 16;
+			iter += 2;
+		}
+		else
+			base = 8;
+	}
+
+	const char* digits = iter;
+	const uint64_t limit = UINT64_MAX / base;
+	uint64_t v = 0;
+	while( true )
+	{
+		unsigned d = dl_txt_digit_value( *iter, base );
+		if( d >= base )
+			break;
+		if( v > limit || v * base > UINT64_MAX - d )
+			out->was_overflow = true;
+		else
+			v = v * base + d;
+		++iter;
+	}
+
+	if( iter == digits )
+		return str;
+
+	out->value = out->was_overflow ? UINT64_MAX : v;
+	return iter;
+}
+
+static bool dl_txt_is_keyword( const char* str, const char* keyword, size_t len )
+{
+	for( size_t i = 0; i < len; ++i )
+		if( tolower( str[i] ) != keyword[i] )
+			return false;
+	return true;
+}
+
 long long dl_txt_pack_eat_strtoll( dl_ctx_t dl_ctx, dl_txt_read_ctx* read_ctx, long long range_min, long long range_max, const char* type )
 {
 	dl_txt_eat_white( read_ctx );
@@ -69,37 +149,35 @@ long long dl_txt_pack_eat_strtoll( dl_ctx_t dl_ctx, dl_txt_read_ctx* read_ctx, l
 		v = (bin.was_negative ? -1 : 1) * (long long)bin.value;
 	else
 	{
-		errno = 0;
-	#if defined(_MSC_VER)
-		v = _strtoi64( read_ctx->iter, &next, 0 );
-	#else
-		v = strtoll( read_ctx->iter, &next, 0 );
-	#endif
+		dl_txt_uint u;
+		next = (char*)dl_txt_parse_uint( read_ctx->iter, &u );
 
 		if( read_ctx->iter == next )
 		{
-			if( tolower(read_ctx->iter[0]) == 'm')
+			if( dl_txt_is_keyword( read_ctx->iter, "max", 3 ) && !isalnum(read_ctx->iter[3]) )
 			{
-				if( tolower(read_ctx->iter[1]) == 'a' &&
-					tolower(read_ctx->iter[2]) == 'x' &&
-				!isalnum(read_ctx->iter[3]) )
-				{
-					read_ctx->iter += 3;
-					return range_max;
-				}
-				if( tolower(read_ctx->iter[1]) == 'i' &&
-					tolower(read_ctx->iter[2]) == 'n' &&
-				!isalnum(read_ctx->iter[3]))
-				{
-					read_ctx->iter += 3;
-					return range_min;
-				}
+				read_ctx->iter += 3;
+				return range_max;
+			}
+			if( dl_txt_is_keyword( read_ctx->iter, "min", 3 ) && !isalnum(read_ctx->iter[3]) )
+			{
+				read_ctx->iter += 3;
+				return range_min;
 			}
 			dl_txt_read_failed( dl_ctx, read_ctx, DL_ERROR_MALFORMED_DATA, "expected a value of type '%s'", type );
 		}
+
+		// ... same clamping as strtoll() ...
+		if( u.was_negative )
+			v = u.value > (uint64_t)LLONG_MAX + 1 ? LLONG_MIN : -(long long)(u.value - 1) - 1;
+		else
+			v = u.value > (uint64_t)LLONG_MAX ? LLONG_MAX : (long long)u.value;
+
+		if( u.was_overflow || u.value > (uint64_t)LLONG_MAX + u.was_negative )
+			dl_txt_read_failed( dl_ctx, read_ctx, DL_ERROR_TXT_RANGE_ERROR, "expected a value of type '%s', %lld is out of range.", type, v );
 	}
 
-	if( !(v >= range_min && v <= range_max) || errno == ERANGE )
+	if( !(v >= range_min && v <= range_max) )
 		dl_txt_read_failed( dl_ctx, read_ctx, DL_ERROR_TXT_RANGE_ERROR, "expected a value of type '%s', %lld is out of range.", type, v );
 	read_ctx->iter = next;
 	return v;
@@ -129,45 +207,749 @@ unsigned long long dl_txt_pack_eat_strtoull( dl_ctx_t dl_ctx, dl_txt_read_ctx* r
 	}
 	else
 	{
-		errno = 0;
-	#if defined(_MSC_VER)
-		v = _strtoui64( read_ctx->iter, &next, 0 );
-	#else
-		v = strtoull( read_ctx->iter, &next, 0 );
-	#endif
+		dl_txt_uint u;
+		next = (char*)dl_txt_parse_uint( read_ctx->iter, &u );
 
 		if( read_ctx->iter == next )
 		{
-			if( tolower(read_ctx->iter[0]) == 'm' )
+			if( dl_txt_is_keyword( read_ctx->iter, "max", 3 ) && !isalnum(read_ctx->iter[3]) )
 			{
-				if( tolower(read_ctx->iter[1]) == 'a' &&
-					tolower(read_ctx->iter[2]) == 'x' &&
-				!isalnum(read_ctx->iter[3]))
-				{
-					read_ctx->iter += 3;
-					return range_max;
-				}
-				if( tolower(read_ctx->iter[1]) == 'i' &&
-					tolower(read_ctx->iter[2]) == 'n' &&
-				!isalnum(read_ctx->iter[3]))
-				{
-					read_ctx->iter += 3;
-					return 0;
-				}
+				read_ctx->iter += 3;
+				return range_max;
+			}
+			if( dl_txt_is_keyword( read_ctx->iter, "min", 3 ) && !isalnum(read_ctx->iter[3]) )
+			{
+				read_ctx->iter += 3;
+				return 0;
 			}
 			dl_txt_read_failed( dl_ctx, read_ctx, DL_ERROR_MALFORMED_DATA, "expected a value of type '%s'", type );
 		}
+
+		v = u.value;
+		if( u.was_overflow )
+			dl_txt_read_failed( dl_ctx, read_ctx, DL_ERROR_TXT_RANGE_ERROR, "expected a value of type '%s', %llu is out of range.", type, v );
 	}
 
-	if( v > range_max || errno == ERANGE )
+	if( v > range_max )
 		dl_txt_read_failed( dl_ctx, read_ctx, DL_ERROR_TXT_RANGE_ERROR, "expected a value of type '%s', %llu is out of range.", type, v );
 	read_ctx->iter = next;
 	return v;
 }
 
-void dl_report_error_location( dl_ctx_t ctx, const char* txt, const char* end, const char* error_pos )
+/**
+ * Description of an ieee754 binary floating point format, used to share the slow paths between fp32 and fp64.
+ */
+struct dl_txt_fp_format
+{
+	int mant_bits; // explicit mantissa bits
+	int exp_bits;
+	int bias;      // exponent of the smallest normal value is bias + 1
+};
+
+static const dl_txt_fp_format DL_TXT_FP32_FORMAT = { 23,  8,  -127 };
+static const dl_txt_fp_format DL_TXT_FP64_FORMAT = { 52, 11, -1023 };
+
+static uint64_t dl_txt_fp_bits_inf( const dl_txt_fp_format* fmt, bool neg )
+{
+	return ( (uint64_t)( ( 1 << fmt->exp_bits ) - 1 ) << fmt->mant_bits ) | ( (uint64_t)neg << ( fmt->mant_bits + fmt->exp_bits ) );
+}
+
+/**
+ * Arbitrary precision decimal used when a value could not be parsed on the fast path. Enough digits are
+ * kept to represent any halfway point between two fp64 values exactly, all digits beyond that is only
+ * recorded as 'truncated'.
+ * Converting a decimal to binary is done by shifting it by powers of 2 until it is in [0.5, 1) and then
+ * extracting the mantissa, this is the algorithm used by strconv in golang.
+ */
+#define DL_TXT_DECIMAL_MAX_DIGITS 800
+#define DL_TXT_DECIMAL_MAX_SHIFT  60
+
+struct dl_txt_decimal
+{
+	uint8_t d[DL_TXT_DECIMAL_MAX_DIGITS]; // digits, 0-9, most significant first
+	int     nd;                           // number of digits used
+	int     dp;                           // position of decimal point
+	bool    trunc;                        // nonzero digits was discarded beyond d[nd]
+};
+
+static void dl_txt_decimal_trim( dl_txt_decimal* a )
 {
-	int line = 1;
+	while( a->nd > 0 && a->d[a->nd - 1] == 0 )
+		--a->nd;
+	if( a->nd == 0 )
+		a->dp = 0;
+}
+
+static void dl_txt_decimal_right_shift( dl_txt_decimal* a, unsigned k )
+{
+	int r = 0;
+	int w = 0;
+	uint64_t n = 0;
+
+	// ... pick up enough leading digits to cover first shift ...
+	for( ; ( n >> k ) == 0; ++r )
+	{
+		if( r >= a->nd )
+		{
+			if( n == 0 )
+			{
+				a->nd = 0;
+				return;
+			}
+			while( ( n >> k ) == 0 )
+			{
+				n *= 10;
+				++r;
+			}
+			break;
+		}
+		n = n * 10 + a->d[r];
+	}
+	a->dp -= r - 1;
+
+	const uint64_t mask = ( (uint64_t)1 << k ) - 1;
+
+	// ... pick up a digit, put down a digit ...
+	for( ; r < a->nd; ++r )
+	{
+		uint64_t c = a->d[r];
+		a->d[w++] = (uint8_t)( n >> k );
+		n = ( n & mask ) * 10 + c;
+	}
+
+	// ... put down extra digits ...
+	while( n > 0 )
+	{
+		uint64_t dig = n >> k;
+		n &= mask;
+		if( w < DL_TXT_DECIMAL_MAX_DIGITS )
+			a->d[w++] = (uint8_t)dig;
+		else if( dig > 0 )
+			a->trunc = true;
+		n *= 10;
+	}
+
+	a->nd = w;
+	dl_txt_decimal_trim( a );
+}
+
+static void dl_txt_decimal_left_shift( dl_txt_decimal* a, unsigned k )
+{
+	// ... a shift by at most DL_TXT_DECIMAL_MAX_SHIFT bits adds at most 19 digits, produce them from the back ...
+	uint8_t res[DL_TXT_DECIMAL_MAX_DIGITS + 20];
+	int w = (int)sizeof(res);
+	uint64_t n = 0;
+	for( int r = a->nd - 1; r >= 0; --r )
+	{
+		n += (uint64_t)a->d[r] << k;
+		uint64_t quo = n / 10;
+		res[--w] = (uint8_t)( n - quo * 10 );
+		n = quo;
+	}
+	while( n > 0 )
+	{
+		uint64_t quo = n / 10;
+		res[--w] = (uint8_t)( n - quo * 10 );
+		n = quo;
+	}
+
+	int nd = (int)sizeof(res) - w;
+	a->dp += nd - a->nd;
+	if( nd > DL_TXT_DECIMAL_MAX_DIGITS )
+	{
+		for( int i = w + DL_TXT_DECIMAL_MAX_DIGITS; i < (int)sizeof(res); ++i )
+			a->trunc |= res[i] != 0;
+		nd = DL_TXT_DECIMAL_MAX_DIGITS;
+	}
+	memcpy( a->d, res + w, (size_t)nd );
+	a->nd = nd;
+	dl_txt_decimal_trim( a );
+}
+
+static void dl_txt_decimal_shift( dl_txt_decimal* a, int k )
+{
+	if( a->nd == 0 )
+		return;
+	for( ; k > DL_TXT_DECIMAL_MAX_SHIFT; k -= DL_TXT_DECIMAL_MAX_SHIFT )
+		dl_txt_decimal_left_shift( a, DL_TXT_DECIMAL_MAX_SHIFT );
+	for( ; k < -DL_TXT_DECIMAL_MAX_SHIFT; k += DL_TXT_DECIMAL_MAX_SHIFT )
+		dl_txt_decimal_right_shift( a, DL_TXT_DECIMAL_MAX_SHIFT );
+	if( k > 0 )
+		dl_txt_decimal_left_shift( a, (unsigned)k );
+	else if( k < 0 )
+		dl_txt_decimal_right_shift( a, (unsigned)-k );
+}
+
+static uint64_t dl_txt_decimal_rounded_integer( const dl_txt_decimal* a )
+{
+	if( a->dp > 20 )
+		return UINT64_MAX;
+
+	uint64_t n = 0;
+	int i = 0;
+	for( ; i < a->dp && i < a->nd; ++i )
+		n = n * 10 + a->d[i];
+	for( ; i < a->dp; ++i )
+		n *= 10;
+
+	// ... round half to even, if anything was truncated we are above half ...
+	bool round_up = false;
+	if( a->dp >= 0 && a->dp < a->nd )
+	{
+		if( a->d[a->dp] == 5 && a->dp + 1 == a->nd )
+			round_up = a->trunc || ( a->dp > 0 && ( a->d[a->dp - 1] & 1 ) );
+		else
+			round_up = a->d[a->dp] >= 5;
+	}
+	return n + round_up;
+}
+
+static uint64_t dl_txt_decimal_to_fp_bits( dl_txt_decimal* d, const dl_txt_fp_format* fmt, bool neg )
+{
+	static const int POWTAB[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+	const int max_exp = ( 1 << fmt->exp_bits ) - 1;
+
+	const uint64_t sign = (uint64_t)neg << ( fmt->mant_bits + fmt->exp_bits );
+
+	if( d->nd == 0 || d->dp < -330 )
+		return sign; // zero
+	if( d->dp > 310 )
+		return dl_txt_fp_bits_inf( fmt, neg );
+
+	// ... scale by powers of 2 until in [0.5, 1) ...
+	int exp = 0;
+	while( d->dp > 0 )
+	{
+		int n = d->dp >= (int)DL_ARRAY_LENGTH( POWTAB ) ? 27 : POWTAB[d->dp];
+		dl_txt_decimal_shift( d, -n );
+		exp += n;
+	}
+	while( d->dp < 0 || ( d->dp == 0 && d->d[0] < 5 ) )
+	{
+		int n = -d->dp >= (int)DL_ARRAY_LENGTH( POWTAB ) ? 27 : POWTAB[-d->dp];
+		dl_txt_decimal_shift( d, n );
+		exp -= n;
+	}
+
+	// ... range is [0.5, 1) but fp is [1, 2) ...
+	--exp;
+
+	// ... below smallest normal exponent, denormalize ...
+	if( exp < fmt->bias + 1 )
+	{
+		int n = fmt->bias + 1 - exp;
+		dl_txt_decimal_shift( d, -n );
+		exp += n;
+	}
+
+	if( exp - fmt->bias >= max_exp )
+		return dl_txt_fp_bits_inf( fmt, neg );
+
+	dl_txt_decimal_shift( d, 1 + fmt->mant_bits );
+	uint64_t mant = dl_txt_decimal_rounded_integer( d );
+
+	// ... rounding might have added a bit ...
+	if( mant == (uint64_t)2 << fmt->mant_bits )
+	{
+		mant >>= 1;
+		++exp;
+		if( exp - fmt->bias >= max_exp )
+			return dl_txt_fp_bits_inf( fmt, neg );
+	}
+
+	// ... denormal? ...
+	if( ( mant & ( (uint64_t)1 << fmt->mant_bits ) ) == 0 )
+		exp = fmt->bias;
+
+	return sign | ( (uint64_t)( exp - fmt->bias ) << fmt->mant_bits ) | ( mant & ( ( (uint64_t)1 << fmt->mant_bits ) - 1 ) );
+}
+
+/**
+ * Slow path for decimal values, str points to the first digit or '.' of the mantissa and exp10 is the value
+ * of the exponent-part.
+ */
+static uint64_t dl_txt_parse_decimal_slow( const char* str, int exp10, const dl_txt_fp_format* fmt, bool neg )
+{
+	dl_txt_decimal d;
+	d.nd    = 0;
+	d.dp    = 0;
+	d.trunc = false;
+
+	bool saw_dot = false;
+	for( ;; ++str )
+	{
+		if( *str == '.' )
+		{
+			if( saw_dot )
+				break;
+			saw_dot = true;
+			d.dp = d.nd;
+			continue;
+		}
+		if( *str < '0' || *str > '9' )
+			break;
+
+		if( *str == '0' && d.nd == 0 )
+		{
+			// ... leading zeros ...
+			--d.dp;
+			continue;
+		}
+		if( d.nd < DL_TXT_DECIMAL_MAX_DIGITS )
+			d.d[d.nd++] = (uint8_t)( *str - '0' );
+		else if( *str != '0' )
+			d.trunc = true;
+	}
+	if( !saw_dot )
+		d.dp = d.nd;
+	d.dp += exp10;
+
+	return dl_txt_decimal_to_fp_bits( &d, fmt, neg );
+}
+
+/**
+ * Round mant * 2^exp2 to fmt, sticky should be set if nonzero bits was lost below mant.
+ */
+static uint64_t dl_txt_binary_to_fp_bits( uint64_t mant, int exp2, bool sticky, const dl_txt_fp_format* fmt, bool neg )
+{
+	const uint64_t sign = (uint64_t)neg << ( fmt->mant_bits + fmt->exp_bits );
+	if( mant == 0 )
+		return sign;
+
+	// ... normalize so that mant is in [2^63, 2^64) ...
+	while( ( mant & ( (uint64_t)1 << 63 ) ) == 0 )
+	{
+		mant <<= 1;
+		--exp2;
+	}
+
+	int e       = exp2 + 63; // value is 1.xxx * 2^e
+	int min_exp = fmt->bias + 1;
+	int shift   = 63 - fmt->mant_bits;
+	if( e > -fmt->bias )
+		return dl_txt_fp_bits_inf( fmt, neg );
+	if( e < min_exp )
+	{
+		// ... denormal, drop more bits ...
+		shift += min_exp - e;
+		e = min_exp;
+		if( shift > 64 )
+			return sign; // less than half of the smallest denormal
+	}
+
+	uint64_t q    = shift < 64 ? mant >> shift : 0;
+	uint64_t rem  = shift < 64 ? mant & ( ( (uint64_t)1 << shift ) - 1 ) : mant;
+	uint64_t half = (uint64_t)1 << ( shift - 1 );
+	if( rem > half || ( rem == half && ( sticky || ( q & 1 ) ) ) )
+		++q;
+
+	if( q == (uint64_t)2 << fmt->mant_bits )
+	{
+		q >>= 1;
+		if( ++e > -fmt->bias )
+			return dl_txt_fp_bits_inf( fmt, neg );
+	}
+
+	uint64_t biased_exp = ( q & ( (uint64_t)1 << fmt->mant_bits ) ) ? (uint64_t)( e - fmt->bias ) : 0;
+	return sign | ( biased_exp << fmt->mant_bits ) | ( q & ( ( (uint64_t)1 << fmt->mant_bits ) - 1 ) );
+}
+
+static const char* dl_txt_parse_exponent( const char* str, char marker, int* exp )
+{
+	*exp = 0;
+	if( ( *str | 0x20 ) != marker )
+		return str;
+
+	const char* iter = str + 1;
+	bool neg = false;
+	if( *iter == '-' || *iter == '+' )
+		neg = *iter++ == '-';
+
+	if( *iter < '0' || *iter > '9' )
+		return str; // 'e' without digits is not part of the number.
+
+	int e = 0;
+	for( ; *iter >= '0' && *iter <= '9'; ++iter )
+		if( e < 100000 )
+			e = e * 10 + ( *iter - '0' );
+	*exp = neg ? -e : e;
+	return iter;
+}
+
+static const char* dl_txt_parse_hex_fp( const char* str, const dl_txt_fp_format* fmt, bool neg, uint64_t* out_bits )
+{
+	const char* iter = str;
+	uint64_t mant   = 0;
+	int      exp2   = 0;
+	int      digits = 0;
+	bool     sticky = false;
+	bool     any    = false;
+
+	while( *iter == '0' )
+	{
+		++iter;
+		any = true;
+	}
+	for( unsigned d; ( d = dl_txt_digit_value( *iter, 16 ) ) < 16; ++iter )
+	{
+		any = true;
+		if( digits < 16 )
+		{
+			mant = ( mant << 4 ) | d;
+			++digits;
+		}
+		else
+		{
+			exp2 += 4;
+			sticky |= d != 0;
+		}
+	}
+	if( *iter == '.' )
+	{
+		++iter;
+		if( digits == 0 )
+		{
+			for( ; *iter == '0'; ++iter )
+			{
+				exp2 -= 4;
+				any = true;
+			}
+		}
+		for( unsigned d; ( d = dl_txt_digit_value( *iter, 16 ) ) < 16; ++iter )
+		{
+			any = true;
+			if( digits < 16 )
+			{
+				mant = ( mant << 4 ) | d;
+				exp2 -= 4;
+				++digits;
+			}
+			else
+				sticky |= d != 0;
+		}
+	}
+	if( !any )
+		return str;
+
+	int p = 0;
+	iter = dl_txt_parse_exponent( iter, 'p', &p );
+	*out_bits = dl_txt_binary_to_fp_bits( mant, exp2 + p, sticky, fmt, neg );
+	return iter;
+}
+
+#if defined( FLT_EVAL_METHOD ) && ( FLT_EVAL_METHOD < 0 || FLT_EVAL_METHOD > 1 )
+	// ... fp64 math is done in higher precision, i.e. x87, the fast path would round twice ...
+#  define DL_TXT_FP_FAST_PATH 0
+#else
+#  define DL_TXT_FP_FAST_PATH 1
+#endif
+
+struct dl_txt_fp
+{
+	const char* next;       // first character after value, same as input if no value could be parsed.
+	bool        was_fast;   // value was calculated on the fast path and is stored in fast, otherwise in bits.
+	double      fast;
+	uint64_t    bits;       // value encoded in the requested dl_txt_fp_format.
+	bool        neg;
+	const char* mant_start; // first character of decimal mantissa.
+	int         exp_part;   // value of decimal exponent-part.
+};
+
+/**
+ * Parse a floating point value with the syntax of strtod(), i.e. decimal or hex with optional exponent,
+ * inf, infinity and nan, but always with '.' as decimal separator. Also accept min and max.
+ *
+ * Decimal values with at most 19 significant digits that, together with their exponent, is exactly
+ * representable as fp64-operations are calculated directly (Clinger's fast path), all other values goes
+ * through a slow but exact path. Result is always correctly rounded to fmt.
+ *
+ * mant_start and exp_part is set for decimal values so that a result from the fast path can be recalculated
+ * with dl_txt_parse_decimal_slow() if needed.
+ */
+static dl_txt_fp dl_txt_parse_fp( const char* str, const dl_txt_fp_format* fmt )
+{
+	static const double POW10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	                                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	dl_txt_fp res;
+	res.next       = str;
+	res.was_fast   = false;
+	res.fast       = 0.0;
+	res.bits       = 0;
+	res.neg        = false;
+	res.mant_start = str;
+	res.exp_part   = 0;
+
+	const char* iter = str;
+	if( *iter == '-' || *iter == '+' )
+		res.neg = *iter++ == '-';
+	const bool neg = res.neg;
+
+	if( iter[0] == '0' && ( iter[1] | 0x20 ) == 'x' )
+	{
+		res.next = dl_txt_parse_hex_fp( iter + 2, fmt, neg, &res.bits );
+		if( res.next != iter + 2 )
+			return res;
+		// ... "0x" without digits is parsed as 0 by strtod() ...
+		res.next = str;
+	}
+
+	res.mant_start = iter;
+	uint64_t mant   = 0;
+	int      digits = 0;
+	int      exp10  = 0;
+	bool     trunc  = false;
+	bool     any    = false;
+
+	while( *iter == '0' )
+	{
+		++iter;
+		any = true;
+	}
+	for( ; *iter >= '0' && *iter <= '9'; ++iter )
+	{
+		any = true;
+		if( digits < 19 )
+		{
+			mant = mant * 10 + (uint64_t)( *iter - '0' );
+			++digits;
+		}
+		else
+		{
+			++exp10;
+			trunc |= *iter != '0';
+		}
+	}
+	if( *iter == '.' )
+	{
+		++iter;
+		if( digits == 0 )
+		{
+			for( ; *iter == '0'; ++iter )
+			{
+				--exp10;
+				any = true;
+			}
+		}
+		for( ; *iter >= '0' && *iter <= '9'; ++iter )
+		{
+			any = true;
+			if( digits < 19 )
+			{
+				mant = mant * 10 + (uint64_t)( *iter - '0' );
+				--exp10;
+				++digits;
+			}
+			else
+				trunc |= *iter != '0';
+		}
+	}
+
+	if( !any )
+	{
+		// ... not a number, check for the special values ...
+		if( dl_txt_is_keyword( iter, "inf", 3 ) )
+		{
+			res.bits = dl_txt_fp_bits_inf( fmt, neg );
+			res.next = iter + ( dl_txt_is_keyword( iter + 3, "inity", 5 ) ? 8 : 3 );
+		}
+		else if( dl_txt_is_keyword( iter, "nan", 3 ) )
+		{
+			// ... quiet nan ...
+			res.bits = dl_txt_fp_bits_inf( fmt, neg ) | ( (uint64_t)1 << ( fmt->mant_bits - 1 ) );
+			res.next = iter + 3;
+			if( *res.next == '(' )
+			{
+				const char* nan_end = res.next + 1;
+				while( isalnum( *nan_end ) || *nan_end == '_' )
+					++nan_end;
+				if( *nan_end == ')' )
+					res.next = nan_end + 1;
+			}
+		}
+		else if( dl_txt_is_keyword( iter, "max", 3 ) && !isalnum( iter[3] ) )
+		{
+			res.bits = dl_txt_fp_bits_inf( fmt, neg ) - 1;
+			res.next = iter + 3;
+		}
+		else if( dl_txt_is_keyword( iter, "min", 3 ) && !isalnum( iter[3] ) )
+		{
+			// ... smallest normal value, as FLT_MIN/DBL_MIN ...
+			res.bits = ( (uint64_t)neg << ( fmt->mant_bits + fmt->exp_bits ) ) | ( (uint64_t)1 << fmt->mant_bits );
+			res.next = iter + 3;
+		}
+		return res;
+	}
+
+	res.next = dl_txt_parse_exponent( iter, 'e', &res.exp_part );
+
+	if( mant == 0 )
+	{
+		res.bits = (uint64_t)neg << ( fmt->mant_bits + fmt->exp_bits );
+		return res;
+	}
+
+	exp10 += res.exp_part;
+	if( DL_TXT_FP_FAST_PATH && !trunc && mant <= ( (uint64_t)1 << 53 ) )
+	{
+		if( exp10 > 22 )
+		{
+			// ... move some of the exponent to the mantissa if it is still exact ...
+			uint64_t m = mant;
+			int      e = exp10;
+			for( ; e > 22 && m <= ( (uint64_t)1 << 53 ) / 10; --e )
+				m *= 10;
+			if( e <= 22 )
+			{
+				mant  = m;
+				exp10 = e;
+			}
+		}
+		if( exp10 >= -22 && exp10 <= 22 )
+		{
+			double v = (double)mant;
+			v = exp10 < 0 ? v / POW10[-exp10] : v * POW10[exp10];
+			res.fast     = neg ? -v : v;
+			res.was_fast = true;
+			return res;
+		}
+	}
+
+	res.bits = dl_txt_parse_decimal_slow( res.mant_start, res.exp_part, fmt, neg );
+	return res;
+}
+
+double dl_txt_parse_fp64( const char* str, const char** next )
+{
+	dl_txt_fp fp = dl_txt_parse_fp( str, &DL_TXT_FP64_FORMAT );
+	*next = fp.next;
+	if( fp.was_fast )
+		return fp.fast;
+
+	double res;
+	memcpy( &res, &fp.bits, sizeof(res) );
+	return res;
+}
+
+float dl_txt_parse_fp32( const char* str, const char** next )
+{
+	dl_txt_fp fp = dl_txt_parse_fp( str, &DL_TXT_FP32_FORMAT );
+	*next = fp.next;
+	if( fp.was_fast )
+	{
+		// fast is correctly rounded to fp64 and converting it to fp32 gives the same result as rounding the exact
+		// value, as long as fast is not exactly halfway between two fp32. Outside of the normal fp32-range or
+		// exactly halfway we recalculate on the slow path.
+		uint64_t fast_bits;
+		memcpy( &fast_bits, &fp.fast, sizeof(fast_bits) );
+		double abs_fast = fp.fast < 0 ? -fp.fast : fp.fast;
+		if( abs_fast >= (double)FLT_MIN && abs_fast <= (double)FLT_MAX && ( fast_bits & 0x1FFFFFFF ) != 0x10000000 )
+			return (float)fp.fast;
+
+		fp.bits = dl_txt_parse_decimal_slow( fp.mant_start, fp.exp_part, &DL_TXT_FP32_FORMAT, fp.neg );
+	}
+
+	uint32_t bits = (uint32_t)fp.bits;
+	float res;
+	memcpy( &res, &bits, sizeof(res) );
+	return res;
+}
+
+/**
+ * Size of the chunks read from a stream, the window of text kept in memory grows beyond this only when it need to
+ * keep text that is skimmed before it is parsed.
+ */
+#define DL_TXT_READ_CHUNK_SIZE ( 64 * 1024 )
+
+bool dl_txt_read_more( dl_txt_read_ctx* readctx )
+{
+	dl_txt_read_stream* stream = readctx->stream;
+	if( stream == 0x0 || stream->eof )
+		return false;
+
+	// ... iter might point to a constant "\0" returned by the skip-functions at the end of the window, nothing more to do in that case ...
+	if( (uintptr_t)readctx->iter < (uintptr_t)stream->buffer || (uintptr_t)readctx->iter > (uintptr_t)readctx->end )
+		return false;
+
+	// ... move what need to be kept to the front of the buffer ...
+	const char* keep = readctx->pin != 0x0 && readctx->pin < readctx->iter ? readctx->pin : readctx->iter;
+	size_t kept     = (size_t)( readctx->end - keep );
+	size_t iter_pos = (size_t)( readctx->iter - keep );
+	size_t pin_pos  = readctx->pin != 0x0 ? (size_t)( readctx->pin - keep ) : 0;
+
+	for( const char* nl = stream->buffer; ( nl = (const char*)memchr( nl, '\n', (size_t)( keep - nl ) ) ) != 0x0; ++nl )
+		++stream->lines_read;
+	memmove( stream->buffer, keep, kept );
+
+	// ... grow so that every read at least double what is kept, that way skimming text that is kept is linear in time ...
+	size_t min_free = kept > DL_TXT_READ_CHUNK_SIZE ? kept : DL_TXT_READ_CHUNK_SIZE;
+	if( stream->buffer_size - kept < min_free )
+	{
+		size_t new_size = kept + min_free;
+		char* new_buffer = (char*)dl_realloc( stream->alloc, stream->buffer, new_size + 1, stream->buffer ? stream->buffer_size + 1 : 0 );
+		if( new_buffer == 0x0 )
+			return false;
+		stream->buffer      = new_buffer;
+		stream->buffer_size = new_size;
+	}
+
+	// ... read_func might return less than asked for, keep reading until a chunk, or what is kept, has been read ...
+	size_t read = 0;
+	while( read < min_free )
+	{
+		size_t chunk = stream->read_func( stream->buffer + kept + read, stream->buffer_size - kept - read, stream->read_func_ctx );
+		if( chunk == 0 )
+		{
+			stream->eof = true;
+			break;
+		}
+		read += chunk;
+	}
+
+	readctx->start = stream->buffer;
+	readctx->end   = stream->buffer + kept + read;
+	readctx->iter  = stream->buffer + iter_pos;
+	if( readctx->pin != 0x0 )
+		readctx->pin = stream->buffer + pin_pos;
+	stream->buffer[kept + read] = '\0';
+	return read > 0;
+}
+
+void dl_txt_eat_white_stream( dl_txt_read_ctx* readctx )
+{
+	while( true )
+	{
+		// ... step over plain whitespace first so that it is not kept when reading more ...
+		readctx->iter = dl_txt_skip_space( readctx->iter, readctx->end );
+		if( readctx->end - readctx->iter < DL_TXT_READ_LOOKAHEAD && dl_txt_read_more( readctx ) )
+			continue;
+
+		const char* next = dl_txt_skip_white( readctx->iter, readctx->end );
+		if( next == readctx->iter )
+			return;
+
+		if( *next != '\0' )
+		{
+			// ... stepped over a comment, make sure that there is enough lookahead after it as well ...
+			readctx->iter = next;
+			continue;
+		}
+
+		// ... a comment continues past the end of the window ...
+		if( !dl_txt_read_more( readctx ) )
+		{
+			readctx->iter = next;
+			return;
+		}
+	}
+}
+
+void dl_report_error_location( dl_ctx_t ctx, const dl_txt_read_ctx* readctx )
+{
+	const char* txt       = readctx->start;
+	const char* end       = readctx->end;
+	const char* error_pos = readctx->iter;
+	int line = readctx->stream ? readctx->stream->lines_read + 1 : 1;
 	int col = 1;
 	const char* last_line = txt;
 	const char* iter = txt;
@@ -194,3 +976,65 @@ void dl_report_error_location( dl_ctx_t ctx, const char* txt, const char* end, c
 		dl_log_error( ctx, "at line %d, col %d:\n%.*s\n%*c^", line, col, (int)(line_end-last_line), last_line, col, ' ');
 	}
 }
+
+// value of each char in base64, 255 for chars that are not part of base64.
+static const uint8_t DL_TXT_BASE64_VALUES[256] =
+{
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255, 255, 255,  63,
+	 52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+	255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+	 15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255, 255,
+	255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+	 41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+
+size_t dl_txt_parse_base64( const char* str, size_t len, uint8_t* out )
+{
+	if( len % 4 != 0 )
+		return (size_t)-1;
+	if( len == 0 )
+		return 0;
+
+	const uint8_t* in  = (const uint8_t*)str;
+	uint8_t*       dst = out;
+
+	// ... all but the last 4 chars can be decoded without looking for padding ...
+	const uint8_t* last = in + len - 4;
+	for( ; in != last; in += 4 )
+	{
+		uint32_t a = DL_TXT_BASE64_VALUES[in[0]];
+		uint32_t b = DL_TXT_BASE64_VALUES[in[1]];
+		uint32_t c = DL_TXT_BASE64_VALUES[in[2]];
+		uint32_t d = DL_TXT_BASE64_VALUES[in[3]];
+		if( ( a | b | c | d ) & 0x80 )
+			return (size_t)-1;
+		uint32_t v = a << 18 | b << 12 | c << 6 | d;
+		dst[0] = (uint8_t)( v >> 16 );
+		dst[1] = (uint8_t)( v >> 8 );
+		dst[2] = (uint8_t)v;
+		dst += 3;
+	}
+
+	int pad = in[3] != '=' ? 0 : ( in[2] != '=' ? 1 : 2 );
+	uint32_t a = DL_TXT_BASE64_VALUES[in[0]];
+	uint32_t b = DL_TXT_BASE64_VALUES[in[1]];
+	uint32_t c = pad >= 2 ? 0 : DL_TXT_BASE64_VALUES[in[2]];
+	uint32_t d = pad >= 1 ? 0 : DL_TXT_BASE64_VALUES[in[3]];
+	if( ( a | b | c | d ) & 0x80 )
+		return (size_t)-1;
+	uint32_t v = a << 18 | b << 12 | c << 6 | d;
+	dst[0] = (uint8_t)( v >> 16 );
+	if( pad < 2 ) dst[1] = (uint8_t)( v >> 8 );
+	if( pad < 1 ) dst[2] = (uint8_t)v;
+	return (size_t)( dst - out ) + 3 - (size_t)pad;
+}
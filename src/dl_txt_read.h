@@ -3,7 +3,24 @@
 
 #include <ctype.h>
 #include <setjmp.h>
+#include <string.h>
 #include "dl_types.h"
+#include "dl_txt_scan.h"
+
+/**
+ * State used when the text is read in chunks from a dl_txt_read_func instead of being available in full, only a window
+ * of the text is kept in buffer and more is read by dl_txt_read_more() when the parser reach the end of it.
+ */
+struct dl_txt_read_stream
+{
+	dl_txt_read_func read_func;
+	void*            read_func_ctx;
+	dl_allocator*    alloc;
+	char*            buffer;
+	size_t           buffer_size; ///< allocated size of buffer, excluding the '\0' always kept after the window.
+	int              lines_read;  ///< number of lines dropped from the front of the window, used when reporting errors.
+	bool             eof;
+};
 
 struct dl_txt_read_ctx
 {
@@ -11,9 +28,26 @@ struct dl_txt_read_ctx
 	const char* start;
 	const char* end;
 	const char* iter;
+	const char* pin;              ///< if set, text from pin and forward is kept in the window when reading from a stream.
+	dl_txt_read_stream* stream;   ///< 0x0 if all text is in [start, end).
 	dl_error_t err;
 };
 
+/**
+ * Minimum number of characters available after iter when dl_txt_eat_white() returns, unless at the end of the text.
+ * Tokens, except strings and skipped maps/arrays, have to fit within this when reading from a stream.
+ */
+#define DL_TXT_READ_LOOKAHEAD 1024
+
+/**
+ * Read more text to the window of a stream. The window is moved so that it starts at iter, or pin if that is before
+ * iter, i.e. all pointers into the text except start, end, iter and pin are invalid after a call to this. Returns false if
+ * not reading from a stream or if there is no more text to read.
+ */
+bool dl_txt_read_more( dl_txt_read_ctx* readctx );
+
+void dl_txt_eat_white_stream( dl_txt_read_ctx* readctx );
+
 
 #if defined( __GNUC__ )
 static void dl_txt_read_failed( dl_ctx_t ctx, dl_txt_read_ctx* readctx, dl_error_t err, const char* fmt, ... ) __attribute__((format( printf, 4, 5 )));
@@ -39,31 +73,36 @@ static /*no inline?*/ void dl_txt_read_failed( dl_ctx_t ctx, dl_txt_read_ctx* re
 
 inline const char* dl_txt_skip_white( const char* str, const char* end )
 {
+	// ... most calls are made when already standing on a token, bail out early on those ...
+	if( str != end && !dl_txt_is_space( *str ) && *str != '/' )
+		return str;
+
 	while( true )
 	{
-		while( str != end && isspace(*str) ) ++str;
+		str = dl_txt_skip_space( str, end );
 
 		if( str == end )
 			return "\0";
 
 		if( *str == '/' )
 		{
-			++str;
+			if( ++str == end )
+				return "\0";
 
 			// ... skip comment ...
 			switch( *str )
 			{
 				case '/':
-					while( str != end && *str != '\n' ) ++str;
-					if( str == end )
+					str = (const char*)memchr( str, '\n', (size_t)( end - str ) );
+					if( str == 0x0 )
 						return "\0";
 					break;
 				case '*':
 					++str;
 					while( true )
 					{
-						while( str != end && *str != '*' ) ++str;
-						if( str == end )
+						str = (const char*)memchr( str, '*', (size_t)( end - str ) );
+						if( str == 0x0 )
 							return "\0";
 						++str;
 						if( *str == '/' )
@@ -82,7 +121,10 @@ inline const char* dl_txt_skip_white( const char* str, const char* end )
 
 inline void dl_txt_eat_white( dl_txt_read_ctx* readctx )
 {
-	readctx->iter = dl_txt_skip_white( readctx->iter, readctx->end );
+	if( readctx->stream )
+		dl_txt_eat_white_stream( readctx );
+	else
+		readctx->iter = dl_txt_skip_white( readctx->iter, readctx->end );
 }
 
 static dl_substr dl_txt_eat_string_quote( dl_txt_read_ctx* readctx, char quote )
@@ -93,8 +135,12 @@ static dl_substr dl_txt_eat_string_quote( dl_txt_read_ctx* readctx, char quote )
 
 	const char* key_start = readctx->iter + 1;
 	const char* key_end = key_start;
-	while( *key_end )
+	while( true )
 	{
+		key_end = dl_txt_find_string_special( key_end, readctx->end, quote );
+		if( key_end == readctx->end || *key_end == '\0' )
+			return res;
+
 		if( *key_end == quote )
 		{
 			res.str = key_start;
@@ -103,18 +149,24 @@ static dl_substr dl_txt_eat_string_quote( dl_txt_read_ctx* readctx, char quote )
 			return res;
 		}
 
-		if( *key_end == '\\' )
-			++key_end;
-		++key_end;
+		// ... skip '\' and the escaped char ...
+		key_end += 2;
+		if( key_end > readctx->end )
+			return res;
 	}
-	return res;
 }
 
 static inline dl_substr dl_txt_eat_string( dl_txt_read_ctx* readctx )
 {
-	if(*readctx->iter == '"')
-		return dl_txt_eat_string_quote( readctx, '"' );
-	return dl_txt_eat_string_quote( readctx, '\'' );
+	char quote = *readctx->iter == '"' ? '"' : '\'';
+	while( true )
+	{
+		dl_substr res = dl_txt_eat_string_quote( readctx, quote );
+
+		// ... the string might continue past the end of the window if reading from a stream ...
+		if( res.str != 0x0 || *readctx->iter != quote || !dl_txt_read_more( readctx ) )
+			return res;
+	}
 }
 
 static inline void dl_txt_eat_char( dl_ctx_t dl_ctx, dl_txt_read_ctx* readctx, char expect )
@@ -147,10 +199,32 @@ static inline long dl_txt_eat_bool( dl_txt_read_ctx* packctx )
 	return 2;
 }
 
-void               dl_report_error_location( dl_ctx_t ctx, const char* txt, const char* end, const char* error_pos );
+void               dl_report_error_location( dl_ctx_t ctx, const dl_txt_read_ctx* readctx );
 
 long long          dl_txt_pack_eat_strtoll( dl_ctx_t dl_ctx, dl_txt_read_ctx* read_ctx, long long range_min, long long range_max, const char* type );
 
 unsigned long long dl_txt_pack_eat_strtoull( dl_ctx_t dl_ctx, dl_txt_read_ctx* read_ctx, unsigned long long range_max, const char* type );
 
+/**
+ * Parse a floating point value in the same format as strtod() but independent of locale, also accepts
+ * min and max for the smallest normal and the largest value. Results are correctly rounded.
+ *
+ * @param str string to parse.
+ * @param next set to first character after the parsed value, str if no value could be parsed.
+ */
+double             dl_txt_parse_fp64( const char* str, const char** next );
+
+/**
+ * Same as dl_txt_parse_fp64() but rounded directly to fp32.
+ */
+float              dl_txt_parse_fp32( const char* str, const char** next );
+
+/**
+ * Decode base64 in str, with '='-padding allowed in the last 4 chars, to out that need to hold len / 4 * 3 bytes.
+ *
+ * @param len number of chars in str, need to be a multiple of 4.
+ * @return number of bytes written to out or (size_t)-1 if str is not valid base64.
+ */
+size_t             dl_txt_parse_base64( const char* str, size_t len, uint8_t* out );
+
 #endif // DL_TXT_READ_H_INCLUDED
@@ -0,0 +1,166 @@
+#ifndef DL_TXT_SCAN_H_INCLUDED
+#define DL_TXT_SCAN_H_INCLUDED
+
+#include <string.h>
+#include "dl_types.h"
+
+// ... scanning of DL-JSON text, vectorized with SSE2 or AVX2 when the compiler targets them ...
+#if !defined(DL_TXT_NO_SIMD)
+#  if defined(__AVX2__)
+#    define DL_TXT_AVX2 1
+#  endif
+#  if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#    define DL_TXT_SSE2 1
+#  endif
+#endif
+
+#if defined(DL_TXT_AVX2)
+#  include <immintrin.h>
+#elif defined(DL_TXT_SSE2)
+#  include <emmintrin.h>
+#endif
+
+#if defined(DL_TXT_SSE2) || defined(DL_TXT_AVX2)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+static inline unsigned int dl_txt_ctz( uint32_t mask ) { unsigned long i; _BitScanForward( &i, mask ); return (unsigned int)i; }
+#  else
+static inline unsigned int dl_txt_ctz( uint32_t mask ) { return (unsigned int)__builtin_ctz( mask ); }
+#  endif
+#endif
+
+/**
+ * Return true if c is whitespace as classified by isspace() in the "C" locale.
+ */
+static inline bool dl_txt_is_space( char c )
+{
+	return c == ' ' || (unsigned char)( c - '\t' ) <= (unsigned char)( '\r' - '\t' );
+}
+
+/**
+ * Return true if c need to be escaped when written in a DL-JSON string, i.e. quotes, '\' and control-chars.
+ * Not all control-chars has an escape-sequence, those are written as is.
+ */
+static inline bool dl_txt_needs_escape( char c )
+{
+	return c == '\"' || c == '\'' || c == '\\' || (unsigned char)c < 0x20;
+}
+
+/**
+ * Skip whitespace, but not comments, in [str, end). Returns a pointer to the first non-whitespace char or end.
+ */
+static inline const char* dl_txt_skip_space( const char* str, const char* end )
+{
+#if defined(DL_TXT_AVX2)
+	const __m256i space = _mm256_set1_epi8( ' ' );
+	const __m256i tab   = _mm256_set1_epi8( '\t' );
+	const __m256i ctrl  = _mm256_set1_epi8( '\r' - '\t' );
+	while( end - str >= 32 )
+	{
+		// ... '\t' - '\r' is found by checking that c - '\t' <= '\r' - '\t' as unsigned ...
+		__m256i v  = _mm256_loadu_si256( (const __m256i*)str );
+		__m256i c  = _mm256_sub_epi8( v, tab );
+		__m256i ws = _mm256_or_si256( _mm256_cmpeq_epi8( v, space ), _mm256_cmpeq_epi8( _mm256_min_epu8( c, ctrl ), c ) );
+		uint32_t non_ws = ~(uint32_t)_mm256_movemask_epi8( ws );
+		if( non_ws )
+			return str + dl_txt_ctz( non_ws );
+		str += 32;
+	}
+#elif defined(DL_TXT_SSE2)
+	const __m128i space = _mm_set1_epi8( ' ' );
+	const __m128i tab   = _mm_set1_epi8( '\t' );
+	const __m128i ctrl  = _mm_set1_epi8( '\r' - '\t' );
+	while( end - str >= 16 )
+	{
+		// ... '\t' - '\r' is found by checking that c - '\t' <= '\r' - '\t' as unsigned ...
+		__m128i v  = _mm_loadu_si128( (const __m128i*)str );
+		__m128i c  = _mm_sub_epi8( v, tab );
+		__m128i ws = _mm_or_si128( _mm_cmpeq_epi8( v, space ), _mm_cmpeq_epi8( _mm_min_epu8( c, ctrl ), c ) );
+		uint32_t non_ws = ~(uint32_t)_mm_movemask_epi8( ws ) & 0xFFFF;
+		if( non_ws )
+			return str + dl_txt_ctz( non_ws );
+		str += 16;
+	}
+#endif
+	while( str != end && dl_txt_is_space( *str ) ) ++str;
+	return str;
+}
+
+/**
+ * Find the first quote, '\' or '\0' in [str, end), i.e. the first char in a quoted string that is not just string
+ * content. Returns end if there is none.
+ */
+static inline const char* dl_txt_find_string_special( const char* str, const char* end, char quote )
+{
+#if defined(DL_TXT_AVX2)
+	const __m256i q    = _mm256_set1_epi8( quote );
+	const __m256i bs   = _mm256_set1_epi8( '\\' );
+	const __m256i zero = _mm256_setzero_si256();
+	while( end - str >= 32 )
+	{
+		__m256i v = _mm256_loadu_si256( (const __m256i*)str );
+		__m256i special = _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8( v, q ), _mm256_cmpeq_epi8( v, bs ) ), _mm256_cmpeq_epi8( v, zero ) );
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8( special );
+		if( mask )
+			return str + dl_txt_ctz( mask );
+		str += 32;
+	}
+#elif defined(DL_TXT_SSE2)
+	const __m128i q    = _mm_set1_epi8( quote );
+	const __m128i bs   = _mm_set1_epi8( '\\' );
+	const __m128i zero = _mm_setzero_si128();
+	while( end - str >= 16 )
+	{
+		__m128i v = _mm_loadu_si128( (const __m128i*)str );
+		__m128i special = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, q ), _mm_cmpeq_epi8( v, bs ) ), _mm_cmpeq_epi8( v, zero ) );
+		uint32_t mask = (uint32_t)_mm_movemask_epi8( special );
+		if( mask )
+			return str + dl_txt_ctz( mask );
+		str += 16;
+	}
+#endif
+	while( str != end && *str != quote && *str != '\\' && *str != '\0' ) ++str;
+	return str;
+}
+
+/**
+ * Find the first char in [str, end) that dl_txt_needs_escape(). Returns end if there is none.
+ */
+static inline const char* dl_txt_find_escape( const char* str, const char* end )
+{
+#if defined(DL_TXT_AVX2)
+	const __m256i dq   = _mm256_set1_epi8( '\"' );
+	const __m256i sq   = _mm256_set1_epi8( '\'' );
+	const __m256i bs   = _mm256_set1_epi8( '\\' );
+	const __m256i ctrl = _mm256_set1_epi8( 0x1F );
+	while( end - str >= 32 )
+	{
+		__m256i v = _mm256_loadu_si256( (const __m256i*)str );
+		__m256i special = _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8( v, dq ), _mm256_cmpeq_epi8( v, sq ) ),
+										   _mm256_or_si256( _mm256_cmpeq_epi8( v, bs ), _mm256_cmpeq_epi8( _mm256_min_epu8( v, ctrl ), v ) ) );
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8( special );
+		if( mask )
+			return str + dl_txt_ctz( mask );
+		str += 32;
+	}
+#elif defined(DL_TXT_SSE2)
+	const __m128i dq   = _mm_set1_epi8( '\"' );
+	const __m128i sq   = _mm_set1_epi8( '\'' );
+	const __m128i bs   = _mm_set1_epi8( '\\' );
+	const __m128i ctrl = _mm_set1_epi8( 0x1F );
+	while( end - str >= 16 )
+	{
+		__m128i v = _mm_loadu_si128( (const __m128i*)str );
+		__m128i special = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, dq ), _mm_cmpeq_epi8( v, sq ) ),
+										_mm_or_si128( _mm_cmpeq_epi8( v, bs ), _mm_cmpeq_epi8( _mm_min_epu8( v, ctrl ), v ) ) );
+		uint32_t mask = (uint32_t)_mm_movemask_epi8( special );
+		if( mask )
+			return str + dl_txt_ctz( mask );
+		str += 16;
+	}
+#endif
+	while( str != end && !dl_txt_needs_escape( *str ) ) ++str;
+	return str;
+}
+
+#endif // DL_TXT_SCAN_H_INCLUDED
@@ -3,39 +3,91 @@
 #include "dl_internal_util.h"
 #include "dl_types.h"
 #include "dl_binary_writer.h"
+#include "dl_txt_write.h"
+#include "dl_txt_scan.h"
+#include "dl_swap.h"
 #include <dl/dl_txt.h>
+#include <dl/dl_txt_gen.h>
 
 struct dl_txt_unpack_ctx
 {
 	explicit dl_txt_unpack_ctx(dl_allocator alloc)
 	    : ptrs(alloc)
+		, ptrs_index(alloc)
 	{
 	}
 
+	// return true if the subdata-instance at offset has already been written.
+	bool HasPtr( uintptr_t offset )
+	{
+		return ptrs_index.Find( dl_internal_hash_pointer( (const void*)offset ), [this, offset]( uint32_t i ) { return ptrs[i].offset == offset; } ) != UINT32_MAX;
+	}
+
+	void AddPtr( uintptr_t offset )
+	{
+		ptrs_index.Insert( dl_internal_hash_pointer( (const void*)offset ), (uint32_t)ptrs.Len() );
+		ptrs.Add( { offset, 0 } );
+	}
+
+	dl_ctx_t dl_ctx;          ///< only used by the dl_txt_gen_unpack_*-functions called from generated code.
+	dl_binary_writer* writer; ///< only used by the dl_txt_gen_unpack_*-functions called from generated code.
 	const uint8_t* packed_instance;
 	size_t packed_instance_size;
 	int indent;
+	int indent_step; ///< spaces added to indent per level, 0 in compact mode.
+	bool compact;    ///< skip all newlines and optional spaces.
+	bool base64;     ///< write arrays of numbers as base64 of the raw elements.
 	struct SPtr
 	{
 		uintptr_t offset;
 		dl_typeid_t tid;
 	};
 	CArrayStatic<SPtr, 256> ptrs;
+	CHashIndexStatic<256>   ptrs_index;
 	bool has_ptrs;
 };
 
 static void dl_txt_unpack_write_indent( dl_binary_writer* writer, dl_txt_unpack_ctx* unpack_ctx )
 {
-	for( int i = 0; i < unpack_ctx->indent; ++i )
-		dl_binary_writer_write_uint8( writer, ' ' );
+	static const char SPACES[] = "                                ";
+	for( int left = unpack_ctx->indent; left > 0; left -= (int)sizeof(SPACES) - 1 )
+		dl_binary_writer_write( writer, SPACES, left < (int)sizeof(SPACES) - 1 ? (size_t)left : sizeof(SPACES) - 1 );
+}
+
+static void dl_txt_unpack_write_newline( dl_binary_writer* writer, dl_txt_unpack_ctx* unpack_ctx )
+{
+	if( !unpack_ctx->compact )
+		dl_binary_writer_write_uint8( writer, '\n' );
+}
+
+// separator between elements in an array.
+static void dl_txt_unpack_write_separator( dl_binary_writer* writer, dl_txt_unpack_ctx* unpack_ctx )
+{
+	dl_binary_writer_write( writer, ", ", unpack_ctx->compact ? 1 : 2 );
+}
+
+// separator between key and value in a map.
+static void dl_txt_unpack_write_key_separator( dl_binary_writer* writer, dl_txt_unpack_ctx* unpack_ctx )
+{
+	if( unpack_ctx->compact )
+		dl_binary_writer_write_uint8( writer, ':' );
+	else
+		dl_binary_writer_write( writer, " : ", 3 );
 }
 
 static void dl_txt_unpack_write_string( dl_binary_writer* writer, const char* str )
 {
 	dl_binary_writer_write_uint8( writer, '\"' );
-	while( *str )
+	const char* end = str + strlen( str );
+	while( true )
 	{
-		switch( *str )
+		// ... copy everything up to the next char that need escaping in one go ...
+		const char* esc = dl_txt_find_escape( str, end );
+		dl_binary_writer_write( writer, str, (size_t)( esc - str ) );
+		if( esc == end )
+			break;
+
+		switch( *esc )
 		{
 			case '\'': dl_binary_writer_write( writer, "\\\'", 2 ); break;
 			case '\"': dl_binary_writer_write( writer, "\\\"", 2 ); break;
@@ -45,11 +97,10 @@ static void dl_txt_unpack_write_string( dl_binary_writer* writer, const char* st
 			case '\t': dl_binary_writer_write( writer, "\\t", 2 ); break;
 			case '\b': dl_binary_writer_write( writer, "\\b", 2 ); break;
 			case '\f': dl_binary_writer_write( writer, "\\f", 2 ); break;
-			break;
 			default:
-				dl_binary_writer_write_uint8( writer, (uint8_t)*str );
+				dl_binary_writer_write_uint8( writer, (uint8_t)*esc );
 		}
-		++str;
+		str = esc + 1;
 	}
 	dl_binary_writer_write_uint8( writer, '\"' );
 }
@@ -62,77 +113,39 @@ static void dl_txt_unpack_write_string_or_null( dl_binary_writer* writer, dl_txt
 		dl_txt_unpack_write_string( writer, (const char*)&unpack_ctx->packed_instance[offset] );
 }
 
-static void dl_txt_unpack_int8( dl_binary_writer* writer, int8_t data )
-{
-	char buffer[256];
-	int len = dl_internal_str_format( buffer, sizeof(buffer), "%d", data );
-	dl_binary_writer_write( writer, buffer, (size_t)len );
-}
-
-static void dl_txt_unpack_int16( dl_binary_writer* writer, int16_t data )
-{
-	char buffer[256];
-	int len = dl_internal_str_format( buffer, sizeof(buffer), "%d", data );
-	dl_binary_writer_write( writer, buffer, (size_t)len );
-}
-
-static void dl_txt_unpack_int32( dl_binary_writer* writer, int32_t data )
-{
-	char buffer[256];
-	int len = dl_internal_str_format( buffer, sizeof(buffer), "%d", data );
-	dl_binary_writer_write( writer, buffer, (size_t)len );
-}
-
 static void dl_txt_unpack_int64( dl_binary_writer* writer, int64_t data )
 {
-	char buffer[256];
-	int len = dl_internal_str_format( buffer, sizeof(buffer), DL_INT64_FMT_STR, data );
-	dl_binary_writer_write( writer, buffer, (size_t)len );
-}
-
-static void dl_txt_unpack_uint8( dl_binary_writer* writer, uint8_t data )
-{
-	char buffer[256];
-	int len = dl_internal_str_format( buffer, sizeof(buffer), "%u", data );
-	dl_binary_writer_write( writer, buffer, (size_t)len );
+	char buffer[DL_TXT_FORMAT_MAX_LEN];
+	dl_binary_writer_write( writer, buffer, (size_t)dl_txt_format_int64( buffer, data ) );
 }
 
-static void dl_txt_unpack_uint16( dl_binary_writer* writer, uint16_t data )
-{
-	char buffer[256];
-	int len = dl_internal_str_format( buffer, sizeof(buffer), "%u", data );
-	dl_binary_writer_write( writer, buffer, (size_t)len );
-}
-
-static void dl_txt_unpack_uint32( dl_binary_writer* writer, uint32_t data )
-{
-	char buffer[256];
-	int len = dl_internal_str_format( buffer, sizeof(buffer), "%u", data );
-	dl_binary_writer_write( writer, buffer, (size_t)len );
-}
+static void dl_txt_unpack_int8 ( dl_binary_writer* writer, int8_t  data ) { dl_txt_unpack_int64( writer, data ); }
+static void dl_txt_unpack_int16( dl_binary_writer* writer, int16_t data ) { dl_txt_unpack_int64( writer, data ); }
+static void dl_txt_unpack_int32( dl_binary_writer* writer, int32_t data ) { dl_txt_unpack_int64( writer, data ); }
 
 static void dl_txt_unpack_uint64( dl_binary_writer* writer, const uint64_t data )
 {
-	char buffer[256];
-	int len = dl_internal_str_format( buffer, sizeof(buffer), DL_UINT64_FMT_STR, data );
-	dl_binary_writer_write( writer, buffer, (size_t)len );
+	char buffer[DL_TXT_FORMAT_MAX_LEN];
+	dl_binary_writer_write( writer, buffer, (size_t)dl_txt_format_uint64( buffer, data ) );
 }
 
-// Writing fp32/fp64 with %.9g/%.17g for full "round-tripabillity", see
-// https://randomascii.wordpress.com/2012/03/08/float-precisionfrom-zero-to-100-digits-2/
+static void dl_txt_unpack_uint8 ( dl_binary_writer* writer, uint8_t  data ) { dl_txt_unpack_uint64( writer, data ); }
+static void dl_txt_unpack_uint16( dl_binary_writer* writer, uint16_t data ) { dl_txt_unpack_uint64( writer, data ); }
+static void dl_txt_unpack_uint32( dl_binary_writer* writer, uint32_t data ) { dl_txt_unpack_uint64( writer, data ); }
+
+// Writing fp32/fp64 as the shortest text that parse back to the same value for full "round-tripabillity"
+// without printing more digits than needed, see dl_txt_format_fp64().
 
 static void dl_txt_unpack_fp32( dl_binary_writer* writer, float data )
 {
-	char buffer[256];
-	int len = dl_internal_str_format( buffer, sizeof(buffer), "%.9g", data );
-	dl_binary_writer_write( writer, buffer, (size_t)len );
+	char buffer[DL_TXT_FORMAT_MAX_LEN];
+	dl_binary_writer_write( writer, buffer, (size_t)dl_txt_format_fp32( buffer, data ) );
 }
 
 static void dl_txt_unpack_fp64( dl_binary_writer* writer, double data )
 {
-	char buffer[256];
-	int len = dl_internal_str_format( buffer, sizeof(buffer), "%.17g", data );
-	dl_binary_writer_write( writer, buffer, (size_t)len );
+	char buffer[DL_TXT_FORMAT_MAX_LEN];
+	dl_binary_writer_write( writer, buffer, (size_t)dl_txt_format_fp64( buffer, data ) );
 }
 
 static void dl_txt_unpack_enum( dl_ctx_t dl_ctx, dl_binary_writer* writer, const dl_enum_desc* e, uint64_t value )
@@ -170,14 +183,53 @@ static void dl_txt_unpack_ptr( dl_binary_writer* writer, uintptr_t offset )
 
 static void dl_txt_unpack_struct( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx, dl_binary_writer* writer, const dl_type_desc* type, const uint8_t* struct_data );
 
+/**
+ * Write array of numbers as { "__base64" : "<base64 of the elements in little endian>" }.
+ */
+static void dl_txt_unpack_base64_array( dl_binary_writer* writer, dl_txt_unpack_ctx* unpack_ctx, const uint8_t* array_data, size_t array_size, size_t elem_size )
+{
+	if( unpack_ctx->compact )
+		dl_binary_writer_write( writer, "{\"__base64\":\"", 13 );
+	else
+		dl_binary_writer_write( writer, "{ \"__base64\" : \"", 16 );
+
+	// ... encode in chunks that are a multiple of all element sizes to be able to swap on big endian hosts ...
+	uint8_t swapped[3 * 1024];
+	char    text[DL_TXT_BASE64_LEN( sizeof(swapped) )];
+	for( size_t i = 0; i < array_size; i += sizeof(swapped) )
+	{
+		size_t chunk_size = array_size - i < sizeof(swapped) ? array_size - i : sizeof(swapped);
+		const uint8_t* chunk = array_data + i;
+		if( DL_ENDIAN_HOST == DL_ENDIAN_BIG )
+		{
+			dl_swap_endian_array( swapped, chunk, chunk_size / elem_size, elem_size );
+			chunk = swapped;
+		}
+		dl_binary_writer_write( writer, text, dl_txt_format_base64( text, chunk, chunk_size ) );
+	}
+
+	if( unpack_ctx->compact )
+		dl_binary_writer_write( writer, "\"}", 2 );
+	else
+		dl_binary_writer_write( writer, "\" }", 3 );
+}
+
 static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
-								 dl_txt_unpack_ctx* unpack_ctx,
-								 dl_binary_writer*  writer,
-								 dl_type_storage_t  storage,
-								 const uint8_t*     array_data,
-								 uint32_t           array_count,
-								 dl_typeid_t        tid )
+								 dl_txt_unpack_ctx*    unpack_ctx,
+								 dl_binary_writer*     writer,
+								 dl_type_storage_t     storage,
+								 const uint8_t*        array_data,
+								 uint32_t              array_count,
+								 const dl_member_desc* member )
 {
+	dl_typeid_t tid = member->type_id;
+
+	if( unpack_ctx->base64 && dl_is_number_storage( storage ) )
+	{
+		dl_txt_unpack_base64_array( writer, unpack_ctx, array_data, array_count * dl_pod_size( storage ), dl_pod_size( storage ) );
+		return;
+	}
+
 	dl_binary_writer_write_uint8( writer, '[' );
 	switch( storage )
 	{
@@ -187,7 +239,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_int8( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_int8( writer, mem[array_count - 1] );
 		}
@@ -198,7 +250,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_int16( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_int16( writer, mem[array_count - 1] );
 		}
@@ -209,7 +261,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_int32( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_int32( writer, mem[array_count - 1] );
 		}
@@ -220,7 +272,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_int64( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_int64( writer, mem[array_count - 1] );
 		}
@@ -231,7 +283,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_uint8( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_uint8( writer, mem[array_count - 1] );
 		}
@@ -242,7 +294,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_uint16( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_uint16( writer, mem[array_count - 1] );
 		}
@@ -253,7 +305,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_uint32( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_uint32( writer, mem[array_count - 1] );
 		}
@@ -264,7 +316,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_uint64( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_uint64( writer, mem[array_count - 1] );
 		}
@@ -275,7 +327,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_fp32( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_fp32( writer, mem[array_count - 1] );
 		}
@@ -286,7 +338,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_fp64( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_fp64( writer, mem[array_count - 1] );
 		}
@@ -297,7 +349,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_write_string_or_null( writer, unpack_ctx, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_write_string_or_null( writer, unpack_ctx, mem[array_count - 1] );
 		}
@@ -308,7 +360,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_ptr( writer, mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 			}
 			dl_txt_unpack_ptr( writer, mem[array_count - 1] );
 			unpack_ctx->has_ptrs = true;
@@ -316,18 +368,18 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 		}
 		case DL_TYPE_STORAGE_STRUCT:
 		{
-			dl_binary_writer_write( writer, "\n", 1 );
+			dl_txt_unpack_write_newline( writer, unpack_ctx );
 			dl_txt_unpack_write_indent( writer, unpack_ctx );
-			unpack_ctx->indent += 2;
-			const dl_type_desc* type = dl_internal_find_type( dl_ctx, tid );
+			unpack_ctx->indent += unpack_ctx->indent_step;
+			const dl_type_desc* type = dl_internal_member_sub_type( dl_ctx, member );
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_struct( dl_ctx, unpack_ctx, writer, type, array_data + i * type->size[DL_PTR_SIZE_HOST] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 
 			}
 			dl_txt_unpack_struct( dl_ctx, unpack_ctx, writer, type, array_data + (array_count - 1) * type->size[DL_PTR_SIZE_HOST] );
-			unpack_ctx->indent -= 2;
+			unpack_ctx->indent -= unpack_ctx->indent_step;
 			break;
 		}
 		case DL_TYPE_STORAGE_ENUM_INT8:
@@ -339,7 +391,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 
 			}
 			dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[array_count - 1] );
@@ -354,7 +406,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 
 			}
 			dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[array_count - 1] );
@@ -369,7 +421,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 
 			}
 			dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[array_count - 1] );
@@ -384,7 +436,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 
 			}
 			dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[array_count - 1] );
@@ -399,7 +451,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 
 			}
 			dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[array_count - 1] );
@@ -414,7 +466,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 
 			}
 			dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[array_count - 1] );
@@ -429,7 +481,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 
 			}
 			dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[array_count - 1] );
@@ -444,7 +496,7 @@ static void dl_txt_unpack_array( dl_ctx_t dl_ctx,
 			for( uint32_t i = 0; i < array_count - 1; ++i )
 			{
 				dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[i] );
-				dl_binary_writer_write( writer, ", ", 2 );
+				dl_txt_unpack_write_separator( writer, unpack_ctx );
 
 			}
 			dl_txt_unpack_enum( dl_ctx, writer, e, (uint64_t)mem[array_count - 1] );
@@ -460,7 +512,7 @@ static void dl_txt_unpack_member( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx
 {
 	dl_txt_unpack_write_indent( writer, unpack_ctx );
 	dl_txt_unpack_write_string( writer, dl_internal_member_name( dl_ctx, member ) );
-	dl_binary_writer_write( writer, " : ", 3 );
+	dl_txt_unpack_write_key_separator( writer, unpack_ctx );
 
 	switch( member->AtomType() )
 	{
@@ -493,7 +545,7 @@ static void dl_txt_unpack_member( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx
 					unpack_ctx->has_ptrs = true;
 				}
 				break;
-				case DL_TYPE_STORAGE_STRUCT: dl_txt_unpack_struct( dl_ctx, unpack_ctx, writer, dl_internal_find_type( dl_ctx, member->type_id ), member_data ); break;
+				case DL_TYPE_STORAGE_STRUCT: dl_txt_unpack_struct( dl_ctx, unpack_ctx, writer, dl_internal_member_sub_type( dl_ctx, member ), member_data ); break;
 				default:
 					DL_ASSERT(false);
 			}
@@ -506,11 +558,11 @@ static void dl_txt_unpack_member( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx
 			if( offset == (uintptr_t)-1 )
 				dl_binary_writer_write( writer, "[]", 2 );
 			else
-				dl_txt_unpack_array( dl_ctx, unpack_ctx, writer, member->StorageType(), &unpack_ctx->packed_instance[offset], count, member->type_id );
+				dl_txt_unpack_array( dl_ctx, unpack_ctx, writer, member->StorageType(), &unpack_ctx->packed_instance[offset], count, member );
 		}
 		break;
 		case DL_TYPE_ATOM_INLINE_ARRAY:
-			dl_txt_unpack_array( dl_ctx, unpack_ctx, writer, member->StorageType(), member_data, member->inline_array_cnt(), member->type_id );
+			dl_txt_unpack_array( dl_ctx, unpack_ctx, writer, member->StorageType(), member_data, member->inline_array_cnt(), member );
 		break;
 		case DL_TYPE_ATOM_BITFIELD:
 		{
@@ -550,22 +602,22 @@ static void dl_txt_unpack_write_subdata_ptr( dl_ctx_t            dl_ctx,
 	if( offset == 0 )
 		return;
 
-	for (size_t i = 0; i < unpack_ctx->ptrs.Len(); ++i)
-		if( unpack_ctx->ptrs[i].offset == offset )
-			return;
+	if( unpack_ctx->HasPtr( offset ) )
+		return;
 
-	unpack_ctx->ptrs.Add( { offset, 0 } );
+	unpack_ctx->AddPtr( offset );
 
 	dl_txt_unpack_write_indent( writer, unpack_ctx );
 	dl_txt_unpack_ptr( writer, offset );
-	dl_binary_writer_write( writer, " : ", 3 );
+	dl_txt_unpack_write_key_separator( writer, unpack_ctx );
 
 	DL_ASSERT_MSG(offset < unpack_ctx->packed_instance_size, "Trying to read from offset %d in a buffer of size %d bytes", offset, unpack_ctx->packed_instance_size);
 
 	dl_txt_unpack_struct( dl_ctx, unpack_ctx, writer, sub_type, &unpack_ctx->packed_instance[offset] );
 
 	// TODO: extra , at last elem =/
-	dl_binary_writer_write( writer, ",\n", 2 );
+	dl_binary_writer_write_uint8( writer, ',' );
+	dl_txt_unpack_write_newline( writer, unpack_ctx );
 
 	dl_txt_unpack_write_subdata( dl_ctx, unpack_ctx, writer, sub_type, &unpack_ctx->packed_instance[offset] );
 }
@@ -585,26 +637,26 @@ static void dl_txt_unpack_write_subdata_ptr_array( dl_ctx_t            dl_ctx,
 										 sub_type );
 }
 
-static void dl_txt_unpack_write_member_subdata(dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx, dl_binary_writer* writer, const dl_member_desc* member, const uint8_t* member_data)
+static void dl_txt_unpack_write_member_subdata(dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx, dl_binary_writer* writer, const dl_type_plan_op* op, const uint8_t* member_data)
 {
-	switch( member->AtomType() )
+	const dl_type_desc* subtype = dl_internal_plan_op_sub_type( dl_ctx, op );
+	switch( op->AtomType() )
 	{
 		case DL_TYPE_ATOM_POD:
 		{
-			switch( member->StorageType() )
+			switch( op->StorageType() )
 			{
 				case DL_TYPE_STORAGE_PTR:
 					dl_txt_unpack_write_subdata_ptr( dl_ctx,
 													 unpack_ctx,
 													 writer,
 													 member_data,
-													 dl_internal_find_type( dl_ctx, member->type_id ) );
+													 subtype );
 				break;
 
 				case DL_TYPE_STORAGE_STRUCT:
 				{
-					const dl_type_desc* subtype = dl_internal_find_type( dl_ctx, member->type_id );
-					if( subtype->flags & DL_TYPE_FLAG_HAS_SUBDATA )
+					if( dl_internal_type_hot( dl_ctx, subtype )->flags & DL_TYPE_FLAG_HAS_SUBDATA )
 						dl_txt_unpack_write_subdata( dl_ctx,
 													 unpack_ctx,
 													 writer,
@@ -620,23 +672,23 @@ static void dl_txt_unpack_write_member_subdata(dl_ctx_t dl_ctx, dl_txt_unpack_ct
 		break;
 		case DL_TYPE_ATOM_INLINE_ARRAY:
 		{
-			switch( member->StorageType() )
+			switch( op->StorageType() )
 			{
 				case DL_TYPE_STORAGE_PTR:
 					dl_txt_unpack_write_subdata_ptr_array( dl_ctx,
 														   unpack_ctx,
 														   writer,
 														   member_data,
-														   member->inline_array_cnt(),
-														   dl_internal_find_type( dl_ctx, member->type_id ) );
+														   op->count,
+														   subtype );
 				break;
 				case DL_TYPE_STORAGE_STRUCT:
 				{
-					const dl_type_desc* subtype = dl_internal_find_type( dl_ctx, member->type_id );
-					if( subtype->flags & DL_TYPE_FLAG_HAS_SUBDATA )
+					const dl_type_hot* sub_hot = dl_internal_type_hot( dl_ctx, subtype );
+					if( sub_hot->flags & DL_TYPE_FLAG_HAS_SUBDATA )
 					{
-						for( uint32_t i = 0; i < member->inline_array_cnt(); ++i )
-							dl_txt_unpack_write_subdata( dl_ctx, unpack_ctx, writer, subtype, member_data + i * subtype->size[DL_PTR_SIZE_HOST] );
+						for( uint32_t i = 0; i < op->count; ++i )
+							dl_txt_unpack_write_subdata( dl_ctx, unpack_ctx, writer, subtype, member_data + i * sub_hot->size );
 					}
 				}
 				break;
@@ -648,18 +700,18 @@ static void dl_txt_unpack_write_member_subdata(dl_ctx_t dl_ctx, dl_txt_unpack_ct
 		break;
 		case DL_TYPE_ATOM_ARRAY:
 		{
-			switch( member->StorageType() )
+			switch( op->StorageType() )
 			{
 				case DL_TYPE_STORAGE_STRUCT:
 				{
-					const dl_type_desc* subtype = dl_internal_find_type( dl_ctx, member->type_id );
-					if( subtype->flags & DL_TYPE_FLAG_HAS_SUBDATA )
+					const dl_type_hot* sub_hot = dl_internal_type_hot( dl_ctx, subtype );
+					if( sub_hot->flags & DL_TYPE_FLAG_HAS_SUBDATA )
 					{
 						uintptr_t array_offset = *(uintptr_t*)(member_data);
 						uint32_t  array_count  = *(uint32_t*)(member_data + sizeof(uintptr_t));
 						const uint8_t* array = unpack_ctx->packed_instance + array_offset;
 						for( uint32_t i = 0; i < array_count; ++i )
-							dl_txt_unpack_write_subdata( dl_ctx, unpack_ctx, writer, subtype, array + i * subtype->size[DL_PTR_SIZE_HOST] );
+							dl_txt_unpack_write_subdata( dl_ctx, unpack_ctx, writer, subtype, array + i * sub_hot->size );
 					}
 				}
 				break;
@@ -673,7 +725,7 @@ static void dl_txt_unpack_write_member_subdata(dl_ctx_t dl_ctx, dl_txt_unpack_ct
 														   writer,
 														   array,
 														   array_count,
-														   dl_internal_find_type( dl_ctx, member->type_id ) );
+														   subtype );
 				}
 				break;
 				default:
@@ -690,7 +742,7 @@ static void dl_txt_unpack_write_member_subdata(dl_ctx_t dl_ctx, dl_txt_unpack_ct
 
 static void dl_txt_unpack_write_subdata( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx, dl_binary_writer* writer, const dl_type_desc* type, const uint8_t* struct_data )
 {
-	if (type->flags & DL_TYPE_FLAG_IS_UNION)
+	if (dl_internal_type_hot(dl_ctx, type)->flags & DL_TYPE_FLAG_IS_UNION)
 	{
 		// TODO: check if type is not set at all ...
 		size_t type_offset = dl_internal_union_type_offset(dl_ctx, type, DL_PTR_SIZE_HOST);
@@ -700,23 +752,24 @@ static void dl_txt_unpack_write_subdata( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unp
 		// find member index from union type ...
 		uint32_t union_type = *((uint32_t*)(struct_data + type_offset));
 		const dl_member_desc* member = dl_internal_union_type_to_member(dl_ctx, type, union_type);
-		dl_txt_unpack_write_member_subdata(dl_ctx, unpack_ctx, writer, member, struct_data + member->offset[DL_PTR_SIZE_HOST]);
+		dl_type_plan_op op = dl_internal_plan_op_from_member(dl_ctx, member);
+		dl_txt_unpack_write_member_subdata(dl_ctx, unpack_ctx, writer, &op, struct_data + dl_internal_member_hot(dl_ctx, member)->offset);
 	}
 	else
 	{
-		for (uint32_t member_index = 0; member_index < type->member_count; ++member_index)
-		{
-			const dl_member_desc* member = dl_get_type_member(dl_ctx, type, member_index);
-			dl_txt_unpack_write_member_subdata(dl_ctx, unpack_ctx, writer, member, struct_data + member->offset[DL_PTR_SIZE_HOST]);
-		}
+		const dl_type_plan* plan = dl_internal_type_plan(dl_ctx, type);
+		const dl_type_plan_op* ops = &dl_ctx->plan_ops[plan->op_start];
+		for (uint32_t op_index = 0; op_index < plan->op_count; ++op_index)
+			dl_txt_unpack_write_member_subdata(dl_ctx, unpack_ctx, writer, &ops[op_index], struct_data + ops[op_index].offset[DL_PTR_SIZE_HOST]);
 	}
 }
 
 static void dl_txt_unpack_struct( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx, dl_binary_writer* writer, const dl_type_desc* type, const uint8_t* struct_data )
 {
-	dl_binary_writer_write( writer, "{\n", 2 );
+	dl_binary_writer_write_uint8( writer, '{' );
+	dl_txt_unpack_write_newline( writer, unpack_ctx );
 
-	unpack_ctx->indent += 2;
+	unpack_ctx->indent += unpack_ctx->indent_step;
 	if( type->flags & DL_TYPE_FLAG_IS_UNION )
 	{
 		// TODO: check if type is not set at all ...
@@ -728,18 +781,24 @@ static void dl_txt_unpack_struct( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx
 		uint32_t union_type = *((uint32_t*)(struct_data + type_offset));
 		const dl_member_desc* member = dl_internal_union_type_to_member(dl_ctx, type, union_type);
 		dl_txt_unpack_member( dl_ctx, unpack_ctx, writer, member, struct_data + member->offset[DL_PTR_SIZE_HOST] );
-		dl_binary_writer_write( writer, "\n", 1 );
+		dl_txt_unpack_write_newline( writer, unpack_ctx );
 	}
 	else
 	{
-		for( uint32_t member_index = 0; member_index < type->member_count; ++member_index )
+		// ... use routines generated by dltlc if registered for the type ...
+		const dl_txt_gen_funcs* gen = dl_internal_find_txt_gen( dl_ctx, type );
+		if( gen != 0x0 && gen->unpack != 0x0 )
+			gen->unpack( unpack_ctx, struct_data );
+		else
 		{
-			const dl_member_desc* member = dl_get_type_member( dl_ctx, type, member_index );
-			dl_txt_unpack_member( dl_ctx, unpack_ctx, writer, member, struct_data + member->offset[DL_PTR_SIZE_HOST] );
-			if( member_index < type->member_count - 1 )
-				dl_binary_writer_write( writer, ",\n", 2 );
-			else
-				dl_binary_writer_write( writer, "\n", 1 );
+			for( uint32_t member_index = 0; member_index < type->member_count; ++member_index )
+			{
+				const dl_member_desc* member = dl_get_type_member( dl_ctx, type, member_index );
+				dl_txt_unpack_member( dl_ctx, unpack_ctx, writer, member, struct_data + member->offset[DL_PTR_SIZE_HOST] );
+				if( member_index < type->member_count - 1 )
+					dl_binary_writer_write_uint8( writer, ',' );
+				dl_txt_unpack_write_newline( writer, unpack_ctx );
+			}
 		}
 	}
 
@@ -747,23 +806,27 @@ static void dl_txt_unpack_struct( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx
 	{
 		if( unpack_ctx->has_ptrs )
 		{
-			unpack_ctx->indent += 2;
+			unpack_ctx->indent += unpack_ctx->indent_step;
 
 			dl_txt_unpack_write_indent( writer, unpack_ctx );
-			dl_binary_writer_write( writer, ", \"__subdata\" : {\n", 18 );
+			if( unpack_ctx->compact )
+				dl_binary_writer_write( writer, ",\"__subdata\":{", 14 );
+			else
+				dl_binary_writer_write( writer, ", \"__subdata\" : {\n", 18 );
 
-			unpack_ctx->indent += 2;
+			unpack_ctx->indent += unpack_ctx->indent_step;
 			dl_txt_unpack_write_subdata( dl_ctx, unpack_ctx, writer, type, struct_data );
-			unpack_ctx->indent -= 2;
+			unpack_ctx->indent -= unpack_ctx->indent_step;
 
 			dl_txt_unpack_write_indent( writer, unpack_ctx );
-			dl_binary_writer_write( writer, "}\n", 2 );
+			dl_binary_writer_write_uint8( writer, '}' );
+			dl_txt_unpack_write_newline( writer, unpack_ctx );
 
-			unpack_ctx->indent -= 2;
+			unpack_ctx->indent -= unpack_ctx->indent_step;
 		}
 	}
 
-	unpack_ctx->indent -= 2;
+	unpack_ctx->indent -= unpack_ctx->indent_step;
 
 	dl_txt_unpack_write_indent( writer, unpack_ctx );
 	dl_binary_writer_write_uint8( writer, '}' );
@@ -772,35 +835,61 @@ static void dl_txt_unpack_struct( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx
 static dl_error_t dl_txt_unpack_root( dl_ctx_t dl_ctx, dl_txt_unpack_ctx* unpack_ctx, dl_binary_writer* writer, dl_typeid_t root_type )
 {
 	dl_binary_writer_write_uint8( writer, '{' );
-	dl_binary_writer_write_uint8( writer, '\n' );
+	dl_txt_unpack_write_newline( writer, unpack_ctx );
 
 	const dl_type_desc* type = dl_internal_find_type(dl_ctx, root_type);
 	if( type == 0x0 )
 		return DL_ERROR_TYPE_NOT_FOUND; // could not find root-type!
 
-	unpack_ctx->indent += 2;
+	unpack_ctx->indent += unpack_ctx->indent_step;
 	dl_txt_unpack_write_indent( writer, unpack_ctx );
 	dl_txt_unpack_write_string( writer, dl_internal_type_name( dl_ctx, type ) );
-	dl_binary_writer_write( writer, " : ", 3 );
+	dl_txt_unpack_write_key_separator( writer, unpack_ctx );
 	dl_txt_unpack_struct( dl_ctx, unpack_ctx, writer, type, unpack_ctx->packed_instance );
-	unpack_ctx->indent -= 2;
+	unpack_ctx->indent -= unpack_ctx->indent_step;
 
-	dl_binary_writer_write( writer, "\n}\0", 3 );
+	dl_txt_unpack_write_newline( writer, unpack_ctx );
+	dl_binary_writer_write_uint8( writer, '}' );
 	return DL_ERROR_OK;
 }
 
-dl_error_t dl_txt_unpack( dl_ctx_t dl_ctx,                       dl_typeid_t type,
-                          const unsigned char* packed_instance,  size_t      packed_instance_size,
-                          char*                out_txt_instance, size_t      out_txt_instance_size,
-                          size_t*              produced_bytes )
+static dl_error_t dl_txt_unpack_check_header( dl_typeid_t type, const unsigned char* packed_instance, size_t packed_instance_size )
 {
-	dl_data_header* header = (dl_data_header*)packed_instance;
+	const dl_data_header* header = (const dl_data_header*)packed_instance;
 
 	if( packed_instance_size < sizeof(dl_data_header) ) return DL_ERROR_MALFORMED_DATA;
 	if( header->id == DL_INSTANCE_ID_SWAPED )           return DL_ERROR_ENDIAN_MISMATCH;
 	if( header->id != DL_INSTANCE_ID )                  return DL_ERROR_MALFORMED_DATA;
 	if( header->version != DL_INSTANCE_VERSION)         return DL_ERROR_VERSION_MISMATCH;
 	if( header->root_instance_type != type )            return DL_ERROR_TYPE_MISMATCH;
+	if( header->flags & DL_DATA_HEADER_FLAG_SELF_RELATIVE ) return DL_ERROR_UNSUPPORTED_OPERATION;
+	return DL_ERROR_OK;
+}
+
+static dl_error_t dl_txt_unpack_to_writer( dl_ctx_t dl_ctx, const unsigned char* packed_instance, size_t packed_instance_size, dl_binary_writer* writer )
+{
+	dl_txt_unpack_ctx unpackctx(dl_ctx->alloc);
+	unpackctx.dl_ctx = dl_ctx;
+	unpackctx.writer = writer;
+	unpackctx.packed_instance = packed_instance + sizeof(dl_data_header);
+	unpackctx.packed_instance_size = packed_instance_size;
+	unpackctx.indent = 0;
+	unpackctx.compact = ( dl_ctx->txt_unpack_flags & DL_TXT_UNPACK_FLAG_COMPACT ) != 0;
+	unpackctx.indent_step = unpackctx.compact ? 0 : (int)dl_ctx->txt_unpack_indent;
+	unpackctx.base64 = ( dl_ctx->txt_unpack_flags & DL_TXT_UNPACK_FLAG_BASE64_ARRAYS ) != 0;
+	unpackctx.has_ptrs = false;
+
+	return dl_txt_unpack_root( dl_ctx, &unpackctx, writer, ((const dl_data_header*)packed_instance)->root_instance_type );
+}
+
+dl_error_t dl_txt_unpack( dl_ctx_t dl_ctx,                       dl_typeid_t type,
+                          const unsigned char* packed_instance,  size_t      packed_instance_size,
+                          char*                out_txt_instance, size_t      out_txt_instance_size,
+                          size_t*              produced_bytes )
+{
+	dl_error_t err = dl_txt_unpack_check_header( type, packed_instance, packed_instance_size );
+	if( err != DL_ERROR_OK )
+		return err;
 
 	dl_binary_writer writer;
 	dl_binary_writer_init( &writer,
@@ -811,13 +900,8 @@ dl_error_t dl_txt_unpack( dl_ctx_t dl_ctx,                       dl_typeid_t typ
 						   DL_ENDIAN_HOST,
 						   DL_PTR_SIZE_HOST );
 
-	dl_txt_unpack_ctx unpackctx(dl_ctx->alloc);
-	unpackctx.packed_instance = packed_instance + sizeof(dl_data_header);
-	unpackctx.packed_instance_size = packed_instance_size;
-	unpackctx.indent = 0;
-	unpackctx.has_ptrs = false;
-
-	dl_txt_unpack_root( dl_ctx, &unpackctx, &writer, header->root_instance_type );
+	dl_txt_unpack_to_writer( dl_ctx, packed_instance, packed_instance_size, &writer );
+	dl_binary_writer_write_uint8( &writer, '\0' );
 	if( produced_bytes )
 		*produced_bytes = writer.needed_size;
 
@@ -830,3 +914,89 @@ dl_error_t dl_txt_unpack_calc_size( dl_ctx_t dl_ctx,                           d
 {
 	return dl_txt_unpack( dl_ctx, type, packed_instance, packed_instance_size, 0x0, 0, out_txt_instance_size );
 }
+
+/**
+ * Size of the buffer that text is gathered in before it is passed on to the write_func in dl_txt_unpack_stream().
+ */
+#define DL_TXT_UNPACK_STREAM_CHUNK_SIZE (16 * 1024)
+
+struct dl_txt_unpack_stream_writer
+{
+	dl_txt_write_func write_func;
+	void*             write_ctx;
+};
+
+static void dl_txt_unpack_stream_flush( const uint8_t* data, size_t size, void* flush_ctx )
+{
+	dl_txt_unpack_stream_writer* stream = (dl_txt_unpack_stream_writer*)flush_ctx;
+	stream->write_func( (const char*)data, size, stream->write_ctx );
+}
+
+dl_error_t dl_txt_unpack_stream( dl_ctx_t             dl_ctx,          dl_typeid_t type,
+                                 const unsigned char* packed_instance, size_t      packed_instance_size,
+                                 dl_txt_write_func    write_func,      void*       write_ctx,
+                                 size_t*              produced_bytes )
+{
+	dl_error_t err = dl_txt_unpack_check_header( type, packed_instance, packed_instance_size );
+	if( err != DL_ERROR_OK )
+		return err;
+
+	uint8_t chunk[DL_TXT_UNPACK_STREAM_CHUNK_SIZE];
+	dl_txt_unpack_stream_writer stream = { write_func, write_ctx };
+
+	dl_binary_writer writer;
+	dl_binary_writer_init( &writer, chunk, sizeof(chunk), false, DL_ENDIAN_HOST, DL_ENDIAN_HOST, DL_PTR_SIZE_HOST );
+	dl_binary_writer_init_flush( &writer, dl_txt_unpack_stream_flush, &stream );
+
+	err = dl_txt_unpack_to_writer( dl_ctx, packed_instance, packed_instance_size, &writer );
+	if( err != DL_ERROR_OK )
+		return err;
+
+	dl_binary_writer_flush( &writer );
+	if( produced_bytes )
+		*produced_bytes = writer.flushed;
+
+	return DL_ERROR_OK;
+}
+
+// ... support for unpack-routines generated by dltlc, see dl_txt_gen.h ...
+
+void dl_txt_gen_unpack_key( dl_txt_gen_unpack_t unpack_ctx, const char* key, size_t key_len )
+{
+	dl_txt_unpack_write_indent( unpack_ctx->writer, unpack_ctx );
+	dl_binary_writer_write( unpack_ctx->writer, key, key_len );
+	dl_txt_unpack_write_key_separator( unpack_ctx->writer, unpack_ctx );
+}
+
+void dl_txt_gen_unpack_end_member( dl_txt_gen_unpack_t unpack_ctx, int last )
+{
+	if( !last )
+		dl_binary_writer_write_uint8( unpack_ctx->writer, ',' );
+	dl_txt_unpack_write_newline( unpack_ctx->writer, unpack_ctx );
+}
+
+void dl_txt_gen_unpack_member( dl_txt_gen_unpack_t unpack_ctx, dl_typeid_t type_id, uint32_t member_index, const uint8_t* instance_data )
+{
+	dl_ctx_t dl_ctx = unpack_ctx->dl_ctx;
+	const dl_member_desc* member = dl_get_type_member( dl_ctx, dl_internal_find_type( dl_ctx, type_id ), member_index );
+	dl_txt_unpack_member( dl_ctx, unpack_ctx, unpack_ctx->writer, member, instance_data + member->offset[DL_PTR_SIZE_HOST] );
+}
+
+void dl_txt_gen_unpack_begin_struct( dl_txt_gen_unpack_t unpack_ctx )
+{
+	dl_binary_writer_write_uint8( unpack_ctx->writer, '{' );
+	dl_txt_unpack_write_newline( unpack_ctx->writer, unpack_ctx );
+	unpack_ctx->indent += unpack_ctx->indent_step;
+}
+
+void dl_txt_gen_unpack_end_struct( dl_txt_gen_unpack_t unpack_ctx )
+{
+	unpack_ctx->indent -= unpack_ctx->indent_step;
+	dl_txt_unpack_write_indent( unpack_ctx->writer, unpack_ctx );
+	dl_binary_writer_write_uint8( unpack_ctx->writer, '}' );
+}
+
+void dl_txt_gen_unpack_int64 ( dl_txt_gen_unpack_t unpack_ctx, int64_t  value ) { dl_txt_unpack_int64 ( unpack_ctx->writer, value ); }
+void dl_txt_gen_unpack_uint64( dl_txt_gen_unpack_t unpack_ctx, uint64_t value ) { dl_txt_unpack_uint64( unpack_ctx->writer, value ); }
+void dl_txt_gen_unpack_fp32  ( dl_txt_gen_unpack_t unpack_ctx, float    value ) { dl_txt_unpack_fp32  ( unpack_ctx->writer, value ); }
+void dl_txt_gen_unpack_fp64  ( dl_txt_gen_unpack_t unpack_ctx, double   value ) { dl_txt_unpack_fp64  ( unpack_ctx->writer, value ); }
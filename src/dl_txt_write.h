@@ -0,0 +1,52 @@
+#ifndef DL_TXT_WRITE_H_INCLUDED
+#define DL_TXT_WRITE_H_INCLUDED
+
+#include "dl_types.h"
+
+/**
+ * Size of buffer needed by all dl_txt_format_*-functions, no terminating zero is written.
+ */
+#define DL_TXT_FORMAT_MAX_LEN 32
+
+/**
+ * Write value as decimal text to buffer.
+ *
+ * @return number of chars written.
+ */
+int dl_txt_format_uint64( char* buffer, uint64_t value );
+
+/**
+ * Write value as decimal text, with leading '-' if negative, to buffer.
+ *
+ * @return number of chars written.
+ */
+int dl_txt_format_int64( char* buffer, int64_t value );
+
+/**
+ * Write value as the shortest decimal text that parses back to exactly value, if there are multiple
+ * candidates the one closest to value is used. Values are written in plain notation if the decimal exponent
+ * is in [-4, 17) and in scientific notation otherwise, as printf("%g") does. inf and nan is written as
+ * "inf", "-inf", "nan" and "-nan".
+ *
+ * @return number of chars written.
+ */
+int dl_txt_format_fp64( char* buffer, double value );
+
+/**
+ * Same as dl_txt_format_fp64() but shortest text that parse back to value as fp32.
+ */
+int dl_txt_format_fp32( char* buffer, float value );
+
+/**
+ * Number of chars written by dl_txt_format_base64() for size bytes.
+ */
+#define DL_TXT_BASE64_LEN( size ) ( ( ( size ) + 2 ) / 3 * 4 )
+
+/**
+ * Write size bytes from data as base64, with '='-padding, to buffer that need to hold DL_TXT_BASE64_LEN( size ) chars.
+ *
+ * @return number of chars written.
+ */
+size_t dl_txt_format_base64( char* buffer, const void* data, size_t size );
+
+#endif // DL_TXT_WRITE_H_INCLUDED
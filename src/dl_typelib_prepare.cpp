@@ -0,0 +1,224 @@
+/* copyright (c) 2010 Fredrik Kihlander, see LICENSE for more info */
+
+#include "dl_types.h"
+
+/**
+ * State while compiling walk-plans, ops and copies are appended straight to the arrays in dl_context.
+ */
+struct dl_plan_builder
+{
+	dl_ctx_t ctx;
+	uint32_t op_count;
+	uint32_t op_cap;
+	uint32_t copy_count;
+	uint32_t copy_cap;
+};
+
+template <typename T>
+static T* dl_plan_grow( dl_allocator* alloc, T* ptr, uint32_t* cap )
+{
+	uint32_t new_cap = *cap < 16 ? 16 : *cap * 2;
+	ptr = (T*)dl_realloc( alloc, ptr, new_cap * sizeof(T), *cap * sizeof(T) );
+	*cap = new_cap;
+	return ptr;
+}
+
+static void dl_plan_add_op( dl_plan_builder* builder, dl_type_plan* plan, const dl_member_desc* member, const dl_type_desc* sub_type, const uint32_t* offset )
+{
+	dl_ctx_t ctx = builder->ctx;
+	if( builder->op_count == builder->op_cap )
+		ctx->plan_ops = dl_plan_grow( &ctx->alloc, ctx->plan_ops, &builder->op_cap );
+
+	dl_type_plan_op* op = &ctx->plan_ops[builder->op_count++];
+	op->type      = member->type;
+	op->member    = (uint32_t)( member - ctx->member_descs );
+	op->sub_type  = sub_type == 0x0 ? UINT32_MAX : (uint32_t)( sub_type - ctx->type_descs );
+	op->count     = member->AtomType() == DL_TYPE_ATOM_INLINE_ARRAY ? member->inline_array_cnt() : 1;
+	op->offset[DL_PTR_SIZE_32BIT] = offset[DL_PTR_SIZE_32BIT];
+	op->offset[DL_PTR_SIZE_64BIT] = offset[DL_PTR_SIZE_64BIT];
+	++plan->op_count;
+	plan->ends_with_copy = false;
+}
+
+static void dl_plan_add_copy( dl_plan_builder* builder, dl_type_plan* plan, uint32_t offset, uint32_t size )
+{
+	dl_ctx_t ctx = builder->ctx;
+	plan->ends_with_copy = true;
+
+	// ... merge with the previous copy of the plan if they are adjacent ...
+	if( plan->copy_count > 0 )
+	{
+		dl_type_plan_copy* last = &ctx->plan_copies[builder->copy_count - 1];
+		if( last->offset + last->size == offset )
+		{
+			last->size += size;
+			return;
+		}
+	}
+
+	if( builder->copy_count == builder->copy_cap )
+		ctx->plan_copies = dl_plan_grow( &ctx->alloc, ctx->plan_copies, &builder->copy_cap );
+
+	dl_type_plan_copy* copy = &ctx->plan_copies[builder->copy_count++];
+	copy->offset = offset;
+	copy->size   = size;
+	++plan->copy_count;
+}
+
+/**
+ * Add all members of type, placed at base_offset in the planned type, to plan.
+ */
+static void dl_plan_add_members( dl_plan_builder* builder, dl_type_plan* plan, const dl_type_desc* type, const uint32_t* base_offset )
+{
+	dl_ctx_t ctx = builder->ctx;
+	bool last_was_bitfield = false;
+
+	for( uint32_t member_index = 0; member_index < type->member_count; ++member_index )
+	{
+		const dl_member_desc* member = dl_get_type_member( ctx, type, member_index );
+		dl_type_atom_t    atom_type    = member->AtomType();
+		dl_type_storage_t storage_type = member->StorageType();
+
+		// ... all members of a bitfield-group share the same storage that is copied with the first member ...
+		bool is_bitfield = atom_type == DL_TYPE_ATOM_BITFIELD;
+		if( is_bitfield && last_was_bitfield )
+			continue;
+		last_was_bitfield = is_bitfield;
+
+		uint32_t offset[2] = { base_offset[DL_PTR_SIZE_32BIT] + member->offset[DL_PTR_SIZE_32BIT],
+							   base_offset[DL_PTR_SIZE_64BIT] + member->offset[DL_PTR_SIZE_64BIT] };
+		uint32_t size = member->size[DL_PTR_SIZE_HOST];
+
+		const dl_type_desc* sub_type = 0x0;
+		if( storage_type == DL_TYPE_STORAGE_STRUCT || storage_type == DL_TYPE_STORAGE_PTR )
+			sub_type = dl_internal_member_sub_type( ctx, member );
+
+		switch( atom_type )
+		{
+			case DL_TYPE_ATOM_POD:
+				switch( storage_type )
+				{
+					case DL_TYPE_STORAGE_STR:
+					case DL_TYPE_STORAGE_PTR:
+						dl_plan_add_op( builder, plan, member, sub_type, offset );
+						break;
+					case DL_TYPE_STORAGE_STRUCT:
+						// ... sub-structs without subdata are flattened into this plan, unions need their type to be checked ...
+						if( sub_type != 0x0 && ( sub_type->flags & ( DL_TYPE_FLAG_HAS_SUBDATA | DL_TYPE_FLAG_IS_UNION ) ) == 0 )
+							dl_plan_add_members( builder, plan, sub_type, offset );
+						else
+							dl_plan_add_op( builder, plan, member, sub_type, offset );
+						break;
+					default:
+						dl_plan_add_copy( builder, plan, offset[DL_PTR_SIZE_HOST], size );
+						break;
+				}
+				break;
+			case DL_TYPE_ATOM_INLINE_ARRAY:
+				switch( storage_type )
+				{
+					case DL_TYPE_STORAGE_STR:
+					case DL_TYPE_STORAGE_PTR:
+						dl_plan_add_op( builder, plan, member, sub_type, offset );
+						break;
+					case DL_TYPE_STORAGE_STRUCT:
+						if( sub_type == 0x0 || ( sub_type->flags & DL_TYPE_FLAG_HAS_SUBDATA ) )
+							dl_plan_add_op( builder, plan, member, sub_type, offset );
+						else
+							dl_plan_add_copy( builder, plan, offset[DL_PTR_SIZE_HOST], size );
+						break;
+					default:
+						dl_plan_add_copy( builder, plan, offset[DL_PTR_SIZE_HOST], size );
+						break;
+				}
+				break;
+			case DL_TYPE_ATOM_ARRAY:
+				dl_plan_add_op( builder, plan, member, sub_type, offset );
+				break;
+			case DL_TYPE_ATOM_BITFIELD:
+				dl_plan_add_copy( builder, plan, offset[DL_PTR_SIZE_HOST], size );
+				break;
+			default:
+				DL_ASSERT( false && "Invalid ATOM-type!" );
+				break;
+		}
+	}
+}
+
+static void dl_internal_build_type_plans( dl_ctx_t ctx )
+{
+	dl_free( &ctx->alloc, ctx->type_plans );
+	dl_free( &ctx->alloc, ctx->plan_ops );
+	dl_free( &ctx->alloc, ctx->plan_copies );
+	ctx->type_plans  = (dl_type_plan*)dl_alloc( &ctx->alloc, sizeof( dl_type_plan ) * ( ctx->type_count > 0 ? ctx->type_count : 1 ) );
+	ctx->plan_ops    = 0x0;
+	ctx->plan_copies = 0x0;
+
+	dl_plan_builder builder = { ctx, 0, 0, 0, 0 };
+	for( uint32_t type_index = 0; type_index < ctx->type_count; ++type_index )
+	{
+		const dl_type_desc* type = &ctx->type_descs[type_index];
+		dl_type_plan* plan = &ctx->type_plans[type_index];
+		plan->copy_start = builder.copy_count;
+		plan->copy_count = 0;
+		plan->op_start   = builder.op_count;
+		plan->op_count   = 0;
+		plan->union_type_offset[DL_PTR_SIZE_32BIT] = 0;
+		plan->union_type_offset[DL_PTR_SIZE_64BIT] = 0;
+		plan->ends_with_copy = false;
+
+		if( type->flags & DL_TYPE_FLAG_IS_UNION )
+		{
+			plan->union_type_offset[DL_PTR_SIZE_32BIT] = dl_internal_calc_union_type_offset( ctx, type, DL_PTR_SIZE_32BIT );
+			plan->union_type_offset[DL_PTR_SIZE_64BIT] = dl_internal_calc_union_type_offset( ctx, type, DL_PTR_SIZE_64BIT );
+		}
+		else
+		{
+			const uint32_t base_offset[2] = { 0, 0 };
+			dl_plan_add_members( &builder, plan, type, base_offset );
+		}
+	}
+	ctx->type_plan_count = ctx->type_count;
+}
+
+static void dl_internal_build_hot_descs( dl_ctx_t ctx )
+{
+	ctx->type_hot   = (dl_type_hot*)dl_realloc( &ctx->alloc,
+											   ctx->type_hot,
+											   sizeof( dl_type_hot ) * ( ctx->type_count > 0 ? ctx->type_count : 1 ),
+											   sizeof( dl_type_hot ) * ctx->type_hot_count );
+	ctx->member_hot = (dl_member_hot*)dl_realloc( &ctx->alloc,
+												 ctx->member_hot,
+												 sizeof( dl_member_hot ) * ( ctx->member_count > 0 ? ctx->member_count : 1 ),
+												 sizeof( dl_member_hot ) * ctx->member_hot_count );
+
+	for( uint32_t type_index = 0; type_index < ctx->type_count; ++type_index )
+	{
+		const dl_type_desc* type = &ctx->type_descs[type_index];
+		dl_type_hot*        hot  = &ctx->type_hot[type_index];
+		hot->flags     = type->flags;
+		hot->size      = type->size[DL_PTR_SIZE_HOST];
+		hot->alignment = type->alignment[DL_PTR_SIZE_HOST];
+	}
+
+	// ... resolve all members, sub-types of already resolved members might have been loaded now ...
+	for( uint32_t member_index = 0; member_index < ctx->member_count; ++member_index )
+	{
+		const dl_member_desc* member = &ctx->member_descs[member_index];
+		dl_member_hot*        hot    = &ctx->member_hot[member_index];
+		hot->offset   = member->offset[DL_PTR_SIZE_HOST];
+		hot->size     = member->size[DL_PTR_SIZE_HOST];
+		hot->sub_type = UINT32_MAX;
+		if( member->StorageType() == DL_TYPE_STORAGE_STRUCT || member->StorageType() == DL_TYPE_STORAGE_PTR )
+			hot->sub_type = dl_internal_typeid_lookup_find( &ctx->type_lookup, ctx->type_ids, member->type_id );
+	}
+
+	ctx->type_hot_count   = ctx->type_count;
+	ctx->member_hot_count = ctx->member_count;
+}
+
+void dl_internal_prepare_types( dl_ctx_t ctx )
+{
+	dl_internal_build_hot_descs( ctx );
+	dl_internal_build_type_plans( ctx );
+}
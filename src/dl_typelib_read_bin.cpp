@@ -31,6 +31,7 @@ static void dl_internal_read_typelibrary_header( dl_typelib_header* header, cons
 		header->type_count       = dl_swap_endian_uint32( header->type_count );
 		header->enum_count       = dl_swap_endian_uint32( header->enum_count );
 		header->member_count     = dl_swap_endian_uint32( header->member_count );
+		header->member_lookup_count = dl_swap_endian_uint32( header->member_lookup_count );
 		header->enum_value_count = dl_swap_endian_uint32( header->enum_value_count );
 		header->enum_alias_count = dl_swap_endian_uint32( header->enum_alias_count );
 
@@ -45,6 +46,8 @@ static void dl_endian_swap_type_desc( dl_type_desc* desc )
 	desc->alignment[DL_PTR_SIZE_32BIT] = dl_swap_endian_uint32( desc->alignment[DL_PTR_SIZE_32BIT] );
 	desc->alignment[DL_PTR_SIZE_64BIT] = dl_swap_endian_uint32( desc->alignment[DL_PTR_SIZE_64BIT] );
 	desc->member_count                 = dl_swap_endian_uint32( desc->member_count );
+	desc->member_lookup_start          = dl_swap_endian_uint32( desc->member_lookup_start );
+	desc->member_lookup_cap            = dl_swap_endian_uint32( desc->member_lookup_cap );
 }
 
 static void dl_endian_swap_enum_desc( dl_enum_desc* desc )
@@ -66,6 +69,12 @@ static void dl_endian_swap_member_desc( dl_member_desc* desc )
 	desc->default_value_offset         = dl_swap_endian_uint32( desc->default_value_offset );
 }
 
+static void dl_endian_swap_member_lookup_entry( dl_member_lookup_entry* entry )
+{
+	entry->name_hash    = dl_swap_endian_uint32( entry->name_hash );
+	entry->member_index = dl_swap_endian_uint32( entry->member_index );
+}
+
 static void dl_endian_swap_enum_value_desc( dl_enum_value_desc* desc )
 {
 	desc->value = dl_swap_endian_uint64( desc->value );
@@ -93,7 +102,8 @@ dl_error_t dl_context_load_type_library( dl_ctx_t dl_ctx, const unsigned char* l
 	size_t types_offset            = enums_lookup_offset + sizeof( dl_typeid_t ) * header.enum_count;
 	size_t enums_offset            = types_offset        + sizeof( dl_type_desc ) * header.type_count;
 	size_t members_offset          = enums_offset        + sizeof( dl_enum_desc ) * header.enum_count;
-	size_t enum_values_offset      = members_offset      + sizeof( dl_member_desc ) * header.member_count;
+	size_t member_lookup_offset    = members_offset      + sizeof( dl_member_desc ) * header.member_count;
+	size_t enum_values_offset      = member_lookup_offset + sizeof( dl_member_lookup_entry ) * header.member_lookup_count;
 	size_t enum_aliases_offset     = enum_values_offset  + sizeof( dl_enum_value_desc ) * header.enum_value_count;
 	size_t defaults_offset         = enum_aliases_offset + sizeof( dl_enum_alias_desc ) * header.enum_alias_count;
 	size_t typedata_strings_offset = defaults_offset + header.default_value_size;
@@ -104,6 +114,7 @@ dl_error_t dl_context_load_type_library( dl_ctx_t dl_ctx, const unsigned char* l
 	dl_ctx->enum_ids         = dl_realloc_array( &dl_ctx->alloc, dl_ctx->enum_ids,         dl_ctx->enum_count + header.enum_count,                       dl_ctx->enum_count );
 	dl_ctx->enum_descs       = dl_realloc_array( &dl_ctx->alloc, dl_ctx->enum_descs,       dl_ctx->enum_count + header.enum_count,                       dl_ctx->enum_count );
 	dl_ctx->member_descs     = dl_realloc_array( &dl_ctx->alloc, dl_ctx->member_descs,     dl_ctx->member_count + header.member_count,                   dl_ctx->member_count );
+	dl_ctx->member_lookup    = dl_realloc_array( &dl_ctx->alloc, dl_ctx->member_lookup,    dl_ctx->member_lookup_count + header.member_lookup_count,     dl_ctx->member_lookup_count );
 	dl_ctx->enum_value_descs = dl_realloc_array( &dl_ctx->alloc, dl_ctx->enum_value_descs, dl_ctx->enum_value_count + header.enum_value_count,           dl_ctx->enum_value_count );
 	dl_ctx->enum_alias_descs = dl_realloc_array( &dl_ctx->alloc, dl_ctx->enum_alias_descs, dl_ctx->enum_alias_count + header.enum_alias_count,           dl_ctx->enum_alias_count );
 	dl_ctx->typedata_strings = dl_realloc_array( &dl_ctx->alloc, dl_ctx->typedata_strings, dl_ctx->typedata_strings_size + header.typeinfo_strings_size, dl_ctx->typedata_strings_size );
@@ -115,6 +126,7 @@ dl_error_t dl_context_load_type_library( dl_ctx_t dl_ctx, const unsigned char* l
 	memcpy( dl_ctx->type_descs       + dl_ctx->type_count,            lib_data + types_offset,        sizeof( dl_type_desc ) * header.type_count );
 	memcpy( dl_ctx->enum_descs       + dl_ctx->enum_count,            lib_data + enums_offset,        sizeof( dl_enum_desc ) * header.enum_count );
 	memcpy( dl_ctx->member_descs     + dl_ctx->member_count,          lib_data + members_offset,      sizeof( dl_member_desc ) * header.member_count );
+	memcpy( dl_ctx->member_lookup    + dl_ctx->member_lookup_count,   lib_data + member_lookup_offset, sizeof( dl_member_lookup_entry ) * header.member_lookup_count );
 	memcpy( dl_ctx->enum_value_descs + dl_ctx->enum_value_count,      lib_data + enum_values_offset,  sizeof( dl_enum_value_desc ) * header.enum_value_count );
 	memcpy( dl_ctx->enum_alias_descs + dl_ctx->enum_alias_count,      lib_data + enum_aliases_offset, sizeof( dl_enum_alias_desc ) * header.enum_alias_count );
 	memcpy( dl_ctx->typedata_strings + dl_ctx->typedata_strings_size, lib_data + typedata_strings_offset, header.typeinfo_strings_size );
@@ -128,6 +140,7 @@ dl_error_t dl_context_load_type_library( dl_ctx_t dl_ctx, const unsigned char* l
 		for( unsigned int i = 0; i < header.type_count; ++i )       dl_endian_swap_type_desc( dl_ctx->type_descs + dl_ctx->type_count + i );
 		for( unsigned int i = 0; i < header.enum_count; ++i )       dl_endian_swap_enum_desc( dl_ctx->enum_descs + dl_ctx->enum_count + i );
 		for( unsigned int i = 0; i < header.member_count; ++i )     dl_endian_swap_member_desc( dl_ctx->member_descs + dl_ctx->member_count + i );
+		for( unsigned int i = 0; i < header.member_lookup_count; ++i ) dl_endian_swap_member_lookup_entry( dl_ctx->member_lookup + dl_ctx->member_lookup_count + i );
 		for( unsigned int i = 0; i < header.enum_value_count; ++i ) dl_endian_swap_enum_value_desc( dl_ctx->enum_value_descs + dl_ctx->enum_value_count + i );
 	}
 
@@ -138,6 +151,7 @@ dl_error_t dl_context_load_type_library( dl_ctx_t dl_ctx, const unsigned char* l
 		if(dl_ctx->type_descs[ dl_ctx->type_count + i ].comment != UINT32_MAX)
 			dl_ctx->type_descs[ dl_ctx->type_count + i ].comment += td_str_offset;
 		dl_ctx->type_descs[ dl_ctx->type_count + i ].member_start += dl_ctx->member_count;
+		dl_ctx->type_descs[ dl_ctx->type_count + i ].member_lookup_start += dl_ctx->member_lookup_count;
 	}
 
 	for( unsigned int i = 0; i < header.member_count; ++i )
@@ -163,9 +177,16 @@ dl_error_t dl_context_load_type_library( dl_ctx_t dl_ctx, const unsigned char* l
 		dl_ctx->enum_value_descs[ dl_ctx->enum_value_count + i ].main_alias += dl_ctx->enum_alias_count;
 	}
 
+	for( unsigned int i = 0; i < header.type_count; ++i )
+		dl_internal_typeid_lookup_insert( &dl_ctx->alloc, &dl_ctx->type_lookup, dl_ctx->type_ids, dl_ctx->type_count + i );
+
+	for( unsigned int i = 0; i < header.enum_count; ++i )
+		dl_internal_typeid_lookup_insert( &dl_ctx->alloc, &dl_ctx->enum_lookup, dl_ctx->enum_ids, dl_ctx->enum_count + i );
+
 	dl_ctx->type_count            += header.type_count;
 	dl_ctx->enum_count            += header.enum_count;
 	dl_ctx->member_count          += header.member_count;
+	dl_ctx->member_lookup_count   += header.member_lookup_count;
 	dl_ctx->enum_value_count      += header.enum_value_count;
 	dl_ctx->enum_alias_count      += header.enum_alias_count;
 	dl_ctx->typedata_strings_size += header.typeinfo_strings_size;
@@ -177,9 +198,12 @@ dl_error_t dl_context_load_type_library( dl_ctx_t dl_ctx, const unsigned char* l
 	dl_ctx->type_capacity         = dl_ctx->type_count;
 	dl_ctx->enum_capacity         = dl_ctx->enum_count;
 	dl_ctx->member_capacity       = dl_ctx->member_count;
+	dl_ctx->member_lookup_capacity = dl_ctx->member_lookup_count;
 	dl_ctx->enum_value_capacity   = dl_ctx->enum_value_count;
 	dl_ctx->enum_alias_capacity   = dl_ctx->enum_alias_count;
 	dl_ctx->typedata_strings_cap  = dl_ctx->typedata_strings_size;
 
+	dl_internal_prepare_types( dl_ctx );
+
 	return dl_internal_load_type_library_defaults( dl_ctx, lib_data + defaults_offset, header.default_value_size );
 }
@@ -57,15 +57,31 @@ static dl_type_desc* dl_alloc_type( dl_ctx_t ctx, dl_typeid_t tid )
 	++ctx->type_count;
 
 	ctx->type_ids[ type_index ] = tid;
+	dl_internal_typeid_lookup_insert( &ctx->alloc, &ctx->type_lookup, ctx->type_ids, type_index );
 	dl_type_desc* type = ctx->type_descs + type_index;
 	memset( type, 0x0, sizeof( dl_type_desc ) );
 	type->flags = DL_TYPE_FLAG_DEFAULT;
 	type->member_start = ctx->member_count;
 	type->member_count = 0;
+	type->member_lookup_start = UINT32_MAX;
+	type->member_lookup_cap   = 0;
 
 	return type;
 }
 
+static void dl_alloc_member_lookup( dl_ctx_t ctx, dl_type_desc* type )
+{
+	uint32_t cap = dl_internal_member_lookup_cap( type->member_count );
+	if( ctx->member_lookup_capacity < (size_t)ctx->member_lookup_count + cap )
+		ctx->member_lookup = dl_grow_array( &ctx->alloc, ctx->member_lookup, &ctx->member_lookup_capacity, cap );
+
+	type->member_lookup_start = ctx->member_lookup_count;
+	type->member_lookup_cap   = cap;
+	ctx->member_lookup_count += cap;
+
+	dl_internal_build_member_lookup( ctx, type, ctx->member_lookup + type->member_lookup_start );
+}
+
 static dl_member_desc* dl_alloc_member( dl_ctx_t ctx )
 {
 	if( ctx->member_capacity <= ctx->member_count )
@@ -95,6 +111,7 @@ static dl_enum_desc* dl_alloc_enum( dl_ctx_t ctx, dl_substr* name )
 	++ctx->enum_count;
 
 	ctx->enum_ids[ enum_index ] = dl_internal_hash_buffer( (const uint8_t*)name->str, (size_t)name->len );
+	dl_internal_typeid_lookup_insert( &ctx->alloc, &ctx->enum_lookup, ctx->enum_ids, enum_index );
 
 	dl_enum_desc* e = &ctx->enum_descs[enum_index];
 	e->name = dl_alloc_string( ctx, name );
@@ -229,7 +246,8 @@ static void dl_load_txt_build_default_data( dl_ctx_t ctx, dl_txt_read_ctx* read_
 
 	// TODO: convert packed instance to typelib endian/ptrsize here!
 
-	size_t inst_size = prod_bytes - sizeof( dl_data_header );
+	// only the instance is of interest, skip relocation table if ctx is setup to store that.
+	size_t inst_size = ((dl_data_header*)pack_buffer)->instance_size;
 
 	ctx->default_data = (uint8_t*)dl_realloc( &ctx->alloc, ctx->default_data, ctx->default_data_size + inst_size, ctx->default_data_size );
 	memcpy( ctx->default_data + ctx->default_data_size, pack_buffer + sizeof( dl_data_header ), inst_size );
@@ -241,6 +259,7 @@ static void dl_load_txt_build_default_data( dl_ctx_t ctx, dl_txt_read_ctx* read_
 	ctx->default_data_size += inst_size;
 
 	--ctx->type_count;
+	dl_internal_typeid_lookup_remove( &ctx->type_lookup, ctx->type_ids, ctx->type_count );
 	--ctx->member_count;
 	ctx->typedata_strings_size = name_start;
 }
@@ -1136,6 +1155,7 @@ static void dl_context_load_txt_type_library_read_type( dl_ctx_t ctx, dl_txt_rea
 	type->alignment[ DL_PTR_SIZE_64BIT ] = align;
 	type->member_count = member_count;
 	type->member_start = member_start;
+	dl_alloc_member_lookup( ctx, type );
 
 	type->comment = comment.len > 0 ? dl_alloc_string( ctx, &comment ) : UINT32_MAX;
 
@@ -1260,15 +1280,19 @@ static void dl_context_load_txt_type_library_inner( dl_ctx_t ctx, dl_txt_read_ct
 			}
 		}
 
-		for( uint32_t member_index = member_start; member_index < ctx->member_count; ++member_index )
-			dl_load_txt_build_default_data( ctx, read_state, member_index );
-
+		// ... flags need to be set before default-values are packed, the packer use DL_TYPE_FLAG_HAS_SUBDATA ...
 		for( unsigned int i = type_start; i < ctx->type_count; ++i )
 			dl_context_load_txt_type_set_flags( ctx, read_state, ctx->type_descs + i );
+
+		// ... and the types prepared, packing default-values might patch members of the new types ...
+		dl_internal_prepare_types( ctx );
+
+		for( uint32_t member_index = member_start; member_index < ctx->member_count; ++member_index )
+			dl_load_txt_build_default_data( ctx, read_state, member_index );
 	}
 	else
 	{
-		dl_report_error_location( ctx, read_state->start, read_state->end, read_state->iter );
+		dl_report_error_location( ctx, read_state );
 	}
 }
 
@@ -1277,10 +1301,12 @@ dl_error_t dl_context_load_txt_type_library( dl_ctx_t ctx, const char* lib_data,
 	(void)lib_data_size;
 
 	dl_txt_read_ctx read_state;
-	read_state.start = lib_data;
-	read_state.end   = lib_data + lib_data_size;
-	read_state.iter  = lib_data;
-	read_state.err   = DL_ERROR_OK;
+	read_state.start  = lib_data;
+	read_state.end    = lib_data + lib_data_size;
+	read_state.iter   = lib_data;
+	read_state.pin    = 0x0;
+	read_state.stream = 0x0;
+	read_state.err    = DL_ERROR_OK;
 
 	dl_context_load_txt_type_library_inner( ctx, &read_state );
 
@@ -14,6 +14,7 @@ dl_error_t dl_context_write_type_library( dl_ctx_t dl_ctx, unsigned char* out_li
 	header.type_count            = dl_ctx->type_count;
 	header.enum_count            = dl_ctx->enum_count;
 	header.member_count          = dl_ctx->member_count;
+	header.member_lookup_count   = dl_ctx->member_lookup_count;
 	header.enum_value_count      = dl_ctx->enum_value_count;
 	header.enum_alias_count      = dl_ctx->enum_alias_count;
 	header.default_value_size    = (uint32_t)dl_ctx->default_data_size;
@@ -26,6 +27,7 @@ dl_error_t dl_context_write_type_library( dl_ctx_t dl_ctx, unsigned char* out_li
 	if(dl_ctx->type_count)            dl_binary_writer_write( &writer, dl_ctx->type_descs, sizeof( dl_type_desc ) * dl_ctx->type_count );
 	if(dl_ctx->enum_count)            dl_binary_writer_write( &writer, dl_ctx->enum_descs, sizeof( dl_enum_desc ) * dl_ctx->enum_count );
 	if(dl_ctx->member_count)          dl_binary_writer_write( &writer, dl_ctx->member_descs, sizeof( dl_member_desc ) * dl_ctx->member_count );
+	if(dl_ctx->member_lookup_count)   dl_binary_writer_write( &writer, dl_ctx->member_lookup, sizeof( dl_member_lookup_entry ) * dl_ctx->member_lookup_count );
 	if(dl_ctx->enum_value_count)      dl_binary_writer_write( &writer, dl_ctx->enum_value_descs, sizeof( dl_enum_value_desc ) * dl_ctx->enum_value_count );
 	if(dl_ctx->enum_alias_count)      dl_binary_writer_write( &writer, dl_ctx->enum_alias_descs, sizeof( dl_enum_alias_desc ) * dl_ctx->enum_alias_count );
 	if(dl_ctx->default_data_size)     dl_binary_writer_write( &writer, dl_ctx->default_data, dl_ctx->default_data_size );
@@ -0,0 +1,501 @@
+#include <dl/dl_typelib.h>
+#include <dl/dl_bin_gen.h>
+
+#include "dl_types.h"
+#include "dl_binary_writer.h"
+
+#include <ctype.h>
+
+#if defined( __GNUC__ )
+static void dl_binary_writer_write_string_fmt( dl_binary_writer* writer, const char* fmt, ... ) __attribute__((format( printf, 2, 3 )));
+#endif
+
+static void dl_binary_writer_write_string_fmt( dl_binary_writer* writer, const char* fmt, ... )
+{
+	char buffer[2048];
+	va_list arg_ptr;
+
+	va_start(arg_ptr, fmt);
+	size_t written = (size_t)vsnprintf( buffer, DL_ARRAY_LENGTH( buffer ), fmt, arg_ptr );
+	va_end(arg_ptr);
+
+	dl_binary_writer_write( writer, buffer, written );
+}
+
+/**
+ * A value that might differ between 32- and 64-bit pointers, formatted as a constant or a DL_BIN_GEN_PTR_SIZE_SELECT.
+ */
+struct dl_bin_gen_val
+{
+	uint32_t v[2];
+	char     str[64];
+
+	dl_bin_gen_val( uint32_t v32, uint32_t v64 )
+	{
+		v[DL_PTR_SIZE_32BIT] = v32;
+		v[DL_PTR_SIZE_64BIT] = v64;
+		if( v32 == v64 )
+			snprintf( str, sizeof(str), "%u", v64 );
+		else
+			snprintf( str, sizeof(str), "DL_BIN_GEN_PTR_SIZE_SELECT( %u, %u )", v32, v64 );
+	}
+};
+
+static dl_bin_gen_val dl_bin_gen_add( const uint32_t base[2], const uint32_t add[2] )
+{
+	return dl_bin_gen_val( base[DL_PTR_SIZE_32BIT] + add[DL_PTR_SIZE_32BIT], base[DL_PTR_SIZE_64BIT] + add[DL_PTR_SIZE_64BIT] );
+}
+
+static dl_bin_gen_val dl_bin_gen_aligned_size( const dl_type_desc* type )
+{
+	return dl_bin_gen_val( dl_internal_align_up( type->size[DL_PTR_SIZE_32BIT], type->alignment[DL_PTR_SIZE_32BIT] ),
+	                       dl_internal_align_up( type->size[DL_PTR_SIZE_64BIT], type->alignment[DL_PTR_SIZE_64BIT] ) );
+}
+
+static dl_bin_gen_val dl_bin_gen_alignment( const dl_type_desc* type )
+{
+	return dl_bin_gen_val( type->alignment[DL_PTR_SIZE_32BIT], type->alignment[DL_PTR_SIZE_64BIT] );
+}
+
+// inline arrays with up to this many elements are unrolled.
+static const uint32_t DL_BIN_GEN_MAX_UNROLL = 4;
+
+static bool dl_bin_gen_has_routines( const dl_type_desc* type )
+{
+	return ( type->flags & DL_TYPE_FLAG_IS_UNION ) == 0;
+}
+
+static bool dl_bin_gen_has_subdata( const dl_type_desc* type )
+{
+	return ( type->flags & DL_TYPE_FLAG_HAS_SUBDATA ) != 0;
+}
+
+/**
+ * Consecutive bytes of an instance that are written as is, adjacent members are merged into one write as long as
+ * they are adjacent for both 32- and 64-bit pointers.
+ */
+struct dl_bin_gen_store_run
+{
+	bool     open;
+	uint32_t start[2];
+	uint32_t size[2];
+};
+
+static void dl_bin_gen_flush_run( dl_binary_writer* writer, dl_bin_gen_store_run* run )
+{
+	if( !run->open )
+		return;
+	dl_bin_gen_val start( run->start[DL_PTR_SIZE_32BIT], run->start[DL_PTR_SIZE_64BIT] );
+	dl_bin_gen_val size( run->size[DL_PTR_SIZE_32BIT], run->size[DL_PTR_SIZE_64BIT] );
+	dl_binary_writer_write_string_fmt( writer, "    dl_bin_gen_store_write( ctx, pos + %s, data + %s, %s );\n", start.str, start.str, size.str );
+	run->open = false;
+}
+
+static void dl_bin_gen_add_run( dl_binary_writer* writer, dl_bin_gen_store_run* run, const uint32_t start[2], const uint32_t size[2] )
+{
+	if( run->open &&
+		run->start[DL_PTR_SIZE_32BIT] + run->size[DL_PTR_SIZE_32BIT] == start[DL_PTR_SIZE_32BIT] &&
+		run->start[DL_PTR_SIZE_64BIT] + run->size[DL_PTR_SIZE_64BIT] == start[DL_PTR_SIZE_64BIT] )
+	{
+		run->size[DL_PTR_SIZE_32BIT] += size[DL_PTR_SIZE_32BIT];
+		run->size[DL_PTR_SIZE_64BIT] += size[DL_PTR_SIZE_64BIT];
+		return;
+	}
+
+	dl_bin_gen_flush_run( writer, run );
+	run->open = true;
+	run->start[DL_PTR_SIZE_32BIT] = start[DL_PTR_SIZE_32BIT];
+	run->start[DL_PTR_SIZE_64BIT] = start[DL_PTR_SIZE_64BIT];
+	run->size[DL_PTR_SIZE_32BIT]  = size[DL_PTR_SIZE_32BIT];
+	run->size[DL_PTR_SIZE_64BIT]  = size[DL_PTR_SIZE_64BIT];
+}
+
+static void dl_bin_gen_write_checked( dl_binary_writer* writer, const char* call )
+{
+	dl_binary_writer_write_string_fmt( writer, "    { dl_error_t err = %s; if( err != DL_ERROR_OK ) return err; }\n", call );
+}
+
+/**
+ * Write store of all members of type placed at base in the instance that is stored, structs without subdata are
+ * flattened into the instance they are part of.
+ */
+static void dl_bin_gen_write_store_members( dl_binary_writer* writer, dl_ctx_t ctx, const dl_type_desc* type, const uint32_t base[2], dl_bin_gen_store_run* run )
+{
+	dl_typeid_t tid = dl_internal_typeid_of( ctx, type );
+	char call[1024];
+	bool last_was_bitfield = false;
+
+	for( uint32_t i = 0; i < type->member_count; ++i )
+	{
+		const dl_member_desc* member = dl_get_type_member( ctx, type, i );
+		dl_type_atom_t    atom    = member->AtomType();
+		dl_type_storage_t storage = member->StorageType();
+		bool is_bitfield = atom == DL_TYPE_ATOM_BITFIELD;
+
+		uint32_t offset[2] = { base[DL_PTR_SIZE_32BIT] + member->offset[DL_PTR_SIZE_32BIT], base[DL_PTR_SIZE_64BIT] + member->offset[DL_PTR_SIZE_64BIT] };
+		dl_bin_gen_val off( offset[DL_PTR_SIZE_32BIT], offset[DL_PTR_SIZE_64BIT] );
+
+		const dl_type_desc* sub_type = storage == DL_TYPE_STORAGE_STRUCT || storage == DL_TYPE_STORAGE_PTR ? dl_internal_find_type( ctx, member->type_id ) : 0x0;
+		bool sub_is_gen = sub_type != 0x0 && dl_bin_gen_has_routines( sub_type );
+		bool fallback = false;
+
+		switch( atom )
+		{
+			case DL_TYPE_ATOM_BITFIELD:
+				// ... a group of bitfields share storage that is written once ...
+				if( !last_was_bitfield )
+					dl_bin_gen_add_run( writer, run, offset, member->size );
+				break;
+
+			case DL_TYPE_ATOM_POD:
+				switch( storage )
+				{
+					case DL_TYPE_STORAGE_STRUCT:
+						if( !sub_is_gen )
+							fallback = true;
+						else if( !dl_bin_gen_has_subdata( sub_type ) )
+							dl_bin_gen_write_store_members( writer, ctx, sub_type, offset, run );
+						else
+						{
+							dl_bin_gen_flush_run( writer, run );
+							snprintf( call, sizeof(call), "%s_store( ctx, data + %s, pos + %s )", dl_internal_type_name( ctx, sub_type ), off.str, off.str );
+							dl_bin_gen_write_checked( writer, call );
+						}
+						break;
+					case DL_TYPE_STORAGE_STR:
+						dl_bin_gen_flush_run( writer, run );
+						dl_binary_writer_write_string_fmt( writer, "    dl_bin_gen_store_str( ctx, pos + %s, data + %s );\n", off.str, off.str );
+						break;
+					case DL_TYPE_STORAGE_PTR:
+						if( !sub_is_gen )
+							fallback = true;
+						else
+						{
+							dl_bin_gen_flush_run( writer, run );
+							snprintf( call, sizeof(call), "dl_bin_gen_store_ptr( ctx, pos + %s, data + %s, %s, %s, %s_store )",
+							          off.str, off.str, dl_bin_gen_aligned_size( sub_type ).str, dl_bin_gen_alignment( sub_type ).str, dl_internal_type_name( ctx, sub_type ) );
+							dl_bin_gen_write_checked( writer, call );
+						}
+						break;
+					default:
+						dl_bin_gen_add_run( writer, run, offset, member->size );
+						break;
+				}
+				break;
+
+			case DL_TYPE_ATOM_INLINE_ARRAY:
+			{
+				uint32_t count = member->inline_array_cnt();
+				uint32_t stride[2];
+				if( storage == DL_TYPE_STORAGE_STRUCT && sub_is_gen && dl_bin_gen_has_subdata( sub_type ) )
+				{
+					stride[DL_PTR_SIZE_32BIT] = sub_type->size[DL_PTR_SIZE_32BIT];
+					stride[DL_PTR_SIZE_64BIT] = sub_type->size[DL_PTR_SIZE_64BIT];
+				}
+				else if( storage == DL_TYPE_STORAGE_STR || ( storage == DL_TYPE_STORAGE_PTR && sub_is_gen ) )
+				{
+					stride[DL_PTR_SIZE_32BIT] = 4;
+					stride[DL_PTR_SIZE_64BIT] = 8;
+				}
+				else if( storage == DL_TYPE_STORAGE_STRUCT && sub_is_gen )
+				{
+					uint32_t size[2] = { count * sub_type->size[DL_PTR_SIZE_32BIT], count * sub_type->size[DL_PTR_SIZE_64BIT] };
+					dl_bin_gen_add_run( writer, run, offset, size );
+					break;
+				}
+				else if( storage == DL_TYPE_STORAGE_STRUCT || storage == DL_TYPE_STORAGE_PTR )
+				{
+					fallback = true;
+					break;
+				}
+				else
+				{
+					dl_bin_gen_add_run( writer, run, offset, member->size );
+					break;
+				}
+
+				dl_bin_gen_flush_run( writer, run );
+				const char* sub_name = sub_type ? dl_internal_type_name( ctx, sub_type ) : "";
+				for( uint32_t elem = 0; elem < ( count <= DL_BIN_GEN_MAX_UNROLL ? count : 1 ); ++elem )
+				{
+					char elem_off[256];
+					if( count <= DL_BIN_GEN_MAX_UNROLL )
+					{
+						uint32_t elem_offset[2] = { elem * stride[DL_PTR_SIZE_32BIT], elem * stride[DL_PTR_SIZE_64BIT] };
+						snprintf( elem_off, sizeof(elem_off), "%s", dl_bin_gen_add( offset, elem_offset ).str );
+					}
+					else
+					{
+						snprintf( elem_off, sizeof(elem_off), "%s + i * %s", off.str, dl_bin_gen_val( stride[DL_PTR_SIZE_32BIT], stride[DL_PTR_SIZE_64BIT] ).str );
+						dl_binary_writer_write_string_fmt( writer, "    for( uint32_t i = 0; i < %u; ++i )\n    ", count );
+					}
+
+					if( storage == DL_TYPE_STORAGE_STR )
+						dl_binary_writer_write_string_fmt( writer, "    dl_bin_gen_store_str( ctx, pos + %s, data + %s );\n", elem_off, elem_off );
+					else
+					{
+						if( storage == DL_TYPE_STORAGE_PTR )
+							snprintf( call, sizeof(call), "dl_bin_gen_store_ptr( ctx, pos + %s, data + %s, %s, %s, %s_store )",
+							          elem_off, elem_off, dl_bin_gen_aligned_size( sub_type ).str, dl_bin_gen_alignment( sub_type ).str, sub_name );
+						else
+							snprintf( call, sizeof(call), "%s_store( ctx, data + %s, pos + %s )", sub_name, elem_off, elem_off );
+						dl_bin_gen_write_checked( writer, call );
+					}
+				}
+			}
+			break;
+
+			case DL_TYPE_ATOM_ARRAY:
+			{
+				if( storage == DL_TYPE_STORAGE_STR || storage == DL_TYPE_STORAGE_PTR || ( storage == DL_TYPE_STORAGE_STRUCT && !sub_is_gen ) )
+				{
+					fallback = true;
+					break;
+				}
+
+				dl_bin_gen_flush_run( writer, run );
+				if( storage == DL_TYPE_STORAGE_STRUCT )
+				{
+					char store[256] = "0x0";
+					if( dl_bin_gen_has_subdata( sub_type ) )
+						snprintf( store, sizeof(store), "%s_store", dl_internal_type_name( ctx, sub_type ) );
+					snprintf( call, sizeof(call), "dl_bin_gen_store_array( ctx, pos + %s, data + %s, %s, %s, %s )",
+					          off.str, off.str, dl_bin_gen_aligned_size( sub_type ).str, dl_bin_gen_alignment( sub_type ).str, store );
+				}
+				else
+				{
+					unsigned int pod_size = (unsigned int)dl_pod_size( storage );
+					snprintf( call, sizeof(call), "dl_bin_gen_store_array( ctx, pos + %s, data + %s, %u, %u, 0x0 )", off.str, off.str, pod_size, pod_size );
+				}
+				dl_bin_gen_write_checked( writer, call );
+			}
+			break;
+
+			default:
+				fallback = true;
+				break;
+		}
+
+		if( fallback )
+		{
+			dl_bin_gen_val b( base[DL_PTR_SIZE_32BIT], base[DL_PTR_SIZE_64BIT] );
+			dl_bin_gen_flush_run( writer, run );
+			snprintf( call, sizeof(call), "dl_bin_gen_store_member( ctx, 0x%08Xu, %u, data + %s, pos + %s )", tid, i, b.str, b.str );
+			dl_bin_gen_write_checked( writer, call );
+		}
+
+		last_was_bitfield = is_bitfield;
+	}
+}
+
+static void dl_bin_gen_write_store( dl_binary_writer* writer, dl_ctx_t ctx, const dl_type_desc* type )
+{
+	dl_binary_writer_write_string_fmt( writer, "static dl_error_t %s_store( dl_bin_gen_store_t ctx, const uint8_t* data, size_t pos )\n{\n", dl_internal_type_name( ctx, type ) );
+	if( type->member_count == 0 )
+		dl_binary_writer_write_string_fmt( writer, "    (void)ctx;\n"
+		                                           "    (void)data;\n"
+		                                           "    (void)pos;\n" );
+
+	uint32_t base[2] = { 0, 0 };
+	dl_bin_gen_store_run run = { false, { 0, 0 }, { 0, 0 } };
+	dl_bin_gen_write_store_members( writer, ctx, type, base, &run );
+	dl_bin_gen_flush_run( writer, &run );
+	dl_binary_writer_write_string_fmt( writer, "    return DL_ERROR_OK;\n"
+	                                           "}\n\n" );
+}
+
+/**
+ * Write patch of the pointer at ptr_expr, followed by patch of what it points to if that has subdata.
+ */
+static void dl_bin_gen_write_patch_ptr( dl_binary_writer* writer, dl_ctx_t ctx, const dl_type_desc* sub_type, const char* indent, const char* ptr_expr )
+{
+	if( !dl_bin_gen_has_subdata( sub_type ) )
+	{
+		dl_binary_writer_write_string_fmt( writer, "%sdl_bin_gen_patch_ptr( ctx, %s );\n", indent, ptr_expr );
+		return;
+	}
+	dl_binary_writer_write_string_fmt( writer, "%s{\n"
+	                                           "%s    uint8_t* ptr = dl_bin_gen_patch_ptr( ctx, %s );\n"
+	                                           "%s    if( ptr && dl_bin_gen_patch_first_visit( ctx, ptr ) )\n"
+	                                           "%s        %s_patch( ctx, ptr );\n"
+	                                           "%s}\n", indent, indent, ptr_expr, indent, indent, dl_internal_type_name( ctx, sub_type ), indent );
+}
+
+static void dl_bin_gen_write_patch( dl_binary_writer* writer, dl_ctx_t ctx, const dl_type_desc* type )
+{
+	dl_typeid_t tid = dl_internal_typeid_of( ctx, type );
+	dl_binary_writer_write_string_fmt( writer, "static void %s_patch( dl_bin_gen_patch_t ctx, uint8_t* data )\n{\n", dl_internal_type_name( ctx, type ) );
+
+	for( uint32_t i = 0; i < type->member_count; ++i )
+	{
+		const dl_member_desc* member = dl_get_type_member( ctx, type, i );
+		dl_type_atom_t    atom    = member->AtomType();
+		dl_type_storage_t storage = member->StorageType();
+		dl_bin_gen_val off( member->offset[DL_PTR_SIZE_32BIT], member->offset[DL_PTR_SIZE_64BIT] );
+
+		if( atom == DL_TYPE_ATOM_BITFIELD || member->IsSimplePod() )
+		{
+			// ... arrays of pods only need the array-pointer patched ...
+			if( atom == DL_TYPE_ATOM_ARRAY )
+				dl_binary_writer_write_string_fmt( writer, "    dl_bin_gen_patch_ptr( ctx, data + %s );\n", off.str );
+			continue;
+		}
+
+		const dl_type_desc* sub_type = storage == DL_TYPE_STORAGE_STR ? 0x0 : dl_internal_find_type( ctx, member->type_id );
+		bool sub_has_subdata = sub_type != 0x0 && dl_bin_gen_has_subdata( sub_type );
+		if( sub_type != 0x0 && !dl_bin_gen_has_routines( sub_type ) )
+		{
+			// ... unions are patched by the generic code, embedded ones only if they need patching ...
+			if( atom != DL_TYPE_ATOM_POD || storage != DL_TYPE_STORAGE_STRUCT || sub_has_subdata )
+				dl_binary_writer_write_string_fmt( writer, "    dl_bin_gen_patch_member( ctx, 0x%08Xu, %u, data );\n", tid, i );
+			continue;
+		}
+
+		char elem[256];
+		switch( atom )
+		{
+			case DL_TYPE_ATOM_POD:
+				snprintf( elem, sizeof(elem), "data + %s", off.str );
+				if( storage == DL_TYPE_STORAGE_STR )
+					dl_binary_writer_write_string_fmt( writer, "    dl_bin_gen_patch_ptr( ctx, %s );\n", elem );
+				else if( storage == DL_TYPE_STORAGE_PTR )
+					dl_bin_gen_write_patch_ptr( writer, ctx, sub_type, "    ", elem );
+				else if( sub_has_subdata )
+					dl_binary_writer_write_string_fmt( writer, "    %s_patch( ctx, %s );\n", dl_internal_type_name( ctx, sub_type ), elem );
+				break;
+
+			case DL_TYPE_ATOM_INLINE_ARRAY:
+			case DL_TYPE_ATOM_ARRAY:
+			{
+				bool is_array = atom == DL_TYPE_ATOM_ARRAY;
+				if( storage == DL_TYPE_STORAGE_STRUCT && !sub_has_subdata )
+				{
+					if( is_array )
+						dl_binary_writer_write_string_fmt( writer, "    dl_bin_gen_patch_ptr( ctx, data + %s );\n", off.str );
+					break;
+				}
+
+				dl_bin_gen_val stride = storage == DL_TYPE_STORAGE_STRUCT ? dl_bin_gen_aligned_size( sub_type ) : dl_bin_gen_val( 4, 8 );
+				uint32_t count = member->inline_array_cnt();
+				bool unroll = !is_array && count <= DL_BIN_GEN_MAX_UNROLL;
+
+				const char* indent = "    ";
+				if( is_array )
+				{
+					dl_binary_writer_write_string_fmt( writer, "    {\n"
+					                                           "        uint8_t* array = dl_bin_gen_patch_ptr( ctx, data + %s );\n"
+					                                           "        uint32_t count = *(const uint32_t*)( data + %s + sizeof(void*) );\n"
+					                                           "        for( uint32_t i = 0; i < count; ++i )\n", off.str, off.str );
+					snprintf( elem, sizeof(elem), "array + i * %s", stride.str );
+					indent = "            ";
+				}
+				else if( !unroll )
+				{
+					dl_binary_writer_write_string_fmt( writer, "    for( uint32_t i = 0; i < %u; ++i )\n", count );
+					snprintf( elem, sizeof(elem), "data + %s + i * %s", off.str, stride.str );
+					indent = "        ";
+				}
+
+				for( uint32_t e = 0; e < ( unroll ? count : 1 ); ++e )
+				{
+					if( unroll )
+					{
+						uint32_t elem_offset[2] = { e * stride.v[DL_PTR_SIZE_32BIT], e * stride.v[DL_PTR_SIZE_64BIT] };
+						snprintf( elem, sizeof(elem), "data + %s", dl_bin_gen_add( off.v, elem_offset ).str );
+					}
+
+					if( storage == DL_TYPE_STORAGE_STR )
+						dl_binary_writer_write_string_fmt( writer, "%sdl_bin_gen_patch_ptr( ctx, %s );\n", indent, elem );
+					else if( storage == DL_TYPE_STORAGE_PTR )
+						dl_bin_gen_write_patch_ptr( writer, ctx, sub_type, indent, elem );
+					else
+						dl_binary_writer_write_string_fmt( writer, "%s%s_patch( ctx, %s );\n", indent, dl_internal_type_name( ctx, sub_type ), elem );
+				}
+
+				if( is_array )
+					dl_binary_writer_write_string_fmt( writer, "    }\n" );
+			}
+			break;
+
+			default:
+				break;
+		}
+	}
+	dl_binary_writer_write_string_fmt( writer, "}\n\n" );
+}
+
+dl_error_t dl_context_write_type_library_bin_gen( dl_ctx_t dl_ctx, const char* module_name, char* out_header, size_t out_header_size, size_t* produced_bytes )
+{
+	// ... module name is used in identifiers, skip file-extension and replace everything that can't be part of an identifier ...
+	char module[128];
+	char MODULE[128];
+	size_t pos = 0;
+	for( const char* iter = module_name; *iter && *iter != '.' && pos < 127; ++iter, ++pos )
+	{
+		module[pos] = isalnum( *iter ) ? *iter : '_';
+		MODULE[pos] = (char)toupper( module[pos] );
+	}
+	module[pos] = '\0';
+	MODULE[pos] = '\0';
+
+	dl_binary_writer writer;
+	dl_binary_writer_init( &writer, (uint8_t*)out_header, out_header_size, out_header == 0x0, DL_ENDIAN_HOST, DL_ENDIAN_HOST, DL_PTR_SIZE_HOST );
+
+	dl_binary_writer_write_string_fmt( &writer, "/* Auto generated store/patch-routines for dl type library, register with %s_bin_gen_register() */\n"
+	                                            "#ifndef __DL_AUTOGEN_BIN_GEN_%s_INCLUDED\n"
+	                                            "#define __DL_AUTOGEN_BIN_GEN_%s_INCLUDED\n\n"
+	                                            "#include <dl/dl_bin_gen.h>\n\n", module, MODULE, MODULE );
+
+	// ... declare all routines first as members call the routines of their type directly ...
+	for( unsigned int i = 0; i < dl_ctx->type_count; ++i )
+	{
+		const dl_type_desc* type = dl_ctx->type_descs + i;
+		if( !dl_bin_gen_has_routines( type ) )
+			continue;
+		const char* type_name = dl_internal_type_name( dl_ctx, type );
+		dl_binary_writer_write_string_fmt( &writer, "static dl_error_t %s_store( dl_bin_gen_store_t ctx, const uint8_t* data, size_t pos );\n", type_name );
+		if( dl_bin_gen_has_subdata( type ) )
+			dl_binary_writer_write_string_fmt( &writer, "static void %s_patch( dl_bin_gen_patch_t ctx, uint8_t* data );\n", type_name );
+	}
+	dl_binary_writer_write_string_fmt( &writer, "\n" );
+
+	for( unsigned int i = 0; i < dl_ctx->type_count; ++i )
+	{
+		const dl_type_desc* type = dl_ctx->type_descs + i;
+		if( !dl_bin_gen_has_routines( type ) )
+			continue;
+		dl_bin_gen_write_store( &writer, dl_ctx, type );
+		if( dl_bin_gen_has_subdata( type ) )
+			dl_bin_gen_write_patch( &writer, dl_ctx, type );
+	}
+
+	dl_binary_writer_write_string_fmt( &writer, "static inline dl_error_t %s_bin_gen_register( dl_ctx_t dl_ctx )\n{\n", module );
+	unsigned int registered = 0;
+	for( unsigned int i = 0; i < dl_ctx->type_count; ++i )
+	{
+		const dl_type_desc* type = dl_ctx->type_descs + i;
+		if( !dl_bin_gen_has_routines( type ) )
+			continue;
+		const char* type_name = dl_internal_type_name( dl_ctx, type );
+		if( registered++ == 0 )
+			dl_binary_writer_write_string_fmt( &writer, "    static const dl_bin_gen_type TYPES[] = {\n" );
+		dl_bin_gen_val size( type->size[DL_PTR_SIZE_32BIT], type->size[DL_PTR_SIZE_64BIT] );
+		dl_binary_writer_write_string_fmt( &writer, "        { 0x%08Xu, %s, %u, %s_store, ", dl_internal_typeid_of( dl_ctx, type ), size.str, type->member_count, type_name );
+		if( dl_bin_gen_has_subdata( type ) )
+			dl_binary_writer_write_string_fmt( &writer, "%s_patch },\n", type_name );
+		else
+			dl_binary_writer_write_string_fmt( &writer, "0x0 },\n" );
+	}
+	if( registered > 0 )
+		dl_binary_writer_write_string_fmt( &writer, "    };\n"
+		                                            "    return dl_bin_gen_register( dl_ctx, TYPES, sizeof(TYPES) / sizeof(TYPES[0]) );\n" );
+	else
+		dl_binary_writer_write_string_fmt( &writer, "    return dl_bin_gen_register( dl_ctx, 0x0, 0 );\n" );
+	dl_binary_writer_write_string_fmt( &writer, "}\n\n"
+	                                            "#endif // __DL_AUTOGEN_BIN_GEN_%s_INCLUDED\n", MODULE );
+
+	if( produced_bytes )
+		*produced_bytes = dl_binary_writer_needed_size( &writer );
+
+	return DL_ERROR_OK;
+}
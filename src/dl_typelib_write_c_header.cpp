@@ -193,6 +193,20 @@ static void dl_context_write_c_header_begin( dl_binary_writer* writer, const cha
 									   "           uint32_t count; \\\n"
 									   "       }\n"
 									   "#  endif\n"
+									   "\n"
+									   "   // ... dl_rel_ptr() ...\n"
+									   "   /// Resolve a pointer, string or array-data member in an instance converted by dl_instance_make_self_relative().\n"
+									   "   /// The member store the offset to the data relative to itself and null is stored as 1.\n"
+									   "#  if defined(_MSC_VER) && !defined(__cplusplus)\n"
+									   "#    define DL_INLINE __inline\n"
+									   "#  else\n"
+									   "#    define DL_INLINE inline\n"
+									   "#  endif\n"
+									   "   static DL_INLINE const void* dl_rel_ptr( const void* member )\n"
+									   "   {\n"
+									   "       intptr_t offset = *(const intptr_t*)member;\n"
+									   "       return offset == 1 ? 0 : (const char*)member + offset;\n"
+									   "   }\n"
 									   "#endif // __DL_AUTOGEN_HEADER_DL_ALIGN_DEFINED\n\n" );
 }
 
@@ -635,6 +649,64 @@ static void dl_context_write_c_header_member( dl_binary_writer* writer, dl_ctx_t
 	*last_was_bf = member->atom == DL_TYPE_ATOM_BITFIELD;
 }
 
+static void dl_context_write_c_header_rel_type( dl_binary_writer* writer, dl_ctx_t ctx, const dl_member_info_t* member )
+{
+	if( member->atom == DL_TYPE_ATOM_ARRAY && member->storage != DL_TYPE_STORAGE_STR && member->storage != DL_TYPE_STORAGE_PTR )
+	{
+		dl_binary_writer_write_string_fmt( writer, "const " );
+		dl_context_write_operator_array_access_type( ctx, member->storage, member->type_id, writer );
+		dl_binary_writer_write_string_fmt( writer, "*" );
+	}
+	else if( member->storage == DL_TYPE_STORAGE_PTR )
+	{
+		dl_binary_writer_write_string_fmt( writer, "const " );
+		dl_context_write_type( ctx, member->storage, member->type_id, writer );
+	}
+	else
+		dl_context_write_type( ctx, member->storage, member->type_id, writer ); // str is already const char*
+}
+
+/**
+ * Write accessors resolving all pointers, strings and array-data in a type for instances made self-relative by
+ * dl_instance_make_self_relative(), named <type>_rel_<member>. Arrays of pointers and strings get an element index.
+ */
+static void dl_context_write_c_header_rel_accessors( dl_binary_writer* writer, dl_ctx_t ctx, const dl_type_info_t* type, const dl_member_info_t* members )
+{
+	const char* value = type->is_union ? "value." : "";
+	bool wrote_any = false;
+	for( unsigned int member_index = 0; member_index < type->member_count; ++member_index )
+	{
+		const dl_member_info_t* member = members + member_index;
+		bool is_ptr = member->storage == DL_TYPE_STORAGE_STR || member->storage == DL_TYPE_STORAGE_PTR;
+
+		if( member->atom != DL_TYPE_ATOM_ARRAY && !( is_ptr && ( member->atom == DL_TYPE_ATOM_POD || member->atom == DL_TYPE_ATOM_INLINE_ARRAY ) ) )
+			continue;
+
+		dl_binary_writer_write_string_fmt( writer, "static DL_INLINE " );
+		dl_context_write_c_header_rel_type( writer, ctx, member );
+		if( member->atom == DL_TYPE_ATOM_POD || !is_ptr )
+			dl_binary_writer_write_string_fmt( writer, " %s_rel_%s( const struct %s* s ) { return (", type->name, member->name, type->name );
+		else if( member->atom == DL_TYPE_ATOM_INLINE_ARRAY )
+			dl_binary_writer_write_string_fmt( writer, " %s_rel_%s( const struct %s* s, uint32_t i ) { DL_DATA_ASSERT(i < %u); return (", type->name, member->name, type->name, member->array_count );
+		else
+			dl_binary_writer_write_string_fmt( writer, " %s_rel_%s( const struct %s* s, uint32_t i ) { DL_DATA_ASSERT(i < s->%s%s.count); return (", type->name, member->name, type->name, value, member->name );
+		dl_context_write_c_header_rel_type( writer, ctx, member );
+
+		if( member->atom == DL_TYPE_ATOM_POD )
+			dl_binary_writer_write_string_fmt( writer, ")dl_rel_ptr( &s->%s%s ); }\n", value, member->name );
+		else if( member->atom == DL_TYPE_ATOM_INLINE_ARRAY )
+			dl_binary_writer_write_string_fmt( writer, ")dl_rel_ptr( &s->%s%s[i] ); }\n", value, member->name );
+		else if( !is_ptr )
+			dl_binary_writer_write_string_fmt( writer, ")dl_rel_ptr( &s->%s%s.data ); }\n", value, member->name );
+		else
+			dl_binary_writer_write_string_fmt( writer, ")dl_rel_ptr( (const intptr_t*)dl_rel_ptr( &s->%s%s.data ) + i ); }\n", value, member->name );
+		wrote_any = true;
+	}
+
+	if( wrote_any )
+		dl_binary_writer_write_string_fmt( writer, "\n" );
+}
+
 static void dl_context_write_c_header_types( dl_binary_writer* writer, dl_ctx_t ctx )
 {
 	dl_type_context_info_t ctx_info;
@@ -771,8 +843,11 @@ static void dl_context_write_c_header_types( dl_binary_writer* writer, dl_ctx_t
 				dl_context_write_c_header_member( writer, ctx, members + member_index, &last_was_bf );
 		}
 
-		free( members );
 		dl_binary_writer_write_string_fmt( writer, "};\n\n" );
+
+		dl_context_write_c_header_rel_accessors( writer, ctx, type, members );
+
+		free( members );
 	}
 
 	free( type_info );
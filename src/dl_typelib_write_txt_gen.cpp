@@ -0,0 +1,438 @@
+#include <dl/dl_typelib.h>
+#include <dl/dl_txt_gen.h>
+
+#include "dl_types.h"
+#include "dl_binary_writer.h"
+
+#include <stdlib.h>
+#include <ctype.h>
+
+#if defined( __GNUC__ )
+static void dl_binary_writer_write_string_fmt( dl_binary_writer* writer, const char* fmt, ... ) __attribute__((format( printf, 2, 3 )));
+#endif
+
+static void dl_binary_writer_write_string_fmt( dl_binary_writer* writer, const char* fmt, ... )
+{
+	char buffer[2048];
+	va_list arg_ptr;
+
+	va_start(arg_ptr, fmt);
+	size_t written = (size_t)vsnprintf( buffer, DL_ARRAY_LENGTH( buffer ), fmt, arg_ptr );
+	va_end(arg_ptr);
+
+	dl_binary_writer_write( writer, buffer, written );
+}
+
+/**
+ * Perfect hash mapping the member-names of a type to member-index, a key is looked up as
+ * slots[ dl_txt_gen_hash( key, len, seeds[ dl_txt_gen_hash( key, len, 0 ) & ( bucket_count - 1 ) ] ) & ( slot_count - 1 ) ]
+ * where the first hash is skipped if there is only one bucket.
+ */
+struct dl_txt_gen_perfect_hash
+{
+	uint32_t  bucket_count;
+	uint32_t  slot_count;
+	uint16_t* seeds;
+	uint16_t* slots; // member-index or 0xFFFF for unused slots.
+};
+
+static uint32_t dl_txt_gen_next_pow2( uint32_t v )
+{
+	uint32_t res = 1;
+	while( res < v )
+		res <<= 1;
+	return res;
+}
+
+/**
+ * Build a perfect hash for the members of type by "hash and displace", members are split into buckets by one
+ * hash and each bucket, largest first, get a seed that place all its members in free slots.
+ */
+static void dl_txt_gen_build_perfect_hash( dl_ctx_t ctx, const dl_type_desc* type, dl_txt_gen_perfect_hash* hash )
+{
+	uint32_t member_count = type->member_count;
+	hash->bucket_count = member_count <= 8 ? 1 : dl_txt_gen_next_pow2( member_count / 4 );
+	hash->slot_count   = dl_txt_gen_next_pow2( member_count );
+	hash->seeds = (uint16_t*)malloc( sizeof(uint16_t) * hash->bucket_count );
+	hash->slots = 0x0;
+
+	uint32_t* member_bucket = (uint32_t*)malloc( sizeof(uint32_t) * member_count );
+	uint32_t* bucket_order  = (uint32_t*)malloc( sizeof(uint32_t) * hash->bucket_count );
+	uint32_t* bucket_size   = (uint32_t*)calloc( hash->bucket_count, sizeof(uint32_t) );
+	uint32_t* member_slot   = (uint32_t*)malloc( sizeof(uint32_t) * member_count );
+
+	for( uint32_t i = 0; i < member_count; ++i )
+	{
+		const char* name = dl_internal_member_name( ctx, dl_get_type_member( ctx, type, i ) );
+		member_bucket[i] = hash->bucket_count == 1 ? 0 : dl_txt_gen_hash( name, strlen( name ), 0 ) & ( hash->bucket_count - 1 );
+		++bucket_size[ member_bucket[i] ];
+	}
+
+	// ... largest buckets first, they are the hardest to place ...
+	for( uint32_t i = 0; i < hash->bucket_count; ++i )
+		bucket_order[i] = i;
+	for( uint32_t i = 1; i < hash->bucket_count; ++i )
+		for( uint32_t j = i; j > 0 && bucket_size[ bucket_order[j] ] > bucket_size[ bucket_order[j - 1] ]; --j )
+		{
+			uint32_t tmp = bucket_order[j];
+			bucket_order[j] = bucket_order[j - 1];
+			bucket_order[j - 1] = tmp;
+		}
+
+	while( true )
+	{
+		hash->slots = (uint16_t*)realloc( hash->slots, sizeof(uint16_t) * hash->slot_count );
+		memset( hash->slots, 0xFF, sizeof(uint16_t) * hash->slot_count );
+
+		bool placed_all = true;
+		for( uint32_t bucket_index = 0; bucket_index < hash->bucket_count && placed_all; ++bucket_index )
+		{
+			uint32_t bucket = bucket_order[bucket_index];
+			hash->seeds[bucket] = 0;
+			if( bucket_size[bucket] == 0 )
+				continue;
+
+			placed_all = false;
+			for( uint32_t seed = 1; seed <= 0xFFFF && !placed_all; ++seed )
+			{
+				placed_all = true;
+				for( uint32_t i = 0; i < member_count && placed_all; ++i )
+				{
+					if( member_bucket[i] != bucket )
+						continue;
+
+					const char* name = dl_internal_member_name( ctx, dl_get_type_member( ctx, type, i ) );
+					member_slot[i] = dl_txt_gen_hash( name, strlen( name ), seed ) & ( hash->slot_count - 1 );
+					if( hash->slots[ member_slot[i] ] != 0xFFFF )
+						placed_all = false;
+					for( uint32_t j = 0; j < i && placed_all; ++j )
+						if( member_bucket[j] == bucket && member_slot[j] == member_slot[i] )
+							placed_all = false;
+				}
+
+				if( placed_all )
+				{
+					hash->seeds[bucket] = (uint16_t)seed;
+					for( uint32_t i = 0; i < member_count; ++i )
+						if( member_bucket[i] == bucket )
+							hash->slots[ member_slot[i] ] = (uint16_t)i;
+				}
+			}
+		}
+
+		if( placed_all )
+			break;
+
+		// ... no seed found for some bucket, retry with more room ...
+		hash->slot_count *= 2;
+	}
+
+	free( member_bucket );
+	free( bucket_order );
+	free( bucket_size );
+	free( member_slot );
+}
+
+static void dl_txt_gen_write_ptr_size_select( dl_binary_writer* writer, uint32_t value32, uint32_t value64 )
+{
+	if( value32 == value64 )
+		dl_binary_writer_write_string_fmt( writer, "%u", value64 );
+	else
+		dl_binary_writer_write_string_fmt( writer, "DL_TXT_GEN_PTR_SIZE_SELECT( %u, %u )", value32, value64 );
+}
+
+static const char* dl_txt_gen_pod_name( dl_type_storage_t storage )
+{
+	switch( storage )
+	{
+		case DL_TYPE_STORAGE_INT8:   return "int8";
+		case DL_TYPE_STORAGE_INT16:  return "int16";
+		case DL_TYPE_STORAGE_INT32:  return "int32";
+		case DL_TYPE_STORAGE_INT64:  return "int64";
+		case DL_TYPE_STORAGE_UINT8:  return "uint8";
+		case DL_TYPE_STORAGE_UINT16: return "uint16";
+		case DL_TYPE_STORAGE_UINT32: return "uint32";
+		case DL_TYPE_STORAGE_UINT64: return "uint64";
+		case DL_TYPE_STORAGE_FP32:   return "fp32";
+		case DL_TYPE_STORAGE_FP64:   return "fp64";
+		default:
+			return 0x0;
+	}
+}
+
+/**
+ * Return the type of member if it is a struct that has generated routines, i.e. is not a union.
+ */
+static const dl_type_desc* dl_txt_gen_struct_member_type( dl_ctx_t ctx, const dl_member_desc* member )
+{
+	if( member->AtomType() != DL_TYPE_ATOM_POD || member->StorageType() != DL_TYPE_STORAGE_STRUCT )
+		return 0x0;
+	const dl_type_desc* sub_type = dl_internal_find_type( ctx, member->type_id );
+	return sub_type != 0x0 && ( sub_type->flags & DL_TYPE_FLAG_IS_UNION ) == 0 ? sub_type : 0x0;
+}
+
+static bool dl_txt_gen_has_routines( const dl_type_desc* type )
+{
+	return ( type->flags & DL_TYPE_FLAG_IS_UNION ) == 0;
+}
+
+static void dl_txt_gen_write_find_member( dl_binary_writer* writer, dl_ctx_t ctx, const dl_type_desc* type )
+{
+	const char* type_name = dl_internal_type_name( ctx, type );
+
+	dl_txt_gen_perfect_hash hash;
+	dl_txt_gen_build_perfect_hash( ctx, type, &hash );
+
+	dl_binary_writer_write_string_fmt( writer, "static uint32_t %s_txt_find_member( const char* key, size_t key_len )\n{\n", type_name );
+
+	if( hash.bucket_count > 1 )
+	{
+		dl_binary_writer_write_string_fmt( writer, "    static const uint16_t SEEDS[%u] = {", hash.bucket_count );
+		for( uint32_t i = 0; i < hash.bucket_count; ++i )
+			dl_binary_writer_write_string_fmt( writer, "%s %u", i == 0 ? "" : ",", hash.seeds[i] );
+		dl_binary_writer_write_string_fmt( writer, " };\n" );
+	}
+
+	dl_binary_writer_write_string_fmt( writer, "    static const uint16_t SLOTS[%u] = {", hash.slot_count );
+	for( uint32_t i = 0; i < hash.slot_count; ++i )
+		dl_binary_writer_write_string_fmt( writer, "%s %u", i == 0 ? "" : ",", hash.slots[i] );
+	dl_binary_writer_write_string_fmt( writer, " };\n" );
+
+	dl_binary_writer_write_string_fmt( writer, "    static const char* const NAMES[%u] = {", type->member_count );
+	for( uint32_t i = 0; i < type->member_count; ++i )
+		dl_binary_writer_write_string_fmt( writer, "%s \"%s\"", i == 0 ? "" : ",", dl_internal_member_name( ctx, dl_get_type_member( ctx, type, i ) ) );
+	dl_binary_writer_write_string_fmt( writer, " };\n" );
+
+	dl_binary_writer_write_string_fmt( writer, "    static const size_t NAME_LENGTHS[%u] = {", type->member_count );
+	for( uint32_t i = 0; i < type->member_count; ++i )
+		dl_binary_writer_write_string_fmt( writer, "%s %u", i == 0 ? "" : ",", (unsigned int)strlen( dl_internal_member_name( ctx, dl_get_type_member( ctx, type, i ) ) ) );
+	dl_binary_writer_write_string_fmt( writer, " };\n\n" );
+
+	if( hash.bucket_count > 1 )
+		dl_binary_writer_write_string_fmt( writer, "    uint32_t seed = SEEDS[ dl_txt_gen_hash( key, key_len, 0 ) & %uu ];\n", hash.bucket_count - 1 );
+	else
+		dl_binary_writer_write_string_fmt( writer, "    uint32_t seed = %u;\n", hash.seeds[0] );
+
+	dl_binary_writer_write_string_fmt( writer, "    uint32_t member = SLOTS[ dl_txt_gen_hash( key, key_len, seed ) & %uu ];\n"
+	                                           "    if( member == 0xFFFF || NAME_LENGTHS[member] != key_len || memcmp( NAMES[member], key, key_len ) != 0 )\n"
+	                                           "        return UINT32_MAX;\n"
+	                                           "    return member;\n"
+	                                           "}\n\n", hash.slot_count - 1 );
+
+	free( hash.seeds );
+	free( hash.slots );
+}
+
+static void dl_txt_gen_write_pack( dl_binary_writer* writer, dl_ctx_t ctx, const dl_type_desc* type )
+{
+	const char* type_name = dl_internal_type_name( ctx, type );
+	dl_typeid_t tid = dl_internal_typeid_of( ctx, type );
+
+	if( type->member_count == 0 )
+	{
+		dl_binary_writer_write_string_fmt( writer, "static void %s_txt_pack( dl_txt_gen_pack_t ctx, size_t pos )\n"
+		                                           "{\n"
+		                                           "    (void)pos;\n"
+		                                           "    const char* key;\n"
+		                                           "    size_t key_len;\n"
+		                                           "    while( dl_txt_gen_pack_next_key( ctx, &key, &key_len ) )\n"
+		                                           "        dl_txt_gen_pack_unknown_key( ctx, 0x%08Xu, key, key_len );\n"
+		                                           "}\n\n", type_name, tid );
+		return;
+	}
+
+	dl_txt_gen_write_find_member( writer, ctx, type );
+
+	uint32_t set_words = ( type->member_count + 63 ) / 64;
+	dl_binary_writer_write_string_fmt( writer, "static void %s_txt_pack( dl_txt_gen_pack_t ctx, size_t pos )\n"
+	                                           "{\n"
+	                                           "    uint64_t set[%u] = { 0 };\n"
+	                                           "    const char* key;\n"
+	                                           "    size_t key_len;\n"
+	                                           "    while( dl_txt_gen_pack_next_key( ctx, &key, &key_len ) )\n"
+	                                           "    {\n"
+	                                           "        uint32_t member = %s_txt_find_member( key, key_len );\n"
+	                                           "        if( member == UINT32_MAX )\n"
+	                                           "        {\n"
+	                                           "            dl_txt_gen_pack_unknown_key( ctx, 0x%08Xu, key, key_len );\n"
+	                                           "            continue;\n"
+	                                           "        }\n"
+	                                           "        if( set[member / 64] & ( 1ULL << ( member %% 64 ) ) )\n"
+	                                           "            dl_txt_gen_pack_set_twice( ctx, 0x%08Xu, member );\n"
+	                                           "        set[member / 64] |= 1ULL << ( member %% 64 );\n"
+	                                           "\n"
+	                                           "        dl_txt_gen_pack_value_separator( ctx );\n"
+	                                           "        switch( member )\n"
+	                                           "        {\n", type_name, set_words, type_name, tid, tid );
+
+	for( uint32_t i = 0; i < type->member_count; ++i )
+	{
+		const dl_member_desc* member = dl_get_type_member( ctx, type, i );
+		const dl_type_desc* sub_type = dl_txt_gen_struct_member_type( ctx, member );
+		const char* pod_name = member->AtomType() == DL_TYPE_ATOM_POD ? dl_txt_gen_pod_name( member->StorageType() ) : 0x0;
+
+		dl_binary_writer_write_string_fmt( writer, "            case %u: ", i );
+		if( pod_name )
+		{
+			dl_binary_writer_write_string_fmt( writer, "dl_txt_gen_pack_%s( ctx, pos + ", pod_name );
+			dl_txt_gen_write_ptr_size_select( writer, member->offset[DL_PTR_SIZE_32BIT], member->offset[DL_PTR_SIZE_64BIT] );
+			dl_binary_writer_write_string_fmt( writer, " ); break;\n" );
+		}
+		else if( sub_type )
+		{
+			dl_binary_writer_write_string_fmt( writer, "if( dl_txt_gen_pack_begin_struct( ctx, 0x%08Xu, pos + ", member->type_id );
+			dl_txt_gen_write_ptr_size_select( writer, member->offset[DL_PTR_SIZE_32BIT], member->offset[DL_PTR_SIZE_64BIT] );
+			dl_binary_writer_write_string_fmt( writer, " ) ) %s_txt_pack( ctx, pos + ", dl_internal_type_name( ctx, sub_type ) );
+			dl_txt_gen_write_ptr_size_select( writer, member->offset[DL_PTR_SIZE_32BIT], member->offset[DL_PTR_SIZE_64BIT] );
+			dl_binary_writer_write_string_fmt( writer, " ); break;\n" );
+		}
+		else
+			dl_binary_writer_write_string_fmt( writer, "dl_txt_gen_pack_member( ctx, 0x%08Xu, %u, pos ); break;\n", tid, i );
+	}
+
+	dl_binary_writer_write_string_fmt( writer, "        }\n"
+	                                           "    }\n"
+	                                           "\n"
+	                                           "    if( " );
+	for( uint32_t word = 0; word < set_words; ++word )
+	{
+		uint32_t bits = type->member_count - word * 64 < 64 ? type->member_count - word * 64 : 64;
+		uint64_t all  = bits == 64 ? ~0ULL : ( 1ULL << bits ) - 1;
+		dl_binary_writer_write_string_fmt( writer, "%sset[%u] != 0x%llXULL", word == 0 ? "" : " || ", word, (unsigned long long)all );
+	}
+	dl_binary_writer_write_string_fmt( writer, " )\n"
+	                                           "        dl_txt_gen_pack_defaults( ctx, 0x%08Xu, pos, set );\n"
+	                                           "}\n\n", tid );
+}
+
+static void dl_txt_gen_write_unpack( dl_binary_writer* writer, dl_ctx_t ctx, const dl_type_desc* type )
+{
+	const char* type_name = dl_internal_type_name( ctx, type );
+	dl_typeid_t tid = dl_internal_typeid_of( ctx, type );
+
+	dl_binary_writer_write_string_fmt( writer, "static void %s_txt_unpack( dl_txt_gen_unpack_t ctx, const uint8_t* data )\n{\n", type_name );
+	if( type->member_count == 0 )
+		dl_binary_writer_write_string_fmt( writer, "    (void)ctx;\n"
+		                                           "    (void)data;\n" );
+
+	for( uint32_t i = 0; i < type->member_count; ++i )
+	{
+		const dl_member_desc* member = dl_get_type_member( ctx, type, i );
+		const dl_type_desc* sub_type = dl_txt_gen_struct_member_type( ctx, member );
+		const char* member_name = dl_internal_member_name( ctx, member );
+
+		const char* unpack_func = 0x0;
+		const char* c_type      = 0x0;
+		if( member->AtomType() == DL_TYPE_ATOM_POD )
+		{
+			switch( member->StorageType() )
+			{
+				case DL_TYPE_STORAGE_INT8:   unpack_func = "int64";  c_type = "int8_t";   break;
+				case DL_TYPE_STORAGE_INT16:  unpack_func = "int64";  c_type = "int16_t";  break;
+				case DL_TYPE_STORAGE_INT32:  unpack_func = "int64";  c_type = "int32_t";  break;
+				case DL_TYPE_STORAGE_INT64:  unpack_func = "int64";  c_type = "int64_t";  break;
+				case DL_TYPE_STORAGE_UINT8:  unpack_func = "uint64"; c_type = "uint8_t";  break;
+				case DL_TYPE_STORAGE_UINT16: unpack_func = "uint64"; c_type = "uint16_t"; break;
+				case DL_TYPE_STORAGE_UINT32: unpack_func = "uint64"; c_type = "uint32_t"; break;
+				case DL_TYPE_STORAGE_UINT64: unpack_func = "uint64"; c_type = "uint64_t"; break;
+				case DL_TYPE_STORAGE_FP32:   unpack_func = "fp32";   c_type = "float";    break;
+				case DL_TYPE_STORAGE_FP64:   unpack_func = "fp64";   c_type = "double";   break;
+				default:
+					break;
+			}
+		}
+
+		if( unpack_func )
+		{
+			dl_binary_writer_write_string_fmt( writer, "    dl_txt_gen_unpack_key( ctx, \"\\\"%s\\\"\", %u );\n", member_name, (unsigned int)strlen( member_name ) + 2 );
+			dl_binary_writer_write_string_fmt( writer, "    dl_txt_gen_unpack_%s( ctx, *(const %s*)( data + ", unpack_func, c_type );
+			dl_txt_gen_write_ptr_size_select( writer, member->offset[DL_PTR_SIZE_32BIT], member->offset[DL_PTR_SIZE_64BIT] );
+			dl_binary_writer_write_string_fmt( writer, " ) );\n" );
+		}
+		else if( sub_type )
+		{
+			dl_binary_writer_write_string_fmt( writer, "    dl_txt_gen_unpack_key( ctx, \"\\\"%s\\\"\", %u );\n", member_name, (unsigned int)strlen( member_name ) + 2 );
+			dl_binary_writer_write_string_fmt( writer, "    dl_txt_gen_unpack_begin_struct( ctx );\n"
+			                                           "    %s_txt_unpack( ctx, data + ", dl_internal_type_name( ctx, sub_type ) );
+			dl_txt_gen_write_ptr_size_select( writer, member->offset[DL_PTR_SIZE_32BIT], member->offset[DL_PTR_SIZE_64BIT] );
+			dl_binary_writer_write_string_fmt( writer, " );\n"
+			                                           "    dl_txt_gen_unpack_end_struct( ctx );\n" );
+		}
+		else
+			dl_binary_writer_write_string_fmt( writer, "    dl_txt_gen_unpack_member( ctx, 0x%08Xu, %u, data );\n", tid, i );
+
+		dl_binary_writer_write_string_fmt( writer, "    dl_txt_gen_unpack_end_member( ctx, %d );\n", i == type->member_count - 1 ? 1 : 0 );
+	}
+	dl_binary_writer_write_string_fmt( writer, "}\n\n" );
+}
+
+dl_error_t dl_context_write_type_library_txt_gen( dl_ctx_t dl_ctx, const char* module_name, char* out_header, size_t out_header_size, size_t* produced_bytes )
+{
+	// ... module name is used in identifiers, skip file-extension and replace everything that can't be part of an identifier ...
+	char module[128];
+	char MODULE[128];
+	size_t pos = 0;
+	for( const char* iter = module_name; *iter && *iter != '.' && pos < 127; ++iter, ++pos )
+	{
+		module[pos] = isalnum( *iter ) ? *iter : '_';
+		MODULE[pos] = (char)toupper( module[pos] );
+	}
+	module[pos] = '\0';
+	MODULE[pos] = '\0';
+
+	dl_binary_writer writer;
+	dl_binary_writer_init( &writer, (uint8_t*)out_header, out_header_size, out_header == 0x0, DL_ENDIAN_HOST, DL_ENDIAN_HOST, DL_PTR_SIZE_HOST );
+
+	dl_binary_writer_write_string_fmt( &writer, "/* Auto generated text pack/unpack-routines for dl type library, register with %s_txt_gen_register() */\n"
+	                                            "#ifndef __DL_AUTOGEN_TXT_GEN_%s_INCLUDED\n"
+	                                            "#define __DL_AUTOGEN_TXT_GEN_%s_INCLUDED\n\n"
+	                                            "#include <dl/dl_txt_gen.h>\n\n", module, MODULE, MODULE );
+
+	// ... declare all routines first as struct-members call the routines of their type directly ...
+	for( unsigned int i = 0; i < dl_ctx->type_count; ++i )
+	{
+		const dl_type_desc* type = dl_ctx->type_descs + i;
+		if( !dl_txt_gen_has_routines( type ) )
+			continue;
+		const char* type_name = dl_internal_type_name( dl_ctx, type );
+		dl_binary_writer_write_string_fmt( &writer, "static void %s_txt_pack( dl_txt_gen_pack_t ctx, size_t pos );\n"
+		                                            "static void %s_txt_unpack( dl_txt_gen_unpack_t ctx, const uint8_t* data );\n", type_name, type_name );
+	}
+	dl_binary_writer_write_string_fmt( &writer, "\n" );
+
+	for( unsigned int i = 0; i < dl_ctx->type_count; ++i )
+	{
+		const dl_type_desc* type = dl_ctx->type_descs + i;
+		if( !dl_txt_gen_has_routines( type ) )
+			continue;
+		dl_txt_gen_write_pack( &writer, dl_ctx, type );
+		dl_txt_gen_write_unpack( &writer, dl_ctx, type );
+	}
+
+	dl_binary_writer_write_string_fmt( &writer, "static inline dl_error_t %s_txt_gen_register( dl_ctx_t dl_ctx )\n{\n", module );
+	unsigned int registered = 0;
+	for( unsigned int i = 0; i < dl_ctx->type_count; ++i )
+	{
+		const dl_type_desc* type = dl_ctx->type_descs + i;
+		if( !dl_txt_gen_has_routines( type ) )
+			continue;
+		const char* type_name = dl_internal_type_name( dl_ctx, type );
+		if( registered++ == 0 )
+			dl_binary_writer_write_string_fmt( &writer, "    static const dl_txt_gen_type TYPES[] = {\n" );
+		dl_binary_writer_write_string_fmt( &writer, "        { 0x%08Xu, ", dl_internal_typeid_of( dl_ctx, type ) );
+		dl_txt_gen_write_ptr_size_select( &writer, type->size[DL_PTR_SIZE_32BIT], type->size[DL_PTR_SIZE_64BIT] );
+		dl_binary_writer_write_string_fmt( &writer, ", %u, %s_txt_pack, %s_txt_unpack },\n", type->member_count, type_name, type_name );
+	}
+	if( registered > 0 )
+		dl_binary_writer_write_string_fmt( &writer, "    };\n"
+		                                            "    return dl_txt_gen_register( dl_ctx, TYPES, sizeof(TYPES) / sizeof(TYPES[0]) );\n" );
+	else
+		dl_binary_writer_write_string_fmt( &writer, "    return dl_txt_gen_register( dl_ctx, 0x0, 0 );\n" );
+	dl_binary_writer_write_string_fmt( &writer, "}\n\n"
+	                                            "#endif // __DL_AUTOGEN_TXT_GEN_%s_INCLUDED\n", MODULE );
+
+	if( produced_bytes )
+		*produced_bytes = dl_binary_writer_needed_size( &writer );
+
+	return DL_ERROR_OK;
+}
@@ -11,12 +11,16 @@
 #include <stdint.h>
 
 #include <dl/dl.h>
+#include <dl/dl_txt.h>
+#include <dl/dl_txt_gen.h>
+#include <dl/dl_bin_gen.h>
 #include "dl_config.h"
 #include "dl_alloc.h"
 #include "dl_swap.h"
 
 #include <stdarg.h> // for va_list
 #include <new> // for inplace new
+#include <utility> // for std::move
 
 #define DL_BITMASK(_Bits)                   ( (1ULL << (_Bits)) - 1ULL )
 #define DL_BITRANGE(_MinBit,_MaxBit)		( ((1ULL << (_MaxBit)) | ((1ULL << (_MaxBit))-1ULL)) ^ ((1ULL << (_MinBit))-1ULL) )
@@ -47,8 +51,8 @@
 	#define DL_UNUSED
 #endif
 
-static const uint32_t DL_UNUSED DL_TYPELIB_VERSION         = 4; // format version for type-libraries.
-static const uint32_t DL_UNUSED DL_INSTANCE_VERSION        = 1; // format version for instances.
+static const uint32_t DL_UNUSED DL_TYPELIB_VERSION         = 5; // format version for type-libraries.
+static const uint32_t DL_UNUSED DL_INSTANCE_VERSION        = 2; // format version for instances.
 static const uint32_t DL_UNUSED DL_INSTANCE_VERSION_SWAPED = dl_swap_endian_uint32( DL_INSTANCE_VERSION );
 static const uint32_t DL_UNUSED DL_TYPELIB_ID              = ('D'<< 24) | ('L' << 16) | ('T' << 8) | 'L';
 static const uint32_t DL_UNUSED DL_TYPELIB_ID_SWAPED       = dl_swap_endian_uint32( DL_TYPELIB_ID );
@@ -101,6 +105,7 @@ struct dl_typelib_header
 	uint32_t type_count;		// number of types in typelibrary
 	uint32_t enum_count;		// number of enums in typelibrary
 	uint32_t member_count;
+	uint32_t member_lookup_count;	// number of dl_member_lookup_entry:s in typelibrary
 	uint32_t enum_value_count;
 	uint32_t enum_alias_count;
 
@@ -116,9 +121,42 @@ struct dl_data_header
 	dl_typeid_t root_instance_type;
 	uint32_t    instance_size;
 	uint8_t     is_64_bit_ptr; // currently uses uint8 instead of bitfield to be compiler-compliant.
-	uint8_t     pad[7];
+	uint8_t     flags;         // combination of dl_data_header_flags.
+	uint8_t     pad[2];
+	uint32_t    reloc_count;   // number of entries in the relocation table, only valid if DL_DATA_HEADER_FLAG_HAS_RELOC_TABLE is set.
 };
 
+enum dl_data_header_flags
+{
+	DL_DATA_HEADER_FLAG_HAS_RELOC_TABLE = 1 << 0, ///< instance is followed by a table of uint32 offsets to all pointers in the instance, 4-byte aligned.
+	DL_DATA_HEADER_FLAG_SELF_RELATIVE   = 1 << 1, ///< all pointers in the instance are stored as offsets relative to the pointer itself, see dl_instance_make_self_relative().
+};
+
+/**
+ * Value stored in a null-pointer in a self-relative instance. 0 can not be used since a pointer might point to
+ * itself, i.e. a ptr-member first in the root-instance pointing back to the root. No pointer can point 1 byte into
+ * itself.
+ */
+static const intptr_t DL_SELF_RELATIVE_NULL_OFFSET = 1;
+
+/**
+ * Offset from start of instance-data ( i.e. after the header ) to the relocation table.
+ */
+static inline uint32_t dl_internal_reloc_table_offset( const dl_data_header* header )
+{
+	return ( header->instance_size + 3u ) & ~3u;
+}
+
+/**
+ * Total size of a packed instance, header and relocation table included.
+ */
+static inline size_t dl_internal_packed_instance_size( const dl_data_header* header )
+{
+	if( header->flags & DL_DATA_HEADER_FLAG_HAS_RELOC_TABLE )
+		return sizeof(dl_data_header) + dl_internal_reloc_table_offset( header ) + header->reloc_count * sizeof(uint32_t);
+	return sizeof(dl_data_header) + header->instance_size;
+}
+
 enum dl_ptr_size_t
 {
 	DL_PTR_SIZE_32BIT = 0,
@@ -241,7 +279,18 @@ struct dl_type_desc
 	uint32_t member_count;
 	uint32_t member_start;
 	uint32_t comment;
+	uint32_t member_lookup_start; ///< first entry in dl_context::member_lookup for this type.
+	uint32_t member_lookup_cap;   ///< number of entries in member-lookup for this type, always 0 or a power of 2.
+};
 
+/**
+ * Slot in the per-type open-addressed table mapping a hashed member-name to member index in the type.
+ * Empty slots have member_index set to UINT32_MAX.
+ */
+struct dl_member_lookup_entry
+{
+	uint32_t name_hash;
+	uint32_t member_index;
 };
 
 struct dl_enum_value_desc
@@ -269,6 +318,97 @@ struct dl_enum_alias_desc
 	uint32_t value_index; ///< index of the value this alias belong to.
 };
 
+/**
+ * Open-addressed hash-table mapping a typeid to its index in dl_context::type_ids/enum_ids.
+ * Slots store the index into the id-array, the key is read back from there, so an empty slot is
+ * marked with UINT32_MAX.
+ */
+struct dl_typeid_lookup
+{
+	uint32_t* slots;
+	uint32_t  capacity; ///< always 0 or a power of 2.
+	uint32_t  count;
+};
+
+/**
+ * Generated text pack/unpack-routines registered for a type, see dl_txt_gen_register().
+ */
+struct dl_txt_gen_funcs
+{
+	dl_txt_gen_pack_func   pack;
+	dl_txt_gen_unpack_func unpack;
+};
+
+/**
+ * Generated store/patch-routines registered for a type, see dl_bin_gen_register().
+ */
+struct dl_bin_gen_funcs
+{
+	dl_bin_gen_store_func store;
+	dl_bin_gen_patch_func patch;
+};
+
+/**
+ * Host-only part of dl_type_desc used by the runtime walkers, built by dl_internal_prepare_types(). dl_type_desc is
+ * kept for reflection, conversion and tools.
+ */
+struct dl_type_hot
+{
+	uint32_t flags;     ///< same as dl_type_desc::flags.
+	uint32_t size;      ///< size on the host.
+	uint32_t alignment; ///< alignment on the host.
+};
+
+/**
+ * Host-only part of dl_member_desc used by the runtime walkers, built by dl_internal_prepare_types().
+ */
+struct dl_member_hot
+{
+	uint32_t offset;   ///< offset on the host.
+	uint32_t size;     ///< size on the host.
+	uint32_t sub_type; ///< index of the sub-type in dl_context::type_descs, UINT32_MAX if the member has none or it is not loaded.
+};
+
+/**
+ * Member that need work when an instance is walked, i.e. when it is stored, patched, converted or unpacked.
+ */
+struct dl_type_plan_op
+{
+	dl_type_t type;      ///< type of the member, same as dl_member_desc::type.
+	uint32_t  member;    ///< index of the member in dl_context::member_descs.
+	uint32_t  sub_type;  ///< index of the sub-type in dl_context::type_descs, UINT32_MAX if the member has none or it is not loaded.
+	uint32_t  count;     ///< number of elements for inline arrays, 1 otherwise.
+	uint32_t  offset[2]; ///< offset of the member in the walked instance, members of flattened sub-structs include the offset of the sub-struct.
+
+	dl_type_atom_t    AtomType()    const { return dl_type_atom_t( (type & DL_TYPE_ATOM_MASK) >> DL_TYPE_ATOM_MIN_BIT); }
+	dl_type_storage_t StorageType() const { return dl_type_storage_t( (type & DL_TYPE_STORAGE_MASK) >> DL_TYPE_STORAGE_MIN_BIT); }
+};
+
+/**
+ * Range of an instance, on the host, that is written as is when the instance is stored.
+ */
+struct dl_type_plan_copy
+{
+	uint32_t offset;
+	uint32_t size;
+};
+
+/**
+ * Walk-plan for a type, compiled by dl_internal_prepare_types() when type-libraries are loaded.
+ * Plain data members, bitfield-groups and sub-structs without subdata are collapsed into copies, only members
+ * that need work are kept as ops with their sub-type resolved. The plan for a union is empty, unions are walked
+ * by their active member.
+ */
+struct dl_type_plan
+{
+	uint32_t copy_start; ///< first entry in dl_context::plan_copies.
+	uint32_t copy_count;
+	uint32_t op_start;   ///< first entry in dl_context::plan_ops.
+	uint32_t op_count;
+	uint32_t union_type_offset[2]; ///< offset of the type-member per ptr-size if the type is a union, 0 otherwise.
+	bool     ends_with_copy;       ///< the last member, in member order, is part of a copy and not an op.
+};
+
 struct dl_context
 {
 	dl_allocator alloc;
@@ -276,15 +416,22 @@ struct dl_context
 	dl_error_msg_handler error_msg_func;
 	void*                error_msg_ctx;
 
+	bool store_reloc_table; ///< write relocation table after instances in dl_instance_store and dl_txt_pack.
+
+	unsigned int txt_unpack_flags;  ///< dl_txt_unpack_flags_t used by dl_txt_unpack.
+	unsigned int txt_unpack_indent; ///< spaces per indentation-level written by dl_txt_unpack.
+
 	unsigned int type_count;
 	unsigned int enum_count;
 	unsigned int member_count;
+	unsigned int member_lookup_count;
 	unsigned int enum_value_count;
 	unsigned int enum_alias_count;
 
 	size_t type_capacity;
 	size_t enum_capacity;
 	size_t member_capacity;
+	size_t member_lookup_capacity;
 	size_t enum_value_capacity;
 	size_t enum_alias_capacity;
 
@@ -293,10 +440,14 @@ struct dl_context
 
 	dl_type_desc*       type_descs;    ///< list of all loaded descriptors for types.
 	dl_member_desc*     member_descs; ///< list of all loaded descriptors for members in types.
+	dl_member_lookup_entry* member_lookup; ///< per-type member-name lookup tables, see dl_type_desc::member_lookup_start.
 	dl_enum_desc*       enum_descs;
 	dl_enum_value_desc* enum_value_descs;
 	dl_enum_alias_desc* enum_alias_descs;
 
+	dl_typeid_lookup type_lookup; ///< typeid -> index in type_ids/type_descs.
+	dl_typeid_lookup enum_lookup; ///< typeid -> index in enum_ids/enum_descs.
+
 	char*  typedata_strings;
 	size_t typedata_strings_size;
 	size_t typedata_strings_cap;
@@ -307,6 +458,22 @@ struct dl_context
 
 	uint8_t* default_data;
 	size_t   default_data_size;
+
+	dl_txt_gen_funcs* txt_gen;       ///< generated text-routines per type in the same order as type_descs, pack/unpack is 0x0 for types without.
+	size_t            txt_gen_count; ///< number of entries in txt_gen, types loaded after the last dl_txt_gen_register() have no entry.
+
+	dl_bin_gen_funcs* bin_gen;       ///< generated store/patch-routines per type in the same order as type_descs, store/patch is 0x0 for types without.
+	size_t            bin_gen_count; ///< number of entries in bin_gen, types loaded after the last dl_bin_gen_register() have no entry.
+
+	dl_type_plan*      type_plans;      ///< walk-plan per type in the same order as type_descs, see dl_internal_prepare_types().
+	unsigned int       type_plan_count; ///< number of entries in type_plans.
+	dl_type_plan_op*   plan_ops;        ///< ops of all type_plans.
+	dl_type_plan_copy* plan_copies;     ///< copies of all type_plans.
+
+	dl_type_hot*   type_hot;         ///< host-only descriptors in the same order as type_descs, see dl_internal_prepare_types().
+	unsigned int   type_hot_count;   ///< number of entries in type_hot.
+	dl_member_hot* member_hot;       ///< host-only descriptors in the same order as member_descs, see dl_internal_prepare_types().
+	unsigned int   member_hot_count; ///< number of entries in member_hot.
 };
 
 struct dl_substr
@@ -367,6 +534,11 @@ public:
 		return m_nElements;
 	}
 
+	inline void Clear()
+	{
+		m_nElements = 0;
+	}
+
 	void Add(const T& _Element)
 	{
 		GrowIfNeeded();
@@ -393,6 +565,103 @@ public:
 	}
 };
 
+// An open-addressed hash-index mapping a 32-bit hash to indices in some other array, for example a CArrayStatic. As CArrayStatic it
+// use a stack buffer while small and fall back to heap via the allocator when it grows past that. The index itself do not know how to
+// compare elements, that is left to the predicate passed to Find(). SIZE need to be a power of 2.
+template <int SIZE>
+class CHashIndexStatic
+{
+private:
+	struct SSlot
+	{
+		uint32_t hash;
+		uint32_t index; // UINT32_MAX for empty slots.
+	};
+
+	inline void InsertNoGrow(uint32_t hash, uint32_t index)
+	{
+		size_t mask = m_nCapacity - 1;
+		size_t slot = hash & mask;
+		while (m_Ptr[slot].index != UINT32_MAX)
+			slot = (slot + 1) & mask;
+		m_Ptr[slot].hash  = hash;
+		m_Ptr[slot].index = index;
+		++m_nElements;
+	}
+
+	inline void GrowIfNeeded()
+	{
+		// keep load-factor below 3/4
+		if ((m_nElements + 1) * 4 <= m_nCapacity * 3)
+			return;
+
+		SSlot* old_slots = m_Ptr;
+		size_t old_cap   = m_nCapacity;
+
+		m_nCapacity *= 2;
+		m_nElements  = 0;
+		m_Ptr = reinterpret_cast<SSlot*>(dl_alloc(&m_Allocator, sizeof(SSlot) * m_nCapacity));
+		memset(m_Ptr, 0xFF, sizeof(SSlot) * m_nCapacity);
+
+		for (size_t i = 0; i < old_cap; ++i)
+			if (old_slots[i].index != UINT32_MAX)
+				InsertNoGrow(old_slots[i].hash, old_slots[i].index);
+
+		if (old_slots != &m_Storage[0])
+			dl_free(&m_Allocator, old_slots);
+	}
+
+public:
+	SSlot* m_Ptr;
+	SSlot m_Storage[SIZE];
+	size_t m_nElements;
+	size_t m_nCapacity;
+	dl_allocator m_Allocator;
+
+	explicit CHashIndexStatic(dl_allocator allocator)
+	{
+		m_nElements = 0;
+		m_nCapacity = SIZE;
+		m_Ptr = &m_Storage[0];
+		m_Allocator = allocator;
+		memset(m_Storage, 0xFF, sizeof(m_Storage));
+	}
+
+	~CHashIndexStatic()
+	{
+		if (m_Ptr != &m_Storage[0])
+		{
+			dl_free(&m_Allocator, m_Ptr);
+		}
+	}
+
+	void Insert(uint32_t hash, uint32_t index)
+	{
+		GrowIfNeeded();
+		InsertNoGrow(hash, index);
+	}
+
+	// Return the first inserted index with matching hash for which pred(index) is true or UINT32_MAX if there is none.
+	template <typename PRED>
+	uint32_t Find(uint32_t hash, PRED pred) const
+	{
+		size_t mask = m_nCapacity - 1;
+		for (size_t slot = hash & mask; m_Ptr[slot].index != UINT32_MAX; slot = (slot + 1) & mask)
+			if (m_Ptr[slot].hash == hash && pred(m_Ptr[slot].index))
+				return m_Ptr[slot].index;
+		return UINT32_MAX;
+	}
+};
+
+static inline uint32_t dl_internal_hash_pointer( const void* ptr )
+{
+	uint64_t h = (uint64_t)(uintptr_t)ptr;
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDULL;
+	h ^= h >> 33;
+	return (uint32_t)h;
+}
+
 #if defined( __GNUC__ )
 inline void dl_log_error( dl_ctx_t dl_ctx, const char* fmt, ... ) __attribute__((format( printf, 2, 3 )));
 #endif
@@ -425,16 +694,80 @@ inline unsigned int dl_bf_offset( dl_endian_t endian, unsigned int bf_size, unsi
 
 static inline dl_endian_t dl_other_endian( dl_endian_t endian ) { return endian == DL_ENDIAN_LITTLE ? DL_ENDIAN_BIG : DL_ENDIAN_LITTLE; }
 
+static inline uint32_t dl_internal_typeid_lookup_hash( dl_typeid_t type_id )
+{
+	// typeid:s are already hashes, but might be user-supplied so mix them a bit before using the low bits.
+	uint32_t h = type_id * 0x9E3779B1u;
+	return h ^ ( h >> 16 );
+}
+
+/**
+ * Find index of type_id in ids by use of lookup.
+ * @return index in ids or UINT32_MAX if not found.
+ */
+static inline uint32_t dl_internal_typeid_lookup_find( const dl_typeid_lookup* lookup, const dl_typeid_t* ids, dl_typeid_t type_id )
+{
+	if( lookup->capacity == 0 )
+		return UINT32_MAX;
+
+	uint32_t mask = lookup->capacity - 1;
+	for( uint32_t slot = dl_internal_typeid_lookup_hash( type_id ) & mask; ; slot = ( slot + 1 ) & mask )
+	{
+		uint32_t index = lookup->slots[slot];
+		if( index == UINT32_MAX || ids[index] == type_id )
+			return index;
+	}
+}
+
+/**
+ * Add ids[index] to lookup, growing the table via alloc if needed. If the typeid is already in the
+ * table the first added index is kept.
+ */
+void dl_internal_typeid_lookup_insert( dl_allocator* alloc, dl_typeid_lookup* lookup, const dl_typeid_t* ids, uint32_t index );
+
+/**
+ * Remove ids[index] from lookup, used when a type is "popped" from the context.
+ */
+void dl_internal_typeid_lookup_remove( dl_typeid_lookup* lookup, const dl_typeid_t* ids, uint32_t index );
+
 static inline const dl_type_desc* dl_internal_find_type(dl_ctx_t dl_ctx, dl_typeid_t type_id)
 {
-	// linear search right now!
-    for(unsigned int i = 0; i < dl_ctx->type_count; ++i)
-    	if( dl_ctx->type_ids[i] == type_id )
-    		return &dl_ctx->type_descs[i];
+	uint32_t index = dl_internal_typeid_lookup_find( &dl_ctx->type_lookup, dl_ctx->type_ids, type_id );
+	return index == UINT32_MAX ? 0x0 : &dl_ctx->type_descs[index];
+}
+
+/**
+ * Return the generated text-routines registered for type or 0x0 if there are none.
+ */
+static inline const dl_txt_gen_funcs* dl_internal_find_txt_gen( dl_ctx_t dl_ctx, const dl_type_desc* type )
+{
+	size_t index = (size_t)( type - dl_ctx->type_descs );
+	return index < dl_ctx->txt_gen_count ? &dl_ctx->txt_gen[index] : 0x0;
+}
 
-    return 0x0;
+/**
+ * Return the generated store/patch-routines registered for type or 0x0 if there are none.
+ */
+static inline const dl_bin_gen_funcs* dl_internal_find_bin_gen( dl_ctx_t dl_ctx, const dl_type_desc* type )
+{
+	size_t index = (size_t)( type - dl_ctx->type_descs );
+	return index < dl_ctx->bin_gen_count ? &dl_ctx->bin_gen[index] : 0x0;
 }
 
+/**
+ * Same as dl_instance_load_inplace() but with the header stored separately from the instance-data, i.e. instance_data
+ * is everything that follows the header in a packed instance. Used to read packed instances straight to their final
+ * location without the header in front.
+ */
+dl_error_t dl_internal_instance_load_detached_header( dl_ctx_t dl_ctx,        dl_typeid_t type_id, const dl_data_header* header,
+													  uint8_t* instance_data, size_t      instance_data_size );
+
+/**
+ * Same as dl_txt_pack_stream() but with the packed instance allocated via alloc instead of the allocator of dl_ctx.
+ */
+dl_error_t dl_internal_txt_pack_stream( dl_ctx_t        dl_ctx,     dl_txt_read_func read_func, void* read_ctx, dl_allocator* alloc,
+										unsigned char** out_buffer, size_t*          out_buffer_size );
+
 static inline const char* dl_internal_type_name         ( dl_ctx_t ctx, const dl_type_desc*       type   ) { return &ctx->typedata_strings[type->name]; }
 static inline const char* dl_internal_type_comment      ( dl_ctx_t ctx, const dl_type_desc*       type   ) { return type->comment != UINT32_MAX ? &ctx->typedata_strings[type->comment] : 0x0; }
 static inline const char* dl_internal_member_name       ( dl_ctx_t ctx, const dl_member_desc*     member ) { return &ctx->typedata_strings[member->name]; }
@@ -509,6 +842,14 @@ static inline size_t dl_pod_size( dl_type_storage_t storage )
 	}
 }
 
+/**
+ * Returns true if storage is an integer or floating point type, arrays of these can be written as raw bytes in text.
+ */
+static inline bool dl_is_number_storage( dl_type_storage_t storage )
+{
+	return storage <= DL_TYPE_STORAGE_FP64;
+}
+
 static inline dl_typeid_t dl_internal_typeid_of( dl_ctx_t dl_ctx, const dl_type_desc* type )
 {
 	return dl_ctx->type_ids[ type - dl_ctx->type_descs ];
@@ -516,11 +857,8 @@ static inline dl_typeid_t dl_internal_typeid_of( dl_ctx_t dl_ctx, const dl_type_
 
 static inline const dl_enum_desc* dl_internal_find_enum( dl_ctx_t dl_ctx, dl_typeid_t type_id )
 {
-	for( unsigned int i = 0; i < dl_ctx->enum_count; ++i )
-		if( dl_ctx->enum_ids[i] == type_id )
-			return &dl_ctx->enum_descs[i];
-
-	return 0x0;
+	uint32_t index = dl_internal_typeid_lookup_find( &dl_ctx->enum_lookup, dl_ctx->enum_ids, type_id );
+	return index == UINT32_MAX ? 0x0 : &dl_ctx->enum_descs[index];
 }
 
 static inline const dl_member_desc* dl_get_type_member( dl_ctx_t ctx, const dl_type_desc* type, unsigned int member_index )
@@ -534,10 +872,13 @@ static inline const dl_member_desc* dl_internal_union_type_to_member( dl_ctx_t d
 	return dl_get_type_member(dl_ctx, type, union_type - dl_internal_typeid_of(dl_ctx, type) - 1);
 }
 
-static inline uint32_t dl_internal_union_type_offset(dl_ctx_t ctx, const dl_type_desc* type, dl_ptr_size_t ptr_size)
+/**
+ * Calculate the offset of the type-member of a union, use dl_internal_union_type_offset() at runtime.
+ */
+static inline uint32_t dl_internal_calc_union_type_offset(dl_ctx_t ctx, const dl_type_desc* type, dl_ptr_size_t ptr_size)
 {
-	uint32_t max_member_size = 0; // TODO: calc and store this in type?
-	uint32_t max_member_alignment = 0; // TODO: calc and store this in type?
+	uint32_t max_member_size = 0;
+	uint32_t max_member_alignment = 0;
 	for( uint32_t member_index = 0; member_index < type->member_count; ++member_index )
 	{
 		const dl_member_desc* member = dl_get_type_member( ctx, type, member_index );
@@ -548,6 +889,84 @@ static inline uint32_t dl_internal_union_type_offset(dl_ctx_t ctx, const dl_type
 	return dl_internal_align_up(max_member_size, max_member_alignment);
 }
 
+/**
+ * Build host-only descriptors, resolve sub-types of all members and compile walk-plans for all loaded types, called
+ * when a type-library has been loaded. Already loaded types are prepared again as well since they might refer to types
+ * that were not loaded until now.
+ */
+void dl_internal_prepare_types( dl_ctx_t ctx );
+
+static inline const dl_type_plan* dl_internal_type_plan( dl_ctx_t ctx, const dl_type_desc* type )
+{
+	size_t index = (size_t)( type - ctx->type_descs );
+	DL_ASSERT( index < ctx->type_plan_count && "type is not prepared, dl_internal_prepare_types() not called after load?" );
+	return &ctx->type_plans[index];
+}
+
+static inline const dl_type_hot* dl_internal_type_hot( dl_ctx_t ctx, const dl_type_desc* type )
+{
+	size_t index = (size_t)( type - ctx->type_descs );
+	DL_ASSERT( index < ctx->type_hot_count && "type is not prepared, dl_internal_prepare_types() not called after load?" );
+	return &ctx->type_hot[index];
+}
+
+static inline const dl_member_hot* dl_internal_member_hot( dl_ctx_t ctx, const dl_member_desc* member )
+{
+	size_t index = (size_t)( member - ctx->member_descs );
+	DL_ASSERT( index < ctx->member_hot_count && "member is not prepared, dl_internal_prepare_types() not called after load?" );
+	return &ctx->member_hot[index];
+}
+
+static inline const dl_type_desc* dl_internal_plan_op_sub_type( dl_ctx_t ctx, const dl_type_plan_op* op )
+{
+	return op->sub_type == UINT32_MAX ? 0x0 : &ctx->type_descs[op->sub_type];
+}
+
+/**
+ * Offset of the type-member of a union, calculated when the type was loaded.
+ */
+static inline uint32_t dl_internal_union_type_offset( dl_ctx_t ctx, const dl_type_desc* type, dl_ptr_size_t ptr_size )
+{
+	DL_ASSERT( type->flags & DL_TYPE_FLAG_IS_UNION );
+	return dl_internal_type_plan( ctx, type )->union_type_offset[ptr_size];
+}
+
+/**
+ * Return the sub-type of member, resolved when the type-library was loaded, or 0x0 if member has no sub-type.
+ */
+static inline const dl_type_desc* dl_internal_member_sub_type( dl_ctx_t ctx, const dl_member_desc* member )
+{
+	size_t index = (size_t)( member - ctx->member_descs );
+	if( index < ctx->member_hot_count )
+	{
+		uint32_t sub_type = ctx->member_hot[index].sub_type;
+		return sub_type == UINT32_MAX ? 0x0 : &ctx->type_descs[sub_type];
+	}
+	// ... members added after dl_internal_prepare_types(), i.e. the temporary type used when packing default-values ...
+	return dl_internal_find_type( ctx, member->type_id );
+}
+
+/**
+ * Build an op for member outside of a plan, used when walking the active member of a union.
+ */
+static inline dl_type_plan_op dl_internal_plan_op_from_member( dl_ctx_t ctx, const dl_member_desc* member )
+{
+	dl_type_plan_op op;
+	op.type      = member->type;
+	op.member    = (uint32_t)( member - ctx->member_descs );
+	op.sub_type  = UINT32_MAX;
+	op.count     = member->AtomType() == DL_TYPE_ATOM_INLINE_ARRAY ? member->inline_array_cnt() : 1;
+	op.offset[DL_PTR_SIZE_32BIT] = member->offset[DL_PTR_SIZE_32BIT];
+	op.offset[DL_PTR_SIZE_64BIT] = member->offset[DL_PTR_SIZE_64BIT];
+	if( member->StorageType() == DL_TYPE_STORAGE_STRUCT || member->StorageType() == DL_TYPE_STORAGE_PTR )
+	{
+		const dl_type_desc* sub_type = dl_internal_member_sub_type( ctx, member );
+		if( sub_type != 0x0 )
+			op.sub_type = (uint32_t)( sub_type - ctx->type_descs );
+	}
+	return op;
+}
+
 static inline const dl_enum_value_desc* dl_get_enum_value( dl_ctx_t ctx, const dl_enum_desc* e, unsigned int value_index )
 {
 	return ctx->enum_value_descs + e->value_start + value_index;
@@ -560,11 +979,64 @@ static inline const dl_enum_alias_desc* dl_get_enum_alias( dl_ctx_t ctx, const d
 
 static inline unsigned int dl_internal_find_member( dl_ctx_t ctx, const dl_type_desc* type, dl_typeid_t name_hash )
 {
-	for(unsigned int i = 0; i < type->member_count; ++i)
-		if( dl_internal_hash_string( dl_internal_member_name( ctx, dl_get_type_member( ctx, type, i ) ) ) == name_hash )
-			return i;
+	if( type->member_lookup_cap == 0 )
+	{
+		// no lookup built for type, only the case for temporary types while loading a typelib.
+		for(unsigned int i = 0; i < type->member_count; ++i)
+			if( dl_internal_hash_string( dl_internal_member_name( ctx, dl_get_type_member( ctx, type, i ) ) ) == name_hash )
+				return i;
+		return type->member_count + 1;
+	}
+
+	const dl_member_lookup_entry* lookup = ctx->member_lookup + type->member_lookup_start;
+	uint32_t mask = type->member_lookup_cap - 1;
+	for( uint32_t slot = dl_internal_typeid_lookup_hash( name_hash ) & mask; ; slot = ( slot + 1 ) & mask )
+	{
+		if( lookup[slot].member_index == UINT32_MAX )
+			return type->member_count + 1;
+		if( lookup[slot].name_hash == name_hash )
+			return lookup[slot].member_index;
+	}
+}
+
+/**
+ * Number of slots needed in a member-lookup for a type with member_count members, keeps load-factor at or below 1/2.
+ */
+static inline uint32_t dl_internal_member_lookup_cap( uint32_t member_count )
+{
+	uint32_t cap = 2;
+	while( cap < member_count * 2 )
+		cap *= 2;
+	return cap;
+}
+
+/**
+ * Fill lookup, with member_lookup_cap slots, with the names of all members of type.
+ */
+static inline void dl_internal_build_member_lookup( dl_ctx_t ctx, const dl_type_desc* type, dl_member_lookup_entry* lookup )
+{
+	uint32_t mask = type->member_lookup_cap - 1;
+	for( uint32_t i = 0; i < type->member_lookup_cap; ++i )
+	{
+		lookup[i].name_hash    = 0;
+		lookup[i].member_index = UINT32_MAX;
+	}
 
-	return type->member_count + 1;
+	for( uint32_t i = 0; i < type->member_count; ++i )
+	{
+		uint32_t name_hash = dl_internal_hash_string( dl_internal_member_name( ctx, dl_get_type_member( ctx, type, i ) ) );
+		for( uint32_t slot = dl_internal_typeid_lookup_hash( name_hash ) & mask; ; slot = ( slot + 1 ) & mask )
+		{
+			if( lookup[slot].member_index == UINT32_MAX )
+			{
+				lookup[slot].name_hash    = name_hash;
+				lookup[slot].member_index = i;
+				break;
+			}
+			if( lookup[slot].name_hash == name_hash )
+				break; // first member wins, same as a linear search.
+		}
+	}
 }
 
 static inline bool dl_internal_find_enum_value( dl_ctx_t ctx, const dl_enum_desc* e, const char* name, size_t name_len, uint64_t* value )
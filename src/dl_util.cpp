@@ -7,13 +7,30 @@
 #include "dl_types.h"
 
 #include <stdio.h>
-
-static unsigned char* dl_read_entire_stream( dl_allocator *allocator, FILE* file, size_t* out_size )
+#include <string.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  define NOMINMAX
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+/**
+ * Read all of file to a buffer allocated with allocator, the buffer starts with the prefix_size bytes in prefix that
+ * has already been read from the file.
+ */
+static unsigned char* dl_read_entire_stream( dl_allocator *allocator, FILE* file, const unsigned char* prefix, size_t prefix_size, size_t* out_size )
 {
 	const unsigned int CHUNK_SIZE = 1024;
-	size_t         total_size = 0;
+	size_t         total_size = prefix_size;
 	size_t         chunk_size = 0;
-	unsigned char* out_buffer = 0;
+	unsigned char* out_buffer = (unsigned char*)dl_alloc( allocator, prefix_size );
+	memcpy( out_buffer, prefix, prefix_size );
 
 	do
 	{
@@ -45,6 +62,32 @@ dl_error_t dl_util_load_from_file( dl_ctx_t dl_ctx,     		dl_typeid_t         ty
 	return error;
 }
 
+struct dl_util_stream_reader
+{
+	FILE*         stream;
+	unsigned char peek[sizeof(dl_data_header)];
+	size_t        peek_size;
+	size_t        peek_pos;
+};
+
+/**
+ * dl_txt_read_func returning what was already read to peek before continuing to read from stream.
+ */
+static size_t dl_util_read_stream( char* buffer, size_t buffer_size, void* read_ctx )
+{
+	dl_util_stream_reader* reader = (dl_util_stream_reader*)read_ctx;
+	if( reader->peek_pos < reader->peek_size )
+	{
+		size_t size = reader->peek_size - reader->peek_pos;
+		if( size > buffer_size )
+			size = buffer_size;
+		memcpy( buffer, reader->peek + reader->peek_pos, size );
+		reader->peek_pos += size;
+		return size;
+	}
+	return fread( buffer, 1, buffer_size, reader->stream );
+}
+
 dl_error_t dl_util_load_from_stream( dl_ctx_t dl_ctx,       	dl_typeid_t         type,
 									 FILE*    stream,       	dl_util_file_type_t filetype,
 									 void**   out_instance, 	dl_typeid_t*        out_type,
@@ -59,23 +102,23 @@ dl_error_t dl_util_load_from_stream( dl_ctx_t dl_ctx,       	dl_typeid_t
 
 	// TODO: this function need to handle alignment for _ppInstance
 	(void)consumed_bytes; // TODO: Return good stuff here!
-	size_t file_size;
-	unsigned char* file_content = dl_read_entire_stream( allocator, stream, &file_size );
 
-	file_content[file_size] = '\0';
+	// ... look at the header-sized start of the stream to decide if it is binary or text ...
+	dl_util_stream_reader reader;
+	memset( reader.peek, 0x0, sizeof(reader.peek) );
+	reader.stream    = stream;
+	reader.peek_size = fread( reader.peek, 1, sizeof(reader.peek), stream );
+	reader.peek_pos  = 0;
 
 	dl_error_t error = DL_ERROR_OK;
 	dl_instance_info_t info;
 
-	error = dl_instance_get_info( file_content, file_size, &info );
+	error = dl_instance_get_info( reader.peek, reader.peek_size, &info );
 
 	dl_util_file_type_t in_file_type = error == DL_ERROR_OK ? DL_UTIL_FILE_TYPE_BINARY : DL_UTIL_FILE_TYPE_TEXT;
 
 	if( ( in_file_type & filetype ) == 0 )
-	{
-		dl_free( allocator, file_content );
 		return DL_ERROR_UTIL_FILE_TYPE_MISMATCH;
-	}
 
 	unsigned char* load_instance = 0x0;
 	size_t         load_size = 0;
@@ -84,6 +127,9 @@ dl_error_t dl_util_load_from_stream( dl_ctx_t dl_ctx,       	dl_typeid_t
 	{
 		case DL_UTIL_FILE_TYPE_BINARY:
 		{
+			size_t file_size;
+			unsigned char* file_content = dl_read_entire_stream( allocator, stream, reader.peek, reader.peek_size, &file_size );
+
 			if( type == 0 ) // autodetect filetype
 				type = info.root_type;
 
@@ -112,25 +158,14 @@ dl_error_t dl_util_load_from_stream( dl_ctx_t dl_ctx,       	dl_typeid_t
 		break;
 		case DL_UTIL_FILE_TYPE_TEXT:
 		{
-			// calc needed space
-			size_t packed_size = 0;
-			error = dl_txt_pack( dl_ctx, (char*)file_content, 0x0, 0, &packed_size );
-
-			if(error != DL_ERROR_OK) { dl_free( allocator, file_content); return error; }
-
-			load_instance = (unsigned char*)dl_alloc( allocator, packed_size );
+			// ... pack the text while it is read instead of reading all of it first ...
+			error = dl_internal_txt_pack_stream( dl_ctx, dl_util_read_stream, &reader, allocator, &load_instance, &load_size );
 
-			error = dl_txt_pack(dl_ctx, (char*)file_content, load_instance, packed_size, 0x0);
-
-			load_size = packed_size;
-
-			dl_free( allocator, file_content);
-
-			if(error != DL_ERROR_OK) { dl_free( allocator, load_instance); return error; }
+			if(error != DL_ERROR_OK) { return error; }
 
 			if( type == 0 ) // autodetect type
 			{
-				dl_instance_get_info( load_instance, packed_size, &info);
+				dl_instance_get_info( load_instance, load_size, &info);
 				type = info.root_type;
 			}
 		}
@@ -149,12 +184,261 @@ dl_error_t dl_util_load_from_stream( dl_ctx_t dl_ctx,       	dl_typeid_t
 	return error;
 }
 
-dl_error_t dl_util_load_from_file_inplace( dl_ctx_t    dl_ctx,       dl_typeid_t         type,
-                                           const char* filename,     dl_util_file_type_t filetype,
-                                           void*       out_instance, size_t              out_instance_size )
+static bool dl_file_size( FILE* file, size_t* out_size )
+{
+#if defined(_MSC_VER)
+	struct _stat64 st;
+	if( _fstat64( _fileno( file ), &st ) != 0 )
+		return false;
+#else
+	struct stat st;
+	if( fstat( fileno( file ), &st ) != 0 )
+		return false;
+#endif
+	*out_size = (size_t)st.st_size;
+	return true;
+}
+
+static dl_error_t dl_util_load_from_file_inplace_binary( dl_ctx_t            dl_ctx,       dl_typeid_t   type,
+														 FILE*               file,         size_t        file_size,
+														 const dl_data_header* header,     const dl_instance_info_t* info,
+														 unsigned char*      out_instance, size_t        out_instance_size,
+														 dl_allocator*       allocator )
+{
+	if( info->endian == DL_ENDIAN_HOST && info->ptrsize == sizeof(void*) )
+	{
+		// ... no conversion needed, keep the header on the stack and read the rest straight to its final location ...
+		size_t data_size = dl_internal_packed_instance_size( header ) - sizeof(dl_data_header);
+		if( data_size > file_size - sizeof(dl_data_header) ) return DL_ERROR_MALFORMED_DATA;
+		if( data_size > out_instance_size )                  return DL_ERROR_BUFFER_TO_SMALL;
+		if( fread( out_instance, 1, data_size, file ) != data_size )
+			return DL_ERROR_MALFORMED_DATA;
+
+		return dl_internal_instance_load_detached_header( dl_ctx, type, header, out_instance, data_size );
+	}
+
+	size_t load_size;
+	if( info->ptrsize >= sizeof(void*) )
+	{
+		// ... same or smaller ptr-size, read everything to out_instance and convert there ...
+		if( file_size > out_instance_size ) return DL_ERROR_BUFFER_TO_SMALL;
+		memcpy( out_instance, header, sizeof(dl_data_header) );
+		size_t data_size = file_size - sizeof(dl_data_header);
+		if( fread( out_instance + sizeof(dl_data_header), 1, data_size, file ) != data_size )
+			return DL_ERROR_MALFORMED_DATA;
+
+		dl_error_t error = dl_convert_inplace( dl_ctx, type, out_instance, file_size, DL_ENDIAN_HOST, sizeof(void*), &load_size );
+		if( error != DL_ERROR_OK )
+			return error;
+	}
+	else
+	{
+		// ... pointers grow, that can not be done in place so this is the only case where the file is read to a temporary buffer ...
+		unsigned char* file_content = (unsigned char*)dl_alloc( allocator, file_size );
+		memcpy( file_content, header, sizeof(dl_data_header) );
+		size_t data_size = file_size - sizeof(dl_data_header);
+		dl_error_t error = DL_ERROR_MALFORMED_DATA;
+		if( fread( file_content + sizeof(dl_data_header), 1, data_size, file ) == data_size )
+			error = dl_convert( dl_ctx, type, file_content, file_size, out_instance, out_instance_size, DL_ENDIAN_HOST, sizeof(void*), &load_size );
+		dl_free( allocator, file_content );
+		if( error != DL_ERROR_OK )
+			return error;
+	}
+
+	return dl_instance_load( dl_ctx, type, out_instance, out_instance_size, out_instance, load_size, 0x0 );
+}
+
+static dl_error_t dl_util_load_from_file_inplace_text( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+													   FILE*          file,         size_t      file_size,
+													   unsigned char* out_instance, size_t      out_instance_size,
+													   dl_typeid_t*   out_type,     dl_allocator* allocator )
+{
+	char* file_content = (char*)dl_alloc( allocator, file_size + 1 );
+	dl_error_t error = DL_ERROR_MALFORMED_DATA;
+	size_t packed_size = 0;
+
+	rewind( file );
+	if( fread( file_content, 1, file_size, file ) == file_size )
+	{
+		file_content[file_size] = '\0';
+		error = dl_txt_pack( dl_ctx, file_content, out_instance, out_instance_size, &packed_size );
+	}
+	dl_free( allocator, file_content );
+
+	if( error != DL_ERROR_OK )
+		return error;
+
+	if( type == 0 ) // autodetect type
+	{
+		dl_instance_info_t info;
+		dl_instance_get_info( out_instance, packed_size, &info );
+		type = info.root_type;
+	}
+
+	*out_type = type;
+	return dl_instance_load( dl_ctx, type, out_instance, out_instance_size, out_instance, packed_size, 0x0 );
+}
+
+dl_error_t dl_util_load_from_file_inplace( dl_ctx_t     dl_ctx,       dl_typeid_t         type,
+										   const char*  filename,     dl_util_file_type_t filetype,
+										   void*        out_instance, size_t              out_instance_size,
+										   dl_typeid_t* out_type,     dl_allocator*       allocator )
+{
+	dl_allocator mallocator;
+	if(allocator == 0x0) {
+		dl_allocator_initialize(&mallocator, 0x0, 0x0, 0x0, 0x0);
+		allocator = &mallocator;
+	}
+
+	FILE* in_file = fopen( filename, "rb" );
+	if( in_file == 0x0 )
+		return DL_ERROR_UTIL_FILE_NOT_FOUND;
+
+	size_t file_size;
+	if( !dl_file_size( in_file, &file_size ) )
+	{
+		fclose( in_file );
+		return DL_ERROR_UTIL_FILE_NOT_FOUND;
+	}
+
+	// ... only read the header to decide how to load ...
+	dl_data_header     header;
+	dl_instance_info_t info;
+	bool is_binary = file_size >= sizeof(dl_data_header) &&
+					 fread( &header, sizeof(dl_data_header), 1, in_file ) == 1 &&
+					 dl_instance_get_info( (const unsigned char*)&header, sizeof(dl_data_header), &info ) == DL_ERROR_OK;
+
+	dl_util_file_type_t in_file_type = is_binary ? DL_UTIL_FILE_TYPE_BINARY : DL_UTIL_FILE_TYPE_TEXT;
+
+	dl_error_t error;
+	if( ( in_file_type & filetype ) == 0 )
+		error = DL_ERROR_UTIL_FILE_TYPE_MISMATCH;
+	else if( is_binary )
+	{
+		if( type == 0 ) // autodetect type
+			type = info.root_type;
+		error = dl_util_load_from_file_inplace_binary( dl_ctx, type, in_file, file_size, &header, &info, (unsigned char*)out_instance, out_instance_size, allocator );
+	}
+	else
+		error = dl_util_load_from_file_inplace_text( dl_ctx, type, in_file, file_size, (unsigned char*)out_instance, out_instance_size, &type, allocator );
+
+	fclose( in_file );
+
+	if( error == DL_ERROR_OK && out_type != 0x0 )
+		*out_type = type;
+
+	return error;
+}
+
+static bool dl_util_map_file( const char* filename, unsigned int mmap_flags, dl_util_mapping_t* mapping )
+{
+#if defined(_WIN32)
+	(void)mmap_flags;
+	HANDLE file = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, 0x0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0x0 );
+	if( file == INVALID_HANDLE_VALUE )
+		return false;
+
+	LARGE_INTEGER file_size;
+	HANDLE map = 0x0;
+	if( GetFileSizeEx( file, &file_size ) && file_size.QuadPart > 0 )
+		map = CreateFileMappingA( file, 0x0, PAGE_WRITECOPY, 0, 0, 0x0 );
+	CloseHandle( file );
+	if( map == 0x0 )
+		return false;
+
+	// FILE_MAP_COPY gives a copy-on-write view, the view keeps the mapping alive after its handle is closed.
+	mapping->address = MapViewOfFile( map, FILE_MAP_COPY, 0, 0, 0 );
+	mapping->size    = (size_t)file_size.QuadPart;
+	CloseHandle( map );
+	return mapping->address != 0x0;
+#else
+	int fd = open( filename, O_RDONLY );
+	if( fd < 0 )
+		return false;
+
+	struct stat st;
+	if( fstat( fd, &st ) != 0 || st.st_size <= 0 )
+	{
+		close( fd );
+		return false;
+	}
+
+	int flags = MAP_PRIVATE;
+#  if defined(MAP_POPULATE)
+	if( mmap_flags & DL_UTIL_MMAP_FLAG_POPULATE )
+		flags |= MAP_POPULATE;
+#  endif
+
+	// mapping is private so that patching pointers only copy the touched pages, the file is never written.
+	void* address = mmap( 0x0, (size_t)st.st_size, PROT_READ | PROT_WRITE, flags, fd, 0 );
+	close( fd );
+	if( address == MAP_FAILED )
+		return false;
+
+#  if defined(MADV_WILLNEED)
+	if( mmap_flags & DL_UTIL_MMAP_FLAG_WILLNEED )
+		madvise( address, (size_t)st.st_size, MADV_WILLNEED );
+#  endif
+
+	mapping->address = address;
+	mapping->size    = (size_t)st.st_size;
+	return true;
+#endif
+}
+
+void dl_util_unmap( dl_util_mapping_t* mapping )
 {
-	(void)dl_ctx; (void)filename; (void)type; (void)filetype; (void)out_instance; (void)out_instance_size;
-	return DL_ERROR_INTERNAL_ERROR; // TODO: Build me
+	if( mapping->address != 0x0 )
+	{
+#if defined(_WIN32)
+		UnmapViewOfFile( mapping->address );
+#else
+		munmap( mapping->address, mapping->size );
+#endif
+	}
+	mapping->address = 0x0;
+	mapping->size    = 0;
+}
+
+dl_error_t dl_util_load_from_file_mmap( dl_ctx_t           dl_ctx,       dl_typeid_t  type,
+										const char*        filename,     unsigned int mmap_flags,
+										dl_util_mapping_t* out_mapping,  void**       out_instance,
+										dl_typeid_t*       out_type )
+{
+	out_mapping->address = 0x0;
+	out_mapping->size    = 0;
+
+	if( !dl_util_map_file( filename, mmap_flags, out_mapping ) )
+		return DL_ERROR_UTIL_FILE_NOT_FOUND;
+
+	unsigned char* packed_instance = (unsigned char*)out_mapping->address;
+	size_t         packed_size     = out_mapping->size;
+
+	dl_instance_info_t info;
+	dl_error_t error = DL_ERROR_UTIL_FILE_TYPE_MISMATCH;
+	if( packed_size >= sizeof(dl_data_header) && dl_instance_get_info( packed_instance, packed_size, &info ) == DL_ERROR_OK )
+	{
+		if( type == 0 ) // autodetect type
+			type = info.root_type;
+
+		error = DL_ERROR_OK;
+		if( info.endian != DL_ENDIAN_HOST || info.ptrsize != sizeof(void*) )
+			error = dl_convert_inplace( dl_ctx, type, packed_instance, packed_size, DL_ENDIAN_HOST, sizeof(void*), &packed_size );
+
+		if( error == DL_ERROR_OK )
+			error = dl_instance_load_inplace( dl_ctx, type, packed_instance, packed_size, out_instance, 0x0 );
+	}
+
+	if( error != DL_ERROR_OK )
+	{
+		dl_util_unmap( out_mapping );
+		return error;
+	}
+
+	if( out_type != 0x0 )
+		*out_type = type;
+
+	return DL_ERROR_OK;
 }
 
 dl_error_t dl_util_store_to_file( dl_ctx_t    dl_ctx,     dl_typeid_t         type,
@@ -175,6 +459,11 @@ dl_error_t dl_util_store_to_file( dl_ctx_t    dl_ctx,     dl_typeid_t         ty
 	return error;
 }
 
+static void dl_util_write_stream( const char* text, size_t text_size, void* write_ctx )
+{
+	fwrite( text, text_size, 1, (FILE*)write_ctx );
+}
+
 dl_error_t dl_util_store_to_stream( dl_ctx_t    dl_ctx,     dl_typeid_t         type,
 									FILE*       stream,     dl_util_file_type_t filetype,
 									dl_endian_t out_endian, size_t              out_ptr_size,
@@ -189,24 +478,19 @@ dl_error_t dl_util_store_to_stream( dl_ctx_t    dl_ctx,     dl_typeid_t
 	if( filetype == DL_UTIL_FILE_TYPE_AUTO )
 		return DL_ERROR_INVALID_PARAMETER;
 
-	size_t packed_size = 0;
-
-	// calculate pack-size
-	dl_error_t error = dl_instance_store( dl_ctx, type, instance, 0x0, 0, &packed_size );
+	// store in one pass, packed_instance is allocated via the allocator in dl_ctx.
+	size_t         packed_size     = 0;
+	unsigned char* packed_instance = 0x0;
+	dl_error_t error = dl_instance_store_alloc( dl_ctx, type, instance, &packed_instance, &packed_size );
 
 	if( error != DL_ERROR_OK)
 		return error;
 
-	// alloc memory
-	unsigned char* packed_instance = (unsigned char*)dl_alloc( allocator, packed_size );
-
-	// pack data
-	error = dl_instance_store( dl_ctx, type, instance, packed_instance, packed_size, 0x0 );
-
-	if( error != DL_ERROR_OK ) { dl_free( allocator, packed_instance ); return error; }
+	dl_allocator* packed_alloc = &dl_ctx->alloc;
 
 	size_t         out_size = 0;
 	unsigned char* out_data = 0x0;
+	dl_allocator*  out_alloc = allocator;
 
 	switch( filetype )
 	{
@@ -215,7 +499,7 @@ dl_error_t dl_util_store_to_stream( dl_ctx_t    dl_ctx,     dl_typeid_t
 			// calc convert size
 			error = dl_convert( dl_ctx, type, packed_instance, packed_size, 0x0, 0, out_endian, out_ptr_size, &out_size );
 
-			if( error != DL_ERROR_OK ) { dl_free( allocator, packed_instance ); return error; }
+			if( error != DL_ERROR_OK ) { dl_free( packed_alloc, packed_instance ); return error; }
 
 			// convert
 			if( out_size > packed_size || out_ptr_size > sizeof(void*) )
@@ -226,43 +510,33 @@ dl_error_t dl_util_store_to_stream( dl_ctx_t    dl_ctx,     dl_typeid_t
 				// convert
 				error = dl_convert( dl_ctx, type, packed_instance, packed_size, out_data, out_size, out_endian, out_ptr_size, 0x0 );
 
-				dl_free( allocator, packed_instance );
+				dl_free( packed_alloc, packed_instance );
 
 				if( error != DL_ERROR_OK ) { dl_free( allocator, out_data ); return error; }
 			}
 			else
 			{
-				out_data = packed_instance;
+				out_data  = packed_instance;
+				out_alloc = packed_alloc;
 				error = dl_convert_inplace( dl_ctx, type, packed_instance, packed_size, out_endian, out_ptr_size, 0x0 );
 
-				if( error != DL_ERROR_OK ) { dl_free( allocator, out_data ); return error; }
+				if( error != DL_ERROR_OK ) { dl_free( out_alloc, out_data ); return error; }
 			}
 		}
 		break;
 		case DL_UTIL_FILE_TYPE_TEXT:
 		{
-			// calculate pack-size
-			error = dl_txt_unpack( dl_ctx, type, packed_instance, packed_size, 0x0, 0, &out_size );
-
-			if( error != DL_ERROR_OK ) { dl_free( allocator, packed_instance ); return error; }
-
-			// alloc data
-			out_data = (unsigned char*)dl_alloc( allocator, out_size );
-
-			// pack data
-			error = dl_txt_unpack( dl_ctx, type, packed_instance, packed_size, (char*)out_data, out_size, 0x0 );
-
-			dl_free( allocator, packed_instance );
-
-			if( error != DL_ERROR_OK ) { dl_free( allocator, out_data ); return error; }
+			// unpack straight to stream, no need to have all the text in memory.
+			error = dl_txt_unpack_stream( dl_ctx, type, packed_instance, packed_size, dl_util_write_stream, stream, 0x0 );
+			dl_free( packed_alloc, packed_instance );
+			return error;
 		}
-		break;
 		default:
 			return DL_ERROR_INTERNAL_ERROR;
 	}
 
 	fwrite( out_data, out_size, 1, stream );
-	dl_free( allocator,  out_data );
+	dl_free( out_alloc, out_data );
 
 	return error;
 }
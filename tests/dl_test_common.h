@@ -75,4 +75,27 @@ struct DL : public ::testing::Test
 	dl_ctx_t Ctx;
 };
 
+/**
+ * Create a context with all unittest type-libraries loaded that store relocation tables, destroy with dl_context_destroy().
+ */
+dl_ctx_t create_reloc_table_ctx();
+
+/**
+ * Create a context with all unittest type-libraries loaded that unpack text with txt_unpack_flags and txt_unpack_indent,
+ * destroy with dl_context_destroy().
+ */
+dl_ctx_t create_txt_unpack_ctx( unsigned int txt_unpack_flags, unsigned int txt_unpack_indent );
+
+/**
+ * Create a context with all unittest type-libraries loaded and the text-routines generated for them by dltlc registered,
+ * destroy with dl_context_destroy().
+ */
+dl_ctx_t create_txt_gen_ctx();
+
+/**
+ * Create a context with all unittest type-libraries loaded and the store/patch-routines generated for them by dltlc
+ * registered, destroy with dl_context_destroy().
+ */
+dl_ctx_t create_bin_gen_ctx();
+
 #endif // DL_DL_TEST_COMMON_H_INCLUDED
@@ -16,6 +16,41 @@ TYPED_TEST(DLBase, array_pod1)
 	free(loaded);
 }
 
+TYPED_TEST(DLBase, array_pod_lengths)
+{
+	// arrays of all lengths around the block-sizes used when swapping endian in bulk.
+	uint16_t u16[67];
+	uint32_t u32[67];
+	uint64_t u64[67];
+	for( uint32_t i = 0; i < DL_ARRAY_LENGTH( u16 ); ++i )
+	{
+		u16[i] = (uint16_t)( 0x0102 * ( i + 1 ) );
+		u32[i] = 0x01020304u * ( i + 1 );
+		u64[i] = 0x0102030405060708ull * ( i + 1 );
+	}
+
+	for( uint32_t count = 1; count <= DL_ARRAY_LENGTH( u16 ); count += 3 )
+	{
+		u16Array orig16 = { { u16, count } };
+		u32Array orig32 = { { u32, count } };
+		u64Array orig64 = { { u64, count } };
+		u16Array DL_ALIGN(8) loaded16[128];
+		u32Array DL_ALIGN(8) loaded32[128];
+		u64Array DL_ALIGN(8) loaded64[128];
+
+		this->do_the_round_about( u16Array::TYPE_ID, &orig16, loaded16, sizeof(loaded16) );
+		this->do_the_round_about( u32Array::TYPE_ID, &orig32, loaded32, sizeof(loaded32) );
+		this->do_the_round_about( u64Array::TYPE_ID, &orig64, loaded64, sizeof(loaded64) );
+
+		EXPECT_EQ( count, loaded16[0].arr.count );
+		EXPECT_EQ( count, loaded32[0].arr.count );
+		EXPECT_EQ( count, loaded64[0].arr.count );
+		EXPECT_ARRAY_EQ( count, u16, loaded16[0].arr.data );
+		EXPECT_ARRAY_EQ( count, u32, loaded32[0].arr.data );
+		EXPECT_ARRAY_EQ( count, u64, loaded64[0].arr.data );
+	}
+}
+
 TYPED_TEST(DLBase, array_with_sub_array)
 {
 	uint32_t array_data[] = { 1337, 7331 } ;
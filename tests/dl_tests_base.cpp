@@ -5,6 +5,16 @@
 #include <dl/dl_txt.h>
 #include <dl/dl_convert.h>
 
+// text pack/unpack-routines generated from the unittest-type libs
+#include "generated/unittest.txt_gen.h"
+#include "generated/unittest2.txt_gen.h"
+#include "generated/sized_enums.txt_gen.h"
+
+// store/patch-routines generated from the unittest-type libs
+#include "generated/unittest.bin_gen.h"
+#include "generated/unittest2.bin_gen.h"
+#include "generated/sized_enums.bin_gen.h"
+
 static void test_log_error( const char* msg, void* )
 {
 	static bool print_error_msg = false;
@@ -12,7 +22,7 @@ static void test_log_error( const char* msg, void* )
 		printf( "%s\n", msg );
 }
 
-void DL::SetUp()
+static void load_test_typelibs( dl_ctx_t dl_ctx )
 {
 	// bake the unittest-type library into the exe!
 	static const unsigned char typelib1[] = {
@@ -25,14 +35,76 @@ void DL::SetUp()
 		#include "generated/sized_enums.bin.h"
 	};
 
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_load_type_library(dl_ctx, typelib1, sizeof(typelib1)) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_load_type_library(dl_ctx, typelib2, sizeof(typelib2)) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_load_type_library(dl_ctx, typelib3, sizeof(typelib3)) );
+}
+
+dl_ctx_t create_reloc_table_ctx()
+{
+	dl_create_params_t p;
+	DL_CREATE_PARAMS_SET_DEFAULT(p);
+	p.error_msg_func = test_log_error;
+	p.store_reloc_table = 1;
+
+	dl_ctx_t dl_ctx;
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_create( &dl_ctx, &p ) );
+	load_test_typelibs( dl_ctx );
+	return dl_ctx;
+}
+
+dl_ctx_t create_txt_unpack_ctx( unsigned int txt_unpack_flags, unsigned int txt_unpack_indent )
+{
+	dl_create_params_t p;
+	DL_CREATE_PARAMS_SET_DEFAULT(p);
+	p.error_msg_func = test_log_error;
+	p.txt_unpack_flags  = txt_unpack_flags;
+	p.txt_unpack_indent = txt_unpack_indent;
+
+	dl_ctx_t dl_ctx;
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_create( &dl_ctx, &p ) );
+	load_test_typelibs( dl_ctx );
+	return dl_ctx;
+}
+
+dl_ctx_t create_txt_gen_ctx()
+{
+	dl_create_params_t p;
+	DL_CREATE_PARAMS_SET_DEFAULT(p);
+	p.error_msg_func = test_log_error;
+
+	dl_ctx_t dl_ctx;
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_create( &dl_ctx, &p ) );
+	load_test_typelibs( dl_ctx );
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, unittest_txt_gen_register( dl_ctx ) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, unittest2_txt_gen_register( dl_ctx ) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, sized_enums_txt_gen_register( dl_ctx ) );
+	return dl_ctx;
+}
+
+dl_ctx_t create_bin_gen_ctx()
+{
+	dl_create_params_t p;
+	DL_CREATE_PARAMS_SET_DEFAULT(p);
+	p.error_msg_func = test_log_error;
+
+	dl_ctx_t dl_ctx;
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_create( &dl_ctx, &p ) );
+	load_test_typelibs( dl_ctx );
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, unittest_bin_gen_register( dl_ctx ) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, unittest2_bin_gen_register( dl_ctx ) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_OK, sized_enums_bin_gen_register( dl_ctx ) );
+	return dl_ctx;
+}
+
+void DL::SetUp()
+{
 	dl_create_params_t p;
 	DL_CREATE_PARAMS_SET_DEFAULT(p);
 	p.error_msg_func = test_log_error;
 
 	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_create( &Ctx, &p ) );
-	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_load_type_library(Ctx, typelib1, sizeof(typelib1)) );
-	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_load_type_library(Ctx, typelib2, sizeof(typelib2)) );
-	EXPECT_DL_ERR_EQ( DL_ERROR_OK, dl_context_load_type_library(Ctx, typelib3, sizeof(typelib3)) );
+	load_test_typelibs( Ctx );
 }
 
 void DL::TearDown()
@@ -65,6 +137,106 @@ void pack_text_test::do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
 	free(text_buffer);
 }
 
+void pack_compact_text_test::do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+									unsigned char* store_buffer, size_t      store_size,
+									unsigned char** out_buffer,   size_t*     out_size )
+{
+	dl_ctx_t compact_ctx = create_txt_unpack_ctx( DL_TXT_UNPACK_FLAG_COMPACT | DL_TXT_UNPACK_FLAG_BASE64_ARRAYS, 2 );
+
+	// unpack binary to single-line txt with arrays of numbers as base64
+	size_t text_size = 0;
+	EXPECT_DL_ERR_OK( dl_txt_unpack_calc_size( compact_ctx, type, store_buffer, store_size, &text_size ) );
+	char *text_buffer = (char*)malloc(text_size);
+	EXPECT_DL_ERR_OK( dl_txt_unpack( compact_ctx, type, store_buffer, store_size, text_buffer, text_size, 0x0 ) );
+	EXPECT_EQ( (const char*)0x0, strchr( text_buffer, '\n' ) );
+
+	// pack txt to binary
+	EXPECT_DL_ERR_OK( dl_txt_pack_calc_size( dl_ctx, text_buffer, out_size ) );
+	*out_buffer = (unsigned char*)malloc(*out_size+1);
+	memset(*out_buffer, 0xFE, *out_size+1);
+
+	EXPECT_DL_ERR_OK( dl_txt_pack( dl_ctx, text_buffer, *out_buffer, *out_size, 0x0 ) );
+
+	free(text_buffer);
+	EXPECT_DL_ERR_OK( dl_context_destroy( compact_ctx ) );
+}
+
+void pack_txt_gen_test::do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+							   unsigned char* store_buffer, size_t      store_size,
+							   unsigned char** out_buffer,   size_t*     out_size )
+{
+	dl_ctx_t gen_ctx = create_txt_gen_ctx();
+
+	// unpack binary to txt with the generated routines, should give the same text as the generic code
+	size_t text_size = 0;
+	EXPECT_DL_ERR_OK( dl_txt_unpack_calc_size( gen_ctx, type, store_buffer, store_size, &text_size ) );
+	char *text_buffer = (char*)malloc(text_size);
+	EXPECT_DL_ERR_OK( dl_txt_unpack( gen_ctx, type, store_buffer, store_size, text_buffer, text_size, 0x0 ) );
+
+	size_t generic_text_size = 0;
+	EXPECT_DL_ERR_OK( dl_txt_unpack_calc_size( dl_ctx, type, store_buffer, store_size, &generic_text_size ) );
+	char *generic_text_buffer = (char*)malloc(generic_text_size);
+	EXPECT_DL_ERR_OK( dl_txt_unpack( dl_ctx, type, store_buffer, store_size, generic_text_buffer, generic_text_size, 0x0 ) );
+	EXPECT_STREQ( generic_text_buffer, text_buffer );
+
+	// pack txt to binary with the generated routines, should give the same instance as the generic code
+	EXPECT_DL_ERR_OK( dl_txt_pack_calc_size( gen_ctx, text_buffer, out_size ) );
+	*out_buffer = (unsigned char*)malloc(*out_size+1);
+	memset(*out_buffer, 0xFE, *out_size+1);
+	EXPECT_DL_ERR_OK( dl_txt_pack( gen_ctx, text_buffer, *out_buffer, *out_size, 0x0 ) );
+
+	size_t generic_size = 0;
+	EXPECT_DL_ERR_OK( dl_txt_pack_calc_size( dl_ctx, text_buffer, &generic_size ) );
+	unsigned char* generic_buffer = (unsigned char*)malloc(generic_size);
+	memset(generic_buffer, 0xFE, generic_size); // same as *out_buffer to compare padding
+	EXPECT_DL_ERR_OK( dl_txt_pack( dl_ctx, text_buffer, generic_buffer, generic_size, 0x0 ) );
+	EXPECT_EQ( generic_size, *out_size );
+	if( generic_size == *out_size )
+	{
+		EXPECT_EQ( 0, memcmp( generic_buffer, *out_buffer, generic_size ) );
+	}
+
+	free(generic_buffer);
+	free(generic_text_buffer);
+	free(text_buffer);
+	EXPECT_DL_ERR_OK( dl_context_destroy( gen_ctx ) );
+}
+
+void bin_gen_test::do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+						  unsigned char* store_buffer, size_t      store_size,
+						  unsigned char** out_buffer,   size_t*     out_size )
+{
+	dl_ctx_t gen_ctx = create_bin_gen_ctx();
+
+	// load a copy of the stored instance inplace, patched by the generated routines
+	unsigned char *inplace_buffer = (unsigned char*)malloc(store_size);
+	memcpy( inplace_buffer, store_buffer, store_size );
+
+	void* loaded_instance = 0x0;
+	EXPECT_DL_ERR_OK( dl_instance_load_inplace( gen_ctx, type, inplace_buffer, store_size, &loaded_instance, 0x0 ) );
+
+	// store with the generated routines, should give the same instance as the generic code
+	EXPECT_DL_ERR_OK( dl_instance_calc_size( gen_ctx, type, loaded_instance, out_size ) );
+	*out_buffer = (unsigned char*)malloc(*out_size+1);
+	memset(*out_buffer, 0xFE, *out_size+1);
+	EXPECT_DL_ERR_OK( dl_instance_store( gen_ctx, type, loaded_instance, *out_buffer, *out_size, 0x0 ) );
+
+	size_t generic_size = 0;
+	EXPECT_DL_ERR_OK( dl_instance_calc_size( dl_ctx, type, loaded_instance, &generic_size ) );
+	unsigned char* generic_buffer = (unsigned char*)malloc(generic_size);
+	memset(generic_buffer, 0xFE, generic_size); // same as *out_buffer to compare padding
+	EXPECT_DL_ERR_OK( dl_instance_store( dl_ctx, type, loaded_instance, generic_buffer, generic_size, 0x0 ) );
+	EXPECT_EQ( generic_size, *out_size );
+	if( generic_size == *out_size )
+	{
+		EXPECT_EQ( 0, memcmp( generic_buffer, *out_buffer, generic_size ) );
+	}
+
+	free(generic_buffer);
+	free(inplace_buffer);
+	EXPECT_DL_ERR_OK( dl_context_destroy( gen_ctx ) );
+}
+
 void inplace_load_test::do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
 					   	   	   unsigned char* store_buffer, size_t      store_size,
 							   unsigned char** out_buffer,   size_t*     out_size )
@@ -91,6 +263,66 @@ void inplace_load_test::do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
 	free(inplace_buffer);
 }
 
+void store_alloc_test::do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+							  unsigned char* store_buffer, size_t      store_size,
+							  unsigned char** out_buffer,   size_t*     out_size )
+{
+	// load a copy of the stored instance inplace
+	unsigned char *inplace_buffer = (unsigned char*)malloc(store_size);
+	memcpy( inplace_buffer, store_buffer, store_size );
+
+	void* loaded_instance = 0x0;
+	EXPECT_DL_ERR_OK( dl_instance_load_inplace( dl_ctx, type, inplace_buffer, store_size, &loaded_instance, 0x0 ));
+
+	// store to buffer allocated by dl, should produce the same size as calc_size + store.
+	unsigned char* alloced_buffer = 0x0;
+	EXPECT_DL_ERR_OK( dl_instance_store_alloc( dl_ctx, type, loaded_instance, &alloced_buffer, out_size ) );
+	EXPECT_EQ( store_size, *out_size );
+
+	*out_buffer = (unsigned char*)malloc(*out_size + 1);
+	memset(*out_buffer, 0xFE, *out_size + 1);
+	memcpy(*out_buffer, alloced_buffer, *out_size);
+
+	free(alloced_buffer); // context is created with default allocator.
+	free(inplace_buffer);
+}
+
+void reloc_table_test::do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+							  unsigned char* store_buffer, size_t      store_size,
+							  unsigned char** out_buffer,   size_t*     out_size )
+{
+	dl_ctx_t reloc_ctx = create_reloc_table_ctx();
+
+	// go via text to get a packed instance with relocation table from dl_txt_pack
+	size_t text_size = 0;
+	EXPECT_DL_ERR_OK( dl_txt_unpack_calc_size( dl_ctx, type, store_buffer, store_size, &text_size ) );
+	char *text_buffer = (char*)malloc(text_size);
+	EXPECT_DL_ERR_OK( dl_txt_unpack( dl_ctx, type, store_buffer, store_size, text_buffer, text_size, 0x0 ) );
+
+	size_t packed_size = 0;
+	EXPECT_DL_ERR_OK( dl_txt_pack_calc_size( reloc_ctx, text_buffer, &packed_size ) );
+	unsigned char *packed_buffer = (unsigned char*)malloc(packed_size+1);
+	memset( packed_buffer, 0xFE, packed_size+1 );
+	EXPECT_DL_ERR_OK( dl_txt_pack( reloc_ctx, text_buffer, packed_buffer, packed_size, 0x0 ) );
+	EXPECT_EQ( (unsigned char)0xFE, packed_buffer[packed_size] );
+
+	// load inplace, patching via relocation table
+	void* loaded_instance = 0x0;
+	size_t consumed = 0;
+	EXPECT_DL_ERR_OK( dl_instance_load_inplace( dl_ctx, type, packed_buffer, packed_size, &loaded_instance, &consumed ));
+	EXPECT_EQ( packed_size, consumed );
+
+	// store with relocation table, will be patched via the table when loaded by caller.
+	EXPECT_DL_ERR_OK( dl_instance_calc_size( reloc_ctx, type, loaded_instance, out_size ) );
+	*out_buffer = (unsigned char*)malloc(*out_size + 1);
+	memset(*out_buffer, 0xFE, *out_size + 1);
+	EXPECT_DL_ERR_OK( dl_instance_store( reloc_ctx, type, loaded_instance, *out_buffer, *out_size, 0x0 ) );
+
+	free(packed_buffer);
+	free(text_buffer);
+	EXPECT_DL_ERR_OK( dl_context_destroy( reloc_ctx ) );
+}
+
 void convert_test_do_it( dl_ctx_t       dl_ctx,        dl_typeid_t type,
 						 unsigned char* store_buffer,  size_t      store_size,
 						 unsigned char** out_buffer,    size_t*     out_size,
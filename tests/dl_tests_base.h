@@ -21,6 +21,27 @@ struct pack_text_test
 					   unsigned char** out_buffer,   size_t*     out_size );
 };
 
+struct pack_compact_text_test
+{
+	static void do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+					   unsigned char* store_buffer, size_t      store_size,
+					   unsigned char** out_buffer,   size_t*     out_size );
+};
+
+struct pack_txt_gen_test
+{
+	static void do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+					   unsigned char* store_buffer, size_t      store_size,
+					   unsigned char** out_buffer,   size_t*     out_size );
+};
+
+struct bin_gen_test
+{
+	static void do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+					   unsigned char* store_buffer, size_t      store_size,
+					   unsigned char** out_buffer,   size_t*     out_size );
+};
+
 struct inplace_load_test
 {
 	static void do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
@@ -28,6 +49,20 @@ struct inplace_load_test
 					   unsigned char** out_buffer,   size_t*     out_size );
 };
 
+struct store_alloc_test
+{
+	static void do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+					   unsigned char* store_buffer, size_t      store_size,
+					   unsigned char** out_buffer,   size_t*     out_size );
+};
+
+struct reloc_table_test
+{
+	static void do_it( dl_ctx_t       dl_ctx,       dl_typeid_t type,
+					   unsigned char* store_buffer, size_t      store_size,
+					   unsigned char** out_buffer,   size_t*     out_size );
+};
+
 void convert_test_do_it( dl_ctx_t       dl_ctx,        dl_typeid_t type,
 						 unsigned char* store_buffer,  size_t      store_size,
 						 unsigned char** out_buffer,    size_t*     out_size,
@@ -109,7 +144,12 @@ struct DLBase : public DL
 
 typedef ::testing::Types<
 	 pack_text_test
+	,pack_compact_text_test
+	,pack_txt_gen_test
+	,bin_gen_test
 	,inplace_load_test
+	,store_alloc_test
+	,reloc_table_test
 	,convert_test<4, DL_ENDIAN_LITTLE>
 	,convert_test<8, DL_ENDIAN_LITTLE>
 	,convert_test<4, DL_ENDIAN_BIG>
@@ -326,6 +326,211 @@ TEST_F( DL, lots_of_members )
 	EXPECT_EQ(0, memcmp(loaded, &t1, sizeof(t1)));
 }
 
+TEST_F( DL, store_many_strings_merge_identical )
+{
+	// enough strings to push the store-context string lookup out of its stack buffer, every string is stored twice.
+	const uint32_t NUM_UNIQUE = 4096;
+	char* str_data = (char*)malloc( NUM_UNIQUE * 16 );
+	const char** strs = (const char**)malloc( NUM_UNIQUE * 2 * sizeof(const char*) );
+	size_t unique_str_size = 0;
+	for( uint32_t i = 0; i < NUM_UNIQUE; ++i )
+	{
+		char* str = str_data + i * 16;
+		unique_str_size += (size_t)snprintf( str, 16, "str_%u", i ) + 1;
+		strs[i] = str;
+		strs[i + NUM_UNIQUE] = str;
+	}
+
+	StringArray unique;
+	unique.Strings.data  = strs;
+	unique.Strings.count = NUM_UNIQUE;
+
+	StringArray original;
+	original.Strings.data  = strs;
+	original.Strings.count = NUM_UNIQUE * 2;
+
+	// ... the duplicated strings should only cost the extra pointers ...
+	size_t unique_pack_size;
+	size_t pack_size;
+	EXPECT_DL_ERR_OK( dl_instance_calc_size( this->Ctx, StringArray::TYPE_ID, &unique, &unique_pack_size ) );
+	EXPECT_DL_ERR_OK( dl_instance_calc_size( this->Ctx, StringArray::TYPE_ID, &original, &pack_size ) );
+	EXPECT_EQ( unique_pack_size + NUM_UNIQUE * sizeof(const char*), pack_size );
+	EXPECT_LT( unique_str_size, unique_pack_size );
+
+	unsigned char* packed_instance = (unsigned char*)malloc( pack_size );
+	EXPECT_DL_ERR_OK( dl_instance_store( this->Ctx, StringArray::TYPE_ID, &original, packed_instance, pack_size, 0x0 ) );
+
+	StringArray* loaded;
+	EXPECT_DL_ERR_OK( dl_instance_load_inplace( this->Ctx, StringArray::TYPE_ID, packed_instance, pack_size, (void**)(void*)&loaded, 0x0 ) );
+
+	EXPECT_EQ( NUM_UNIQUE * 2, loaded->Strings.count );
+	for( uint32_t i = 0; i < NUM_UNIQUE; ++i )
+	{
+		EXPECT_STREQ( strs[i], loaded->Strings[i] );
+		EXPECT_EQ( loaded->Strings[i], loaded->Strings[i + NUM_UNIQUE] );
+	}
+
+	free( packed_instance );
+	free( strs );
+	free( str_data );
+}
+
+TEST_F( DL, convert_many_ptrs )
+{
+	// enough sub-instances to make pointer-lookups in convert show up, every instance is pointed to twice.
+	const uint32_t NUM_INSTANCES = 4096;
+	Pods2*  pods = (Pods2*)malloc( NUM_INSTANCES * sizeof(Pods2) );
+	Pods2** ptrs = (Pods2**)malloc( NUM_INSTANCES * 2 * sizeof(Pods2*) );
+	for( uint32_t i = 0; i < NUM_INSTANCES; ++i )
+	{
+		pods[i].Int1 = i;
+		pods[i].Int2 = i * 2;
+		ptrs[i] = &pods[i];
+		ptrs[i + NUM_INSTANCES] = &pods[NUM_INSTANCES - i - 1];
+	}
+
+	ptr_array original;
+	original.arr.data  = ptrs;
+	original.arr.count = NUM_INSTANCES * 2;
+
+	size_t pack_size;
+	EXPECT_DL_ERR_OK( dl_instance_calc_size( this->Ctx, ptr_array::TYPE_ID, &original, &pack_size ) );
+	unsigned char* packed_instance = (unsigned char*)malloc( pack_size );
+	EXPECT_DL_ERR_OK( dl_instance_store( this->Ctx, ptr_array::TYPE_ID, &original, packed_instance, pack_size, 0x0 ) );
+
+	// ... convert to other ptr-size and endian and back again ...
+	size_t other_ptr_size = sizeof(void*) == 8 ? 4 : 8;
+	size_t converted_size;
+	size_t back_size;
+	EXPECT_DL_ERR_OK( dl_convert_calc_size( this->Ctx, ptr_array::TYPE_ID, packed_instance, pack_size, other_ptr_size, &converted_size ) );
+	unsigned char* converted = (unsigned char*)malloc( converted_size );
+	EXPECT_DL_ERR_OK( dl_convert( this->Ctx, ptr_array::TYPE_ID, packed_instance, pack_size, converted, converted_size, DL_ENDIAN_BIG == DL_ENDIAN_HOST ? DL_ENDIAN_LITTLE : DL_ENDIAN_BIG, other_ptr_size, 0x0 ) );
+	EXPECT_DL_ERR_OK( dl_convert_calc_size( this->Ctx, ptr_array::TYPE_ID, converted, converted_size, sizeof(void*), &back_size ) );
+	EXPECT_EQ( pack_size, back_size );
+	unsigned char* back = (unsigned char*)malloc( back_size );
+	EXPECT_DL_ERR_OK( dl_convert( this->Ctx, ptr_array::TYPE_ID, converted, converted_size, back, back_size, DL_ENDIAN_HOST, sizeof(void*), 0x0 ) );
+
+	ptr_array* loaded;
+	EXPECT_DL_ERR_OK( dl_instance_load_inplace( this->Ctx, ptr_array::TYPE_ID, back, back_size, (void**)(void*)&loaded, 0x0 ) );
+
+	EXPECT_EQ( NUM_INSTANCES * 2, loaded->arr.count );
+	for( uint32_t i = 0; i < NUM_INSTANCES; ++i )
+	{
+		EXPECT_EQ( i,     loaded->arr[i]->Int1 );
+		EXPECT_EQ( i * 2, loaded->arr[i]->Int2 );
+		EXPECT_EQ( loaded->arr[i], loaded->arr[NUM_INSTANCES * 2 - i - 1] );
+	}
+
+	free( back );
+	free( converted );
+	free( packed_instance );
+	free( ptrs );
+	free( pods );
+}
+
+static void check_self_relative_ptr_chain( dl_ctx_t dl_ctx )
+{
+	DoublePtrChain ptr1 = { 1337, 0x0,   0x0 };
+	DoublePtrChain ptr2 = { 7331, &ptr1, 0x0 };
+	DoublePtrChain ptr3 = { 13,   &ptr2, 0x0 };
+	DoublePtrChain ptr4 = { 37,   &ptr3, 0x0 };
+	ptr1.Prev = &ptr2;
+	ptr2.Prev = &ptr3;
+	ptr3.Prev = &ptr4;
+
+	unsigned char DL_ALIGN(8) packed_instance[512];
+	size_t pack_size;
+	EXPECT_DL_ERR_OK( dl_instance_store( dl_ctx, DoublePtrChain::TYPE_ID, &ptr4, packed_instance, sizeof( packed_instance ), &pack_size ) );
+	EXPECT_DL_ERR_OK( dl_instance_make_self_relative( dl_ctx, DoublePtrChain::TYPE_ID, packed_instance, pack_size ) );
+
+	// ... loading should not touch the packed data ...
+	unsigned char DL_ALIGN(8) before_load[512];
+	memcpy( before_load, packed_instance, pack_size );
+
+	DoublePtrChain* loaded;
+	size_t consumed;
+	EXPECT_DL_ERR_OK( dl_instance_load_inplace( dl_ctx, DoublePtrChain::TYPE_ID, packed_instance, pack_size, (void**)(void*)&loaded, &consumed ) );
+	EXPECT_EQ( pack_size, consumed );
+	EXPECT_EQ( 0, memcmp( before_load, packed_instance, pack_size ) );
+
+	const DoublePtrChain* l4 = loaded;
+	const DoublePtrChain* l3 = DoublePtrChain_rel_Next( l4 );
+	const DoublePtrChain* l2 = DoublePtrChain_rel_Next( l3 );
+	const DoublePtrChain* l1 = DoublePtrChain_rel_Next( l2 );
+	EXPECT_EQ( 37u,   l4->Int );
+	EXPECT_EQ( 13u,   l3->Int );
+	EXPECT_EQ( 7331u, l2->Int );
+	EXPECT_EQ( 1337u, l1->Int );
+	EXPECT_EQ( 0x0, DoublePtrChain_rel_Prev( l4 ) );
+	EXPECT_EQ( 0x0, DoublePtrChain_rel_Next( l1 ) );
+	EXPECT_EQ( l4,  DoublePtrChain_rel_Prev( l3 ) ); // points back to root.
+	EXPECT_EQ( l3,  DoublePtrChain_rel_Prev( l2 ) );
+	EXPECT_EQ( l2,  DoublePtrChain_rel_Prev( l1 ) );
+
+	// ... converting twice is a no-op ...
+	EXPECT_DL_ERR_OK( dl_instance_make_self_relative( dl_ctx, DoublePtrChain::TYPE_ID, packed_instance, pack_size ) );
+	EXPECT_EQ( 0, memcmp( before_load, packed_instance, pack_size ) );
+}
+
+TEST_F( DL, self_relative_ptr_chain )
+{
+	check_self_relative_ptr_chain( this->Ctx );
+
+	// ... same result when converting via the relocation table ...
+	dl_ctx_t reloc_ctx = create_reloc_table_ctx();
+	check_self_relative_ptr_chain( reloc_ctx );
+	dl_context_destroy( reloc_ctx );
+}
+
+TEST_F( DL, self_relative_strings_and_arrays )
+{
+	const char* strs[] = { "cow", "bells", 0x0, "cow" };
+	StringArray str_arr;
+	str_arr.Strings.data  = strs;
+	str_arr.Strings.count = DL_ARRAY_LENGTH( strs );
+
+	unsigned char DL_ALIGN(8) packed_instance[512];
+	size_t pack_size;
+	EXPECT_DL_ERR_OK( dl_instance_store( this->Ctx, StringArray::TYPE_ID, &str_arr, packed_instance, sizeof( packed_instance ), &pack_size ) );
+	EXPECT_DL_ERR_OK( dl_instance_make_self_relative( this->Ctx, StringArray::TYPE_ID, packed_instance, pack_size ) );
+
+	// ... self-relative data is valid wherever it is copied ...
+	StringArray DL_ALIGN(8) loaded[32];
+	EXPECT_DL_ERR_OK( dl_instance_load( this->Ctx, StringArray::TYPE_ID, loaded, sizeof( loaded ), packed_instance, pack_size, 0x0 ) );
+	memset( packed_instance, 0xFE, sizeof( packed_instance ) );
+
+	EXPECT_EQ( 4u, loaded[0].Strings.count );
+	EXPECT_STREQ( "cow",   StringArray_rel_Strings( loaded, 0 ) );
+	EXPECT_STREQ( "bells", StringArray_rel_Strings( loaded, 1 ) );
+	EXPECT_EQ( 0x0,        StringArray_rel_Strings( loaded, 2 ) );
+	EXPECT_STREQ( "cow",   StringArray_rel_Strings( loaded, 3 ) );
+
+	uint32_t u32_1[] = { 1, 2, 3 };
+	uint32_t u32_2[] = { 4 };
+	PodArray1 sub[2] = { { { u32_1, DL_ARRAY_LENGTH( u32_1 ) } }, { { u32_2, DL_ARRAY_LENGTH( u32_2 ) } } };
+	PodArray2 pod_arr = { { sub, DL_ARRAY_LENGTH( sub ) } };
+
+	EXPECT_DL_ERR_OK( dl_instance_store( this->Ctx, PodArray2::TYPE_ID, &pod_arr, packed_instance, sizeof( packed_instance ), &pack_size ) );
+	EXPECT_DL_ERR_OK( dl_instance_make_self_relative( this->Ctx, PodArray2::TYPE_ID, packed_instance, pack_size ) );
+
+	PodArray2* loaded_arr;
+	EXPECT_DL_ERR_OK( dl_instance_load_inplace( this->Ctx, PodArray2::TYPE_ID, packed_instance, pack_size, (void**)(void*)&loaded_arr, 0x0 ) );
+	EXPECT_EQ( 2u, loaded_arr->sub_arr.count );
+	const PodArray1* loaded_sub = PodArray2_rel_sub_arr( loaded_arr );
+	EXPECT_EQ( 3u, loaded_sub[0].u32_arr.count );
+	EXPECT_EQ( 1u, PodArray1_rel_u32_arr( &loaded_sub[0] )[0] );
+	EXPECT_EQ( 2u, PodArray1_rel_u32_arr( &loaded_sub[0] )[1] );
+	EXPECT_EQ( 3u, PodArray1_rel_u32_arr( &loaded_sub[0] )[2] );
+	EXPECT_EQ( 1u, loaded_sub[1].u32_arr.count );
+	EXPECT_EQ( 4u, PodArray1_rel_u32_arr( &loaded_sub[1] )[0] );
+
+	// ... self-relative instances can not be converted or unpacked ...
+	unsigned char converted[512];
+	size_t txt_size;
+	EXPECT_DL_ERR_EQ( DL_ERROR_UNSUPPORTED_OPERATION, dl_convert( this->Ctx, PodArray2::TYPE_ID, packed_instance, pack_size, converted, sizeof( converted ), DL_ENDIAN_HOST, sizeof(void*), 0x0 ) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_UNSUPPORTED_OPERATION, dl_txt_unpack_calc_size( this->Ctx, PodArray2::TYPE_ID, packed_instance, pack_size, &txt_size ) );
+}
+
 int main(int argc, char **argv)
 {
 	::testing::InitGoogleTest(&argc, argv);
@@ -78,7 +78,7 @@ TEST_F(DLError, typelib_version_mismatch_returned)
 	// testing that errors are returned correctly by modding data.
 	uint32_t* lib_version = modded_type_lib + 1;
 
-	EXPECT_EQ(4u, *lib_version);
+	EXPECT_EQ(5u, *lib_version);
 
 	*lib_version = 0xFFFFFFFF;
 
@@ -113,11 +113,11 @@ TEST_F(DLError, version_mismatch_returned)
 	conv.instance = packed;
 	unsigned int* instance_version;
 	instance_version = conv.instance_version + 1;
-	EXPECT_EQ(1u, *instance_version);
+	EXPECT_EQ(2u, *instance_version);
 	*instance_version = 0xFFFFFFFF;
 	conv.instance = swaped;
 	instance_version = conv.instance_version + 1;
-	EXPECT_EQ(0x01000000u, *instance_version);
+	EXPECT_EQ(0x02000000u, *instance_version);
 	*instance_version = 0xFFFFFFFF;
 
 	// test all functions in...
@@ -4,6 +4,7 @@
 
 #include <dl/dl.h>
 #include <dl/dl_txt.h>
+#include <dl/dl_txt_gen.h>
 
 #include "dl_test_common.h"
 
@@ -819,6 +820,31 @@ TEST_F( DLText, multi_line_comments )
 	EXPECT_DL_ERR_OK( dl_txt_pack( Ctx, test_text, out_text_data, DL_ARRAY_LENGTH(out_text_data), 0x0 ) );
 }
 
+TEST_F( DLText, whitespace_runs_and_comments )
+{
+	// ... whitespace is skipped in blocks, try runs of all lengths around the block-size, ending with all kinds of whitespace ...
+	const char ws_chars[] = { ' ', '\t', '\n', '\r', '\v', '\f' };
+	for( int run = 0; run < 70; ++run )
+	{
+		char ws[70];
+		for( int i = 0; i < run; ++i )
+			ws[i] = ws_chars[ ( i + run ) % DL_ARRAY_LENGTH( ws_chars ) ];
+		ws[run] = '\0';
+
+		char test_text[1024];
+		snprintf( test_text, sizeof(test_text),
+				  "%s{%s\"PodsDefaults\"%s:%s{ // comment %s\n"
+				  "\"u8\"%s:%s5,%s/* comment%s*/\"u16\" /**/:/***/ 6 //\n"
+				  "}%s}%s",
+				  ws, ws, ws, ws, ws, ws, ws, ws, ws, ws, ws );
+
+		unsigned char unpack_buffer[1024];
+		PodsDefaults* pods = dl_txt_test_pack_text<PodsDefaults>( Ctx, test_text, unpack_buffer, sizeof(unpack_buffer) );
+		EXPECT_EQ( 5u, pods->u8 );
+		EXPECT_EQ( 6u, pods->u16 );
+	}
+}
+
 TEST_F( DLText, leading_decimal_point )
 {
     uint64_t unpack_buffer[128];
@@ -1055,6 +1081,120 @@ TEST_F( DLText, numbers_start_with_plus )
     EXPECT_EQ(1.0,  pods->f64);
 }
 
+TEST_F( DLText, fpXX_correctly_rounded )
+{
+	struct
+	{
+		const char* txt;
+		float       f32;
+		double      f64;
+	} tests[] = {
+		{ "0.1",                          0.1f,                 0.1 },
+		{ "-0.3",                         -0.3f,                -0.3 },
+		{ "1e23",                         1e23f,                1e23 },
+		{ "9007199254740993",             9007199254740992.0f,  9007199254740992.0 },
+		{ "123456789012345678901234567",  1.23456789e26f,       123456789012345678901234567.0 },
+		{ "2.2250738585072011e-308",      0.0f,                 2.2250738585072011e-308 },
+		{ "4.9e-324",                     0.0f,                 4.9e-324 },
+		{ "1.4e-45",                      1.4e-45f,             1.4e-45 },
+		{ "3.4028235e38",                 3.4028235e38f,        3.4028235e38 },
+		{ "1.000000059604644775390625",   1.0f,                 1.000000059604644775390625 },  // halfway, round to even
+		{ "1.0000000596046447753906251",  1.00000012f,          1.0000000596046447753906251 }, // just above halfway
+		{ "1e400",                        std::numeric_limits<float>::infinity(), std::numeric_limits<double>::infinity() },
+		{ "1e-400",                       0.0f,                 0.0 },
+		{ "0x1.8p1",                      3.0f,                 3.0 },
+		{ "-0x.4",                        -0.25f,               -0.25 },
+		{ "0x1p-1074",                    0.0f,                 4.9406564584124654e-324 },
+	};
+
+	uint64_t unpack_buffer[128];
+	for(uint32_t test = 0; test < DL_ARRAY_LENGTH(tests); ++test)
+	{
+		char text[256];
+		snprintf(text, sizeof(text), "{ PodsDefaults : { f32 : %s, f64 : %s } }", tests[test].txt, tests[test].txt);
+		PodsDefaults* pods = dl_txt_test_pack_text<PodsDefaults>(Ctx, text, unpack_buffer, sizeof(unpack_buffer));
+		EXPECT_EQ(tests[test].f32, pods->f32) << tests[test].txt;
+		EXPECT_EQ(tests[test].f64, pods->f64) << tests[test].txt;
+	}
+}
+
+TEST_F( DLText, int64_decimal_range )
+{
+	uint64_t unpack_buffer[128];
+	PodsDefaults* pods = dl_txt_test_pack_text<PodsDefaults>(Ctx, STRINGIFY( { PodsDefaults : { i64 : -9223372036854775808, u64 : 18446744073709551615 } } ), unpack_buffer, sizeof(unpack_buffer));
+	EXPECT_EQ(INT64_MIN,  pods->i64);
+	EXPECT_EQ(UINT64_MAX, pods->u64);
+
+	dl_txt_test_expect_error<PodsDefaults>(Ctx, STRINGIFY( { PodsDefaults : { i64 :  9223372036854775808 } } ), DL_ERROR_TXT_RANGE_ERROR);
+	dl_txt_test_expect_error<PodsDefaults>(Ctx, STRINGIFY( { PodsDefaults : { i64 : -9223372036854775809 } } ), DL_ERROR_TXT_RANGE_ERROR);
+	dl_txt_test_expect_error<PodsDefaults>(Ctx, STRINGIFY( { PodsDefaults : { u64 :  18446744073709551616 } } ), DL_ERROR_TXT_RANGE_ERROR);
+}
+
+TEST_F( DLText, unpack_shortest_numbers )
+{
+	Pods pods = { INT8_MIN, INT16_MIN, INT32_MIN, INT64_MIN, UINT8_MAX, UINT16_MAX, UINT32_MAX, UINT64_MAX, 3.14f, 0.1 };
+
+	unsigned char packed[1024];
+	size_t packed_size;
+	EXPECT_DL_ERR_OK( dl_instance_store( Ctx, Pods::TYPE_ID, &pods, packed, sizeof(packed), &packed_size ) );
+
+	char text[1024];
+	size_t text_size;
+	EXPECT_DL_ERR_OK( dl_txt_unpack( Ctx, Pods::TYPE_ID, packed, packed_size, text, sizeof(text), &text_size ) );
+
+	EXPECT_NE( (const char*)0x0, strstr( text, "-9223372036854775808" ) );
+	EXPECT_NE( (const char*)0x0, strstr( text, "18446744073709551615" ) );
+	EXPECT_NE( (const char*)0x0, strstr( text, "3.14," ) ) << text;
+	EXPECT_NE( (const char*)0x0, strstr( text, "0.1\n" ) ) << text;
+}
+
+TEST_F( DLText, string_escapes_roundtrip )
+{
+	// ... strings are scanned in blocks, put escaped chars at all kind of positions around the block-size ...
+	const char escaped[] = { '\"', '\'', '\\', '\n', '\r', '\t', '\b', '\f', '\x01' };
+	static char strings[280][72];
+	const char* ptrs[280];
+	uint32_t count = 0;
+	for( int len = 0; len < 70; ++len )
+	{
+		for( int variant = 0; variant < 4; ++variant )
+		{
+			char* str = strings[count];
+			for( int i = 0; i < len; ++i )
+				str[i] = (char)( "abc\xc3\xa5 xyz/*{}[]," )[ ( i + len ) % 16 ];
+			str[len] = '\0';
+			if( len > 0 && variant > 0 )
+			{
+				int pos = variant == 1 ? 0 : ( variant == 2 ? len / 2 : len - 1 );
+				str[pos] = escaped[ ( len + variant ) % sizeof(escaped) ];
+			}
+			ptrs[count] = str;
+			++count;
+		}
+	}
+
+	strArray orig;
+	orig.arr.data  = ptrs;
+	orig.arr.count = count;
+
+	static unsigned char packed[32 * 1024];
+	size_t packed_size;
+	ASSERT_DL_ERR_OK( dl_instance_store( Ctx, strArray::TYPE_ID, &orig, packed, sizeof(packed), &packed_size ) );
+
+	static char text[64 * 1024];
+	ASSERT_DL_ERR_OK( dl_txt_unpack( Ctx, strArray::TYPE_ID, packed, packed_size, text, sizeof(text), 0x0 ) );
+
+	static unsigned char repacked[32 * 1024];
+	ASSERT_DL_ERR_OK( dl_txt_pack( Ctx, text, repacked, sizeof(repacked), 0x0 ) );
+
+	static unsigned char unpack_buffer[32 * 1024];
+	ASSERT_DL_ERR_OK( dl_instance_load( Ctx, strArray::TYPE_ID, unpack_buffer, sizeof(unpack_buffer), repacked, sizeof(repacked), 0x0 ) );
+	strArray* loaded = (strArray*)unpack_buffer;
+	ASSERT_EQ( count, loaded->arr.count );
+	for( uint32_t i = 0; i < count; ++i )
+		EXPECT_STREQ( ptrs[i], loaded->arr[i] ) << "string " << i;
+}
+
 TEST_F( DLText, binary_literals )
 {
     uint64_t unpack_buffer[128];
@@ -1147,6 +1287,59 @@ TEST_F( DLText, binary_literals_range_uint64 )
 	dl_txt_test_expect_error<PodsDefaults>(Ctx, STRINGIFY( { PodsDefaults : { u64 : 0b11111111111111111111111111111111111111111111111111111111111111111 } } ), DL_ERROR_TXT_RANGE_ERROR);
 }
 
+TEST_F( DLText, many_subdata_instances )
+{
+	// ... pointers are resolved by name when packing and by offset when unpacking, make sure that works for long chains ...
+	const uint32_t NODES = 1000;
+	size_t text_size = 64 * NODES + 128;
+	char* text = (char*)malloc( text_size );
+	int len = snprintf( text, text_size, "{ DoublePtrChain : { Int : 0, Next : \"n1\", Prev : null, __subdata : {" );
+	for( uint32_t i = 1; i < NODES; ++i )
+	{
+		char prev[16];
+		char next[16];
+		if( i == 1 ) snprintf( prev, sizeof(prev), "\"__root\"" ); else snprintf( prev, sizeof(prev), "\"n%u\"", i - 1 );
+		if( i == NODES - 1 ) snprintf( next, sizeof(next), "null" ); else snprintf( next, sizeof(next), "\"n%u\"", i + 1 );
+		len += snprintf( text + len, text_size - (size_t)len, " \"n%u\" : { Int : %u, Next : %s, Prev : %s },", i, i, next, prev );
+	}
+	snprintf( text + len, text_size - (size_t)len, " } } }" );
+
+	size_t packed_size;
+	ASSERT_DL_ERR_OK( dl_txt_pack( Ctx, text, 0x0, 0, &packed_size ) );
+	unsigned char* packed = (unsigned char*)malloc( packed_size );
+	ASSERT_DL_ERR_OK( dl_txt_pack( Ctx, text, packed, packed_size, 0x0 ) );
+
+	// ... unpack and pack again to get the unpacker involved as well ...
+	size_t unpacked_size;
+	ASSERT_DL_ERR_OK( dl_txt_unpack_calc_size( Ctx, DoublePtrChain::TYPE_ID, packed, packed_size, &unpacked_size ) );
+	char* unpacked = (char*)malloc( unpacked_size );
+	ASSERT_DL_ERR_OK( dl_txt_unpack( Ctx, DoublePtrChain::TYPE_ID, packed, packed_size, unpacked, unpacked_size, 0x0 ) );
+	ASSERT_DL_ERR_OK( dl_txt_pack( Ctx, unpacked, packed, packed_size, 0x0 ) );
+
+	size_t loaded_size = packed_size * 2;
+	unsigned char* loaded_buffer = (unsigned char*)malloc( loaded_size );
+	ASSERT_DL_ERR_OK( dl_instance_load( Ctx, DoublePtrChain::TYPE_ID, loaded_buffer, loaded_size, packed, packed_size, 0x0 ) );
+
+	const DoublePtrChain* node = (const DoublePtrChain*)loaded_buffer;
+	EXPECT_EQ( 0x0, node->Prev );
+	for( uint32_t i = 0; i < NODES; ++i )
+	{
+		ASSERT_NE( (const DoublePtrChain*)0x0, node );
+		EXPECT_EQ( i, node->Int );
+		if( node->Next )
+		{
+			EXPECT_EQ( node, node->Next->Prev );
+		}
+		node = node->Next;
+	}
+	EXPECT_EQ( (const DoublePtrChain*)0x0, node );
+
+	free( loaded_buffer );
+	free( unpacked );
+	free( packed );
+	free( text );
+}
+
 TEST_F( DLText, accept_trailing_comma_array_i8 )
 {
     unsigned char unpack_buffer[1024];
@@ -1281,6 +1474,46 @@ TEST_F( DLText, accept_trailing_comma_struct)
 	EXPECT_DL_ERR_OK( dl_txt_pack( Ctx, test_text, out_text_data, DL_ARRAY_LENGTH(out_text_data), 0x0 ) );
 }
 
+TEST_F( DLText, array_separators_in_comments_and_strings )
+{
+	unsigned char unpack_buffer[1024];
+
+	{
+		const char* test_text = "{ i32Array : { arr : [ 1, /* 2, ] */ 3 // , 4 ]\n, 5 ] } }";
+		i32Array* arr = dl_txt_test_pack_text<i32Array>( Ctx, test_text, unpack_buffer, sizeof(unpack_buffer) );
+		int32_t expect[] = { 1, 3, 5 };
+		EXPECT_EQ( 3u, arr->arr.count );
+		EXPECT_ARRAY_EQ( 3, arr->arr.data, expect );
+	}
+
+	{
+		const char* test_text = "{ strArray : { arr : [ \"a,]\", /* \"b\", */ 'c//]' ] } }";
+		strArray* arr = dl_txt_test_pack_text<strArray>( Ctx, test_text, unpack_buffer, sizeof(unpack_buffer) );
+		EXPECT_EQ( 2u, arr->arr.count );
+		EXPECT_STREQ( "a,]", arr->arr[0] );
+		EXPECT_STREQ( "c//]", arr->arr[1] );
+	}
+
+	{
+		const char* test_text = "{ StringInlineArray : { Strings : [ \"a\", /* \"b\", */ \"]\" ] } }";
+		StringInlineArray* arr = dl_txt_test_pack_text<StringInlineArray>( Ctx, test_text, unpack_buffer, sizeof(unpack_buffer) );
+		EXPECT_STREQ( "a", arr->Strings[0] );
+		EXPECT_STREQ( "]", arr->Strings[1] );
+	}
+
+	{
+		// ... struct with subdata, elements are counted before they are parsed ...
+		const char* test_text = "{ BugTest4 : { struct_with_str_arr : [ { Strings : [ \"}]\", \"http://x,\" ] }, /* { Strings : [] }, */ { Strings : [ '{[' ] } ] } }";
+		BugTest4* arr = dl_txt_test_pack_text<BugTest4>( Ctx, test_text, unpack_buffer, sizeof(unpack_buffer) );
+		EXPECT_EQ( 2u, arr->struct_with_str_arr.count );
+		EXPECT_EQ( 2u, arr->struct_with_str_arr[0].Strings.count );
+		EXPECT_STREQ( "}]", arr->struct_with_str_arr[0].Strings[0] );
+		EXPECT_STREQ( "http://x,", arr->struct_with_str_arr[0].Strings[1] );
+		EXPECT_EQ( 1u, arr->struct_with_str_arr[1].Strings.count );
+		EXPECT_STREQ( "{[", arr->struct_with_str_arr[1].Strings[0] );
+	}
+}
+
 TEST_F( DLText, missing_struct_end_in_struct_array )
 {
 	unsigned char out_text_data[1024];
@@ -1590,3 +1823,445 @@ TEST_F( DLText, lots_of_members )
 		} 
 	}), DL_ERROR_OK );
 }
+
+TEST_F(DLText, default_value_reloc_table)
+{
+	// pointers written from default-values need to end up in the relocation table as well.
+	dl_ctx_t reloc_ctx = create_reloc_table_ctx();
+
+	unsigned char out_data_text[1024];
+
+	{
+		const char* text_data = STRINGIFY( { "DefaultWithOtherDataBefore" : { "t1" : "apa" } } );
+		DefaultWithOtherDataBefore loaded[10];
+		EXPECT_DL_ERR_OK(dl_txt_pack(reloc_ctx, text_data, out_data_text, sizeof(out_data_text), 0x0));
+		EXPECT_DL_ERR_OK(dl_instance_load(Ctx, DefaultWithOtherDataBefore::TYPE_ID, loaded, sizeof(loaded), out_data_text, sizeof(out_data_text), 0x0));
+		EXPECT_STREQ("apa", loaded[0].t1);
+		EXPECT_STREQ("who", loaded[0].Str);
+	}
+
+	{
+		const char* text_data = STRINGIFY( { "DefaultPtr" : {} } );
+		DefaultPtr loaded = { 0 };
+		EXPECT_DL_ERR_OK(dl_txt_pack(reloc_ctx, text_data, out_data_text, sizeof(out_data_text), 0x0));
+		EXPECT_DL_ERR_OK(dl_instance_load(Ctx, DefaultPtr::TYPE_ID, &loaded, sizeof(loaded), out_data_text, sizeof(out_data_text), 0x0));
+		EXPECT_EQ(0x0, loaded.Ptr);
+	}
+
+	{
+		const char* text_data = STRINGIFY( { "DefaultInlArrayStr" : {} } );
+		DefaultInlArrayStr loaded[10];
+		EXPECT_DL_ERR_OK(dl_txt_pack(reloc_ctx, text_data, out_data_text, sizeof(out_data_text), 0x0));
+		EXPECT_DL_ERR_OK(dl_instance_load(Ctx, DefaultInlArrayStr::TYPE_ID, loaded, sizeof(loaded), out_data_text, sizeof(out_data_text), 0x0));
+		EXPECT_STREQ("cow",   loaded[0].Arr[0]);
+		EXPECT_STREQ("bells", loaded[0].Arr[1]);
+		EXPECT_STREQ("are",   loaded[0].Arr[2]);
+		EXPECT_STREQ("cool",  loaded[0].Arr[3]);
+	}
+
+	{
+		const char* text_data = STRINGIFY( { "DefaultArrayArray" : {} } );
+		DefaultArrayArray loaded[10];
+		EXPECT_DL_ERR_OK(dl_txt_pack(reloc_ctx, text_data, out_data_text, sizeof(out_data_text), 0x0));
+		EXPECT_DL_ERR_OK(dl_instance_load(Ctx, DefaultArrayArray::TYPE_ID, loaded, sizeof(loaded), out_data_text, sizeof(out_data_text), 0x0));
+		EXPECT_EQ( 2u, loaded[0].Arr.count );
+		EXPECT_EQ( 2u, loaded[0].Arr[0].u32_arr.count );
+		EXPECT_EQ( 2u, loaded[0].Arr[1].u32_arr.count );
+		EXPECT_EQ( 1u, loaded[0].Arr[0].u32_arr[0] );
+		EXPECT_EQ( 3u, loaded[0].Arr[0].u32_arr[1] );
+		EXPECT_EQ( 3u, loaded[0].Arr[1].u32_arr[0] );
+		EXPECT_EQ( 7u, loaded[0].Arr[1].u32_arr[1] );
+	}
+
+	EXPECT_DL_ERR_OK(dl_context_destroy(reloc_ctx));
+}
+
+struct dl_test_chunk_reader
+{
+	const char* text;
+	size_t      size;
+	size_t      pos;
+	size_t      chunk_size;
+};
+
+static size_t dl_test_read_chunk( char* buffer, size_t buffer_size, void* read_ctx )
+{
+	dl_test_chunk_reader* reader = (dl_test_chunk_reader*)read_ctx;
+	size_t size = reader->size - reader->pos;
+	if( size > reader->chunk_size ) size = reader->chunk_size;
+	if( size > buffer_size )        size = buffer_size;
+	memcpy( buffer, reader->text + reader->pos, size );
+	reader->pos += size;
+	return size;
+}
+
+static void dl_test_pack_stream_and_compare( dl_ctx_t dl_ctx, const char* text )
+{
+	size_t packed_size;
+	ASSERT_DL_ERR_OK( dl_txt_pack( dl_ctx, text, 0x0, 0, &packed_size ) );
+	unsigned char* packed = (unsigned char*)calloc( 1, packed_size ); // zeroed as dl_txt_pack_stream() zero padding
+	ASSERT_DL_ERR_OK( dl_txt_pack( dl_ctx, text, packed, packed_size, 0x0 ) );
+
+	// ... read in chunks that are smaller than, and larger than, the lookahead and the chunks read by dl ...
+	const size_t chunk_sizes[] = { 1, 13, 1000, 100000, 1 << 24 };
+	for( size_t i = 0; i < DL_ARRAY_LENGTH( chunk_sizes ); ++i )
+	{
+		dl_test_chunk_reader reader = { text, strlen( text ), 0, chunk_sizes[i] };
+		unsigned char* stream_packed = 0x0;
+		size_t stream_packed_size = 0;
+		EXPECT_DL_ERR_OK( dl_txt_pack_stream( dl_ctx, dl_test_read_chunk, &reader, &stream_packed, &stream_packed_size ) );
+		EXPECT_EQ( packed_size, stream_packed_size );
+		if( stream_packed_size == packed_size )
+		{
+			EXPECT_EQ( 0, memcmp( packed, stream_packed, packed_size ) ) << "chunk size " << chunk_sizes[i];
+		}
+		free( stream_packed );
+	}
+	free( packed );
+}
+
+TEST_F( DLText, pack_stream_struct_array_with_subdata )
+{
+	// ... array of structs with strings is skimmed before parsed, make it larger than what is read at a time ...
+	const uint32_t ELEMENTS = 2000;
+	size_t text_size = 128 * ELEMENTS + 128;
+	char* text = (char*)malloc( text_size );
+	int len = snprintf( text, text_size, "{ BugTest4 : { struct_with_str_arr : [ // comment at %u\n", ELEMENTS );
+	for( uint32_t i = 0; i < ELEMENTS; ++i )
+		len += snprintf( text + len, text_size - (size_t)len, " { Strings : [ \"s%u\", 'with \\\"escape\\\" and ] }', /* ] */ \"\" ] },\n", i );
+	snprintf( text + len, text_size - (size_t)len, " ] } }" );
+
+	dl_test_pack_stream_and_compare( Ctx, text );
+	free( text );
+}
+
+TEST_F( DLText, pack_stream_subdata_before_members )
+{
+	// ... "__subdata" is skipped and kept in memory until the rest of the instance is packed ...
+	const uint32_t ELEMENTS = 2000;
+	size_t text_size = 96 * ELEMENTS + 128;
+	char* text = (char*)malloc( text_size );
+	int len = snprintf( text, text_size, "{ PtrArray : { __subdata : {" );
+	for( uint32_t i = 0; i < ELEMENTS; ++i )
+		len += snprintf( text + len, text_size - (size_t)len, " \"p%u\" : { Int1 : %u, Int2 : %u },\n", i, i, i * 2 );
+	len += snprintf( text + len, text_size - (size_t)len, " }, arr : [" );
+	for( uint32_t i = 0; i < ELEMENTS; ++i )
+		len += snprintf( text + len, text_size - (size_t)len, " { ptr : \"p%u\" },", ( i * 7 ) % ELEMENTS );
+	snprintf( text + len, text_size - (size_t)len, " ] } }" );
+
+	dl_test_pack_stream_and_compare( Ctx, text );
+	free( text );
+}
+
+TEST_F( DLText, pack_stream_long_tokens_and_comments )
+{
+	// ... strings and comments longer than what is read at a time ...
+	const size_t LONG = 200000;
+	size_t text_size = 3 * LONG + 256;
+	char* text = (char*)malloc( text_size );
+	int len = snprintf( text, text_size, "{ Strings : { /*" );
+	memset( text + len, '*', LONG ); len += (int)LONG;
+	len += snprintf( text + len, text_size - (size_t)len, "/ Str1 : \"" );
+	memset( text + len, 'a', LONG ); len += (int)LONG;
+	len += snprintf( text + len, text_size - (size_t)len, "\", Str2 : 'b' //" );
+	memset( text + len, '/', LONG ); len += (int)LONG;
+	snprintf( text + len, text_size - (size_t)len, "\n} }" );
+
+	dl_test_pack_stream_and_compare( Ctx, text );
+	free( text );
+}
+
+TEST_F( DLText, pack_stream_error )
+{
+	const char* text = "{ Pods2 : {\n\n\n Int1 : 1,\n Int3 : 2 } }";
+	dl_test_chunk_reader reader = { text, strlen( text ), 0, 3 };
+	unsigned char* packed = 0x0;
+	size_t packed_size = 0;
+	EXPECT_DL_ERR_EQ( DL_ERROR_TXT_INVALID_MEMBER, dl_txt_pack_stream( Ctx, dl_test_read_chunk, &reader, &packed, &packed_size ) );
+	EXPECT_EQ( (unsigned char*)0x0, packed );
+
+	// ... empty stream ...
+	reader.size = 0;
+	reader.pos = 0;
+	EXPECT_DL_ERR_EQ( DL_ERROR_TXT_PARSE_ERROR, dl_txt_pack_stream( Ctx, dl_test_read_chunk, &reader, &packed, &packed_size ) );
+}
+
+struct dl_test_text_sink
+{
+	char*  text;
+	size_t size;
+	size_t capacity;
+	size_t calls;
+};
+
+static void dl_test_write_text( const char* text, size_t text_size, void* write_ctx )
+{
+	dl_test_text_sink* sink = (dl_test_text_sink*)write_ctx;
+	if( sink->size + text_size > sink->capacity )
+	{
+		sink->capacity = ( sink->size + text_size ) * 2;
+		sink->text = (char*)realloc( sink->text, sink->capacity );
+	}
+	memcpy( sink->text + sink->size, text, text_size );
+	sink->size += text_size;
+	++sink->calls;
+}
+
+static void dl_test_unpack_stream_and_compare( dl_ctx_t dl_ctx, dl_typeid_t type, const char* text )
+{
+	size_t packed_size;
+	ASSERT_DL_ERR_OK( dl_txt_pack_calc_size( dl_ctx, text, &packed_size ) );
+	unsigned char* packed = (unsigned char*)malloc( packed_size );
+	ASSERT_DL_ERR_OK( dl_txt_pack( dl_ctx, text, packed, packed_size, 0x0 ) );
+
+	size_t unpacked_size;
+	ASSERT_DL_ERR_OK( dl_txt_unpack_calc_size( dl_ctx, type, packed, packed_size, &unpacked_size ) );
+	char* unpacked = (char*)malloc( unpacked_size );
+	ASSERT_DL_ERR_OK( dl_txt_unpack( dl_ctx, type, packed, packed_size, unpacked, unpacked_size, 0x0 ) );
+
+	dl_test_text_sink sink = { 0x0, 0, 0, 0 };
+	size_t produced_bytes = 0;
+	EXPECT_DL_ERR_OK( dl_txt_unpack_stream( dl_ctx, type, packed, packed_size, dl_test_write_text, &sink, &produced_bytes ) );
+
+	// ... same text except for the terminating zero ...
+	EXPECT_EQ( unpacked_size - 1, produced_bytes );
+	EXPECT_EQ( produced_bytes, sink.size );
+	if( sink.size == unpacked_size - 1 )
+	{
+		EXPECT_EQ( 0, memcmp( unpacked, sink.text, sink.size ) );
+	}
+
+	free( sink.text );
+	free( unpacked );
+	free( packed );
+}
+
+TEST_F( DLText, unpack_stream_small )
+{
+	dl_test_unpack_stream_and_compare( Ctx, Pods2::TYPE_ID, "{ Pods2 : { Int1 : 1, Int2 : 2 } }" );
+}
+
+TEST_F( DLText, unpack_stream_struct_array_with_subdata )
+{
+	// ... output a lot more text than what is buffered before it is passed on ...
+	const uint32_t ELEMENTS = 2000;
+	size_t text_size = 96 * ELEMENTS + 128;
+	char* text = (char*)malloc( text_size );
+	int len = snprintf( text, text_size, "{ PtrArray : { __subdata : {" );
+	for( uint32_t i = 0; i < ELEMENTS; ++i )
+		len += snprintf( text + len, text_size - (size_t)len, " \"p%u\" : { Int1 : %u, Int2 : %u },\n", i, i, i * 2 );
+	len += snprintf( text + len, text_size - (size_t)len, " }, arr : [" );
+	for( uint32_t i = 0; i < ELEMENTS; ++i )
+		len += snprintf( text + len, text_size - (size_t)len, " { ptr : \"p%u\" },", ( i * 7 ) % ELEMENTS );
+	snprintf( text + len, text_size - (size_t)len, " ] } }" );
+
+	dl_test_unpack_stream_and_compare( Ctx, PtrArray::TYPE_ID, text );
+	free( text );
+}
+
+TEST_F( DLText, unpack_stream_long_string )
+{
+	// ... strings longer than what is buffered are passed on as is ...
+	const size_t LONG = 200000;
+	size_t text_size = 2 * LONG + 256;
+	char* text = (char*)malloc( text_size );
+	int len = snprintf( text, text_size, "{ Strings : { Str1 : \"" );
+	memset( text + len, 'a', LONG ); len += (int)LONG;
+	len += snprintf( text + len, text_size - (size_t)len, "\", Str2 : \"" );
+	memset( text + len, 'b', LONG ); len += (int)LONG;
+	snprintf( text + len, text_size - (size_t)len, "\" } }" );
+
+	dl_test_unpack_stream_and_compare( Ctx, Strings::TYPE_ID, text );
+	free( text );
+}
+
+TEST_F( DLText, unpack_stream_error )
+{
+	Pods2 p = { 1, 2 };
+	unsigned char packed[256];
+	size_t packed_size;
+	ASSERT_DL_ERR_OK( dl_instance_store( Ctx, Pods2::TYPE_ID, &p, packed, sizeof(packed), &packed_size ) );
+
+	dl_test_text_sink sink = { 0x0, 0, 0, 0 };
+	EXPECT_DL_ERR_EQ( DL_ERROR_TYPE_MISMATCH,  dl_txt_unpack_stream( Ctx, Pods::TYPE_ID, packed, packed_size, dl_test_write_text, &sink, 0x0 ) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_MALFORMED_DATA, dl_txt_unpack_stream( Ctx, Pods2::TYPE_ID, packed, 4, dl_test_write_text, &sink, 0x0 ) );
+	EXPECT_EQ( 0u, sink.calls );
+}
+
+static void dl_test_unpack_with_ctx( dl_ctx_t unpack_ctx, dl_ctx_t pack_ctx, dl_typeid_t type, const char* text, char* out_text, size_t out_text_size )
+{
+	unsigned char packed[4096];
+	ASSERT_DL_ERR_OK( dl_txt_pack( pack_ctx, text, packed, sizeof(packed), 0x0 ) );
+	ASSERT_DL_ERR_OK( dl_txt_unpack( unpack_ctx, type, packed, sizeof(packed), out_text, out_text_size, 0x0 ) );
+}
+
+TEST_F( DLText, unpack_compact )
+{
+	dl_ctx_t compact_ctx = create_txt_unpack_ctx( DL_TXT_UNPACK_FLAG_COMPACT, 2 );
+
+	char text[4096];
+	dl_test_unpack_with_ctx( compact_ctx, Ctx, Pods2::TYPE_ID, "{ Pods2 : { Int1 : 1, Int2 : 2 } }", text, sizeof(text) );
+	EXPECT_STREQ( "{\"Pods2\":{\"Int1\":1,\"Int2\":2}}", text );
+
+	dl_test_unpack_with_ctx( compact_ctx, Ctx, PtrArray::TYPE_ID, "{ PtrArray : { arr : [ { ptr : \"a\" }, { ptr : \"a\" } ], __subdata : { \"a\" : { Int1 : 1, Int2 : 2 } } } }", text, sizeof(text) );
+	EXPECT_EQ( (const char*)0x0, strchr( text, '\n' ) ) << text;
+	EXPECT_EQ( (const char*)0x0, strchr( text, ' ' ) ) << text;
+	EXPECT_NE( (const char*)0x0, strstr( text, "}],\"__subdata\":{\"ptr_" ) ) << text;
+
+	// ... whitespace in strings is kept ...
+	dl_test_unpack_with_ctx( compact_ctx, Ctx, Strings::TYPE_ID, "{ Strings : { Str1 : \"a b\\nc\", Str2 : \" \" } }", text, sizeof(text) );
+	EXPECT_STREQ( "{\"Strings\":{\"Str1\":\"a b\\nc\",\"Str2\":\" \"}}", text );
+
+	EXPECT_DL_ERR_OK( dl_context_destroy( compact_ctx ) );
+}
+
+TEST_F( DLText, unpack_indent )
+{
+	dl_ctx_t indent_ctx = create_txt_unpack_ctx( DL_TXT_UNPACK_FLAG_DEFAULT, 4 );
+
+	char text[4096];
+	dl_test_unpack_with_ctx( indent_ctx, Ctx, Pods2::TYPE_ID, "{ Pods2 : { Int1 : 1, Int2 : 2 } }", text, sizeof(text) );
+	EXPECT_STREQ( "{\n    \"Pods2\" : {\n        \"Int1\" : 1,\n        \"Int2\" : 2\n    }\n}", text );
+	EXPECT_DL_ERR_OK( dl_context_destroy( indent_ctx ) );
+
+	// ... more than what is written at a time ...
+	indent_ctx = create_txt_unpack_ctx( DL_TXT_UNPACK_FLAG_DEFAULT, 40 );
+	dl_test_unpack_with_ctx( indent_ctx, Ctx, Pods2::TYPE_ID, "{ Pods2 : { Int1 : 1, Int2 : 2 } }", text, sizeof(text) );
+	EXPECT_EQ( 0, strncmp( text, "{\n                                        \"Pods2\" : {\n                                                                                \"Int1\"", 138 ) ) << text;
+	EXPECT_DL_ERR_OK( dl_context_destroy( indent_ctx ) );
+
+	// ... no indent at all ...
+	indent_ctx = create_txt_unpack_ctx( DL_TXT_UNPACK_FLAG_DEFAULT, 0 );
+	dl_test_unpack_with_ctx( indent_ctx, Ctx, Pods2::TYPE_ID, "{ Pods2 : { Int1 : 1, Int2 : 2 } }", text, sizeof(text) );
+	EXPECT_STREQ( "{\n\"Pods2\" : {\n\"Int1\" : 1,\n\"Int2\" : 2\n}\n}", text );
+	EXPECT_DL_ERR_OK( dl_context_destroy( indent_ctx ) );
+}
+
+TEST_F( DLText, base64_array_pack )
+{
+	uint32_t unpack_buffer[128];
+
+	// ... 1, 2, 3 as little endian uint32 ...
+	WithInlineArray* inl = dl_txt_test_pack_text<WithInlineArray>( Ctx, STRINGIFY( { WithInlineArray : { Array : { "__base64" : "AQAAAAIAAAADAAAA" } } } ), unpack_buffer, sizeof(unpack_buffer) );
+	EXPECT_EQ( 1u, inl->Array[0] );
+	EXPECT_EQ( 2u, inl->Array[1] );
+	EXPECT_EQ( 3u, inl->Array[2] );
+
+	// ... missing elements in inline array are zeroed ...
+	inl = dl_txt_test_pack_text<WithInlineArray>( Ctx, STRINGIFY( { WithInlineArray : { Array : { __base64 : "BwAAAA==" } } } ), unpack_buffer, sizeof(unpack_buffer) );
+	EXPECT_EQ( 7u, inl->Array[0] );
+	EXPECT_EQ( 0u, inl->Array[1] );
+	EXPECT_EQ( 0u, inl->Array[2] );
+
+	u16Array* u16 = dl_txt_test_pack_text<u16Array>( Ctx, STRINGIFY( { u16Array : { arr : { "__base64" : "AQD//w==" } } } ), unpack_buffer, sizeof(unpack_buffer) );
+	EXPECT_EQ( 2u, u16->arr.count );
+	EXPECT_EQ( 1u, u16->arr[0] );
+	EXPECT_EQ( 0xFFFFu, u16->arr[1] );
+
+	i8Array* i8 = dl_txt_test_pack_text<i8Array>( Ctx, STRINGIFY( { i8Array : { arr : { "__base64" : "" } } } ), unpack_buffer, sizeof(unpack_buffer) );
+	EXPECT_EQ( 0u, i8->arr.count );
+	EXPECT_EQ( (int8_t*)0x0, i8->arr.data );
+}
+
+TEST_F( DLText, base64_array_pack_error )
+{
+	dl_txt_test_expect_error<u32Array>( Ctx, STRINGIFY( { u32Array : { arr : { "__base64" : "AQAAAAI=" } } } ), DL_ERROR_MALFORMED_DATA ); // 5 bytes
+	dl_txt_test_expect_error<u32Array>( Ctx, STRINGIFY( { u32Array : { arr : { "__base64" : "AQAAAA" } } } ),   DL_ERROR_MALFORMED_DATA ); // not padded
+	dl_txt_test_expect_error<u32Array>( Ctx, STRINGIFY( { u32Array : { arr : { "__base64" : "AQA*AA==" } } } ), DL_ERROR_MALFORMED_DATA );
+	dl_txt_test_expect_error<u32Array>( Ctx, STRINGIFY( { u32Array : { arr : { "__base64" : "AQ==AAAA" } } } ), DL_ERROR_MALFORMED_DATA );
+	dl_txt_test_expect_error<u32Array>( Ctx, STRINGIFY( { u32Array : { arr : { "base64" : "AQAAAA==" } } } ),   DL_ERROR_TXT_PARSE_ERROR );
+	dl_txt_test_expect_error<u32Array>( Ctx, STRINGIFY( { u32Array : { arr : { "__base64" : 1 } } } ),          DL_ERROR_MALFORMED_DATA );
+	dl_txt_test_expect_error<WithInlineArray>( Ctx, STRINGIFY( { WithInlineArray : { Array : { "__base64" : "AQAAAAIAAAADAAAABAAAAA==" } } } ), DL_ERROR_MALFORMED_DATA ); // 4 elements
+	dl_txt_test_expect_error<strArray>( Ctx, STRINGIFY( { strArray : { arr : { "__base64" : "AQAAAA==" } } } ), DL_ERROR_TXT_PARSE_ERROR ); // only numbers
+}
+
+TEST_F( DLText, base64_array_roundtrip )
+{
+	dl_ctx_t base64_ctx = create_txt_unpack_ctx( DL_TXT_UNPACK_FLAG_BASE64_ARRAYS, 2 );
+
+	// ... more elements than what is encoded/decoded at a time, with values that are hard to print as decimals ...
+	const uint32_t COUNT = 10000;
+	float* floats = (float*)malloc( COUNT * sizeof(float) );
+	for( uint32_t i = 0; i < COUNT; ++i )
+		floats[i] = (float)i / 3.0f + 1e-7f * (float)i;
+	floats[1] = -0.0f;
+	floats[2] = std::numeric_limits<float>::infinity();
+
+	fp32Array orig;
+	orig.arr.data  = floats;
+	orig.arr.count = COUNT;
+
+	size_t packed_size;
+	ASSERT_DL_ERR_OK( dl_instance_calc_size( Ctx, fp32Array::TYPE_ID, &orig, &packed_size ) );
+	unsigned char* packed = (unsigned char*)malloc( packed_size );
+	ASSERT_DL_ERR_OK( dl_instance_store( Ctx, fp32Array::TYPE_ID, &orig, packed, packed_size, 0x0 ) );
+
+	size_t text_size;
+	ASSERT_DL_ERR_OK( dl_txt_unpack_calc_size( base64_ctx, fp32Array::TYPE_ID, packed, packed_size, &text_size ) );
+	EXPECT_LT( text_size, (size_t)COUNT * 6 ); // 4 bytes base64-encoded + some
+	char* text = (char*)malloc( text_size );
+	ASSERT_DL_ERR_OK( dl_txt_unpack( base64_ctx, fp32Array::TYPE_ID, packed, packed_size, text, text_size, 0x0 ) );
+	EXPECT_NE( (const char*)0x0, strstr( text, "\"arr\" : { \"__base64\" : \"AAAAAAAAAIAAAIB/" ) ) << text;
+
+	size_t repacked_size;
+	ASSERT_DL_ERR_OK( dl_txt_pack_calc_size( Ctx, text, &repacked_size ) );
+	EXPECT_EQ( packed_size, repacked_size );
+	unsigned char* repacked = (unsigned char*)malloc( repacked_size );
+	ASSERT_DL_ERR_OK( dl_txt_pack( Ctx, text, repacked, repacked_size, 0x0 ) );
+	EXPECT_EQ( 0, memcmp( packed, repacked, packed_size ) );
+
+	// ... and via a stream ...
+	dl_test_pack_stream_and_compare( Ctx, text );
+
+	free( repacked );
+	free( text );
+	free( packed );
+	free( floats );
+	EXPECT_DL_ERR_OK( dl_context_destroy( base64_ctx ) );
+}
+
+TEST_F( DLText, txt_gen_errors )
+{
+	dl_ctx_t gen_ctx = create_txt_gen_ctx();
+
+	// ... the same errors as the generic code should be reported from the generated routines ...
+	dl_txt_test_expect_error<Pods2>( gen_ctx, STRINGIFY( { "Pods2" : { "Int1" : 1, "Int1" : 2, "Int2" : 3 } } ), DL_ERROR_TXT_MEMBER_SET_TWICE );
+	dl_txt_test_expect_error<Pods2>( gen_ctx, STRINGIFY( { "Pods2" : { "Int1" : 1, "Int3" : 2 } } ),             DL_ERROR_TXT_INVALID_MEMBER );
+	dl_txt_test_expect_error<Pods2>( gen_ctx, STRINGIFY( { "Pods2" : { "Int1" : 1 } } ),                         DL_ERROR_TXT_MISSING_MEMBER );
+	dl_txt_test_expect_error<Pods2>( gen_ctx, STRINGIFY( { "Pods2" : { "Int1" : "a", "Int2" : 2 } } ),           DL_ERROR_MALFORMED_DATA );
+	dl_txt_test_expect_error<Pod2InStruct>( gen_ctx, STRINGIFY( { "Pod2InStruct" : { "Pod1" : { "Int1" : 1, "Int2" : 2 }, "Pod2" : { "Int2" : 2 } } } ), DL_ERROR_TXT_MISSING_MEMBER );
+
+	EXPECT_DL_ERR_OK( dl_context_destroy( gen_ctx ) );
+}
+
+TEST_F( DLText, txt_gen_defaults )
+{
+	dl_ctx_t gen_ctx = create_txt_gen_ctx();
+
+	uint64_t unpack_buffer[128];
+	PodsDefaults* pods = dl_txt_test_pack_text<PodsDefaults>( gen_ctx, STRINGIFY( { "PodsDefaults" : { "u16" : 77 } } ), unpack_buffer, sizeof(unpack_buffer) );
+	EXPECT_EQ(  2, pods->i8 );
+	EXPECT_EQ(  3, pods->i16 );
+	EXPECT_EQ( 77, pods->u16 );
+	EXPECT_EQ( 11.0, pods->f64 );
+
+	Pod2InStruct* pod2 = dl_txt_test_pack_text<Pod2InStruct>( gen_ctx, STRINGIFY( { "Pod2InStruct" : { "Pod2" : [ 3, 4 ], "Pod1" : { "Int2" : 2, "Int1" : 1 } } } ), unpack_buffer, sizeof(unpack_buffer) );
+	EXPECT_EQ( 1u, pod2->Pod1.Int1 );
+	EXPECT_EQ( 2u, pod2->Pod1.Int2 );
+	EXPECT_EQ( 3u, pod2->Pod2.Int1 );
+	EXPECT_EQ( 4u, pod2->Pod2.Int2 );
+
+	EXPECT_DL_ERR_OK( dl_context_destroy( gen_ctx ) );
+}
+
+TEST_F( DLText, txt_gen_register_mismatch )
+{
+	dl_txt_gen_type unknown = { 0x12345678, 8, 2, 0x0, 0x0 };
+	EXPECT_DL_ERR_EQ( DL_ERROR_TYPE_NOT_FOUND, dl_txt_gen_register( Ctx, &unknown, 1 ) );
+
+	dl_txt_gen_type wrong_size = { Pods2::TYPE_ID, 12, 2, 0x0, 0x0 };
+	EXPECT_DL_ERR_EQ( DL_ERROR_TYPE_MISMATCH, dl_txt_gen_register( Ctx, &wrong_size, 1 ) );
+
+	dl_txt_gen_type wrong_member_count = { Pods2::TYPE_ID, 8, 3, 0x0, 0x0 };
+	EXPECT_DL_ERR_EQ( DL_ERROR_TYPE_MISMATCH, dl_txt_gen_register( Ctx, &wrong_member_count, 1 ) );
+}
@@ -343,7 +343,7 @@ TEST_F( DLTypeLibUnpackTxt, round_about )
 	});
 
 	// ... pack from text ...
-	EXPECT_DL_ERR_OK( dl_context_load_txt_type_library( ctx, testlib1, sizeof(testlib1)-1 ) );
+	EXPECT_DL_ERR_OK( dl_context_load_txt_type_library( ctx, testlib1, strlen(testlib1) ) );
 
 	size_t txt_size = 0;
 	char testlib_txt_buffer[2048];
@@ -372,7 +372,7 @@ TEST_F( DLTypeLibUnpackTxt, round_about_big )
 	};
 
 	// ... pack from text ...
-	EXPECT_DL_ERR_OK( dl_context_load_txt_type_library( ctx, testlib1, sizeof(testlib1)-1 ) );
+	EXPECT_DL_ERR_OK( dl_context_load_txt_type_library( ctx, testlib1, sizeof(testlib1) ) );
 
 	size_t txt_buffer_size = 4096*8;
 	size_t txt_size = 0;
@@ -435,6 +435,78 @@ TEST_F( DLTypeLib, enum_in_2_tlds )
 	free(tl2);
 }
 
+TEST_F( DLTypeLib, many_types_in_2_tlds )
+{
+	// load enough types and enums, both from binary and text, to grow the typeid lookup a few times.
+	const unsigned int NUM_TYPES = 300;
+
+	char* typelib1 = (char*)malloc( NUM_TYPES * 128 );
+	char* typelib2 = (char*)malloc( NUM_TYPES * 128 );
+	int pos1 = snprintf( typelib1, NUM_TYPES * 128, "{ \"module\" : \"tl1\", \"enums\" : { \"e_last1\" : { \"values\" : { \"e_last1_v\" : 1 } }" );
+	int pos2 = snprintf( typelib2, NUM_TYPES * 128, "{ \"module\" : \"tl2\", \"enums\" : { \"e_last2\" : { \"values\" : { \"e_last2_v\" : 1 } }" );
+	for( unsigned int i = 0; i < NUM_TYPES; ++i )
+	{
+		char*& tl  = i % 2 ? typelib2 : typelib1;
+		int&   pos = i % 2 ? pos2 : pos1;
+		pos += snprintf( tl + pos, NUM_TYPES * 128 - (size_t)pos, ", \"e%u\" : { \"values\" : { \"e%u_v\" : 1 } }", i, i );
+	}
+	pos1 += snprintf( typelib1 + pos1, NUM_TYPES * 128 - (size_t)pos1, " }, \"types\" : { \"t_last1\" : { \"members\" : [ { \"name\" : \"m\", \"type\" : \"e_last1\" } ] }" );
+	pos2 += snprintf( typelib2 + pos2, NUM_TYPES * 128 - (size_t)pos2, " }, \"types\" : { \"t_last2\" : { \"members\" : [ { \"name\" : \"m\", \"type\" : \"e_last2\" } ] }" );
+	for( unsigned int i = 0; i < NUM_TYPES; ++i )
+	{
+		char*& tl  = i % 2 ? typelib2 : typelib1;
+		int&   pos = i % 2 ? pos2 : pos1;
+		pos += snprintf( tl + pos, NUM_TYPES * 128 - (size_t)pos, ", \"t%u\" : { \"members\" : [ { \"name\" : \"m\", \"type\" : \"e%u\", \"default\" : \"e%u_v\" } ] }", i, i, i );
+	}
+	pos1 += snprintf( typelib1 + pos1, NUM_TYPES * 128 - (size_t)pos1, " } }" );
+	pos2 += snprintf( typelib2 + pos2, NUM_TYPES * 128 - (size_t)pos2, " } }" );
+
+	size_t tl1_size;
+	uint8_t* tl1 = test_pack_txt_type_lib( typelib1, (size_t)pos1, &tl1_size );
+
+	EXPECT_DL_ERR_OK( dl_context_load_type_library( ctx, tl1, tl1_size ) );
+	EXPECT_DL_ERR_OK( dl_context_load_txt_type_library( ctx, typelib2, (size_t)pos2 ) );
+
+	for( unsigned int i = 0; i < NUM_TYPES; ++i )
+	{
+		char name[32];
+		snprintf( name, sizeof(name), "t%u", i );
+
+		dl_typeid_t tid;
+		EXPECT_DL_ERR_OK( dl_reflect_get_type_id( ctx, name, &tid ) );
+
+		dl_type_info_t type_info;
+		EXPECT_DL_ERR_OK( dl_reflect_get_type_info( ctx, tid, &type_info ) );
+		EXPECT_STREQ( name, type_info.name );
+	}
+
+	dl_typeid_t enums[NUM_TYPES + 2];
+	EXPECT_DL_ERR_OK( dl_reflect_loaded_enumids( ctx, enums, NUM_TYPES + 2 ) );
+	for( unsigned int i = 0; i < NUM_TYPES + 2; ++i )
+	{
+		dl_enum_info_t enum_info;
+		EXPECT_DL_ERR_OK( dl_reflect_get_enum_info( ctx, enums[i], &enum_info ) );
+		EXPECT_EQ( enums[i], enum_info.tid );
+	}
+
+	dl_type_context_info_t info;
+	EXPECT_DL_ERR_OK( dl_reflect_context_info( ctx, &info ) );
+	EXPECT_EQ( NUM_TYPES + 2, info.num_types );
+	EXPECT_EQ( NUM_TYPES + 2, info.num_enums );
+
+	uint8_t outbuf[256];
+	const char test1[] = STRINGIFY( { "t_last1" : { "m" : "e_last1_v" } } );
+	const char test2[] = STRINGIFY( { "t_last2" : { "m" : "e_last2_v" } } );
+	const char test3[] = STRINGIFY( { "t7" : {} } );
+	EXPECT_DL_ERR_OK( dl_txt_pack( ctx, test1, outbuf, sizeof(outbuf), 0x0 ) );
+	EXPECT_DL_ERR_OK( dl_txt_pack( ctx, test2, outbuf, sizeof(outbuf), 0x0 ) );
+	EXPECT_DL_ERR_OK( dl_txt_pack( ctx, test3, outbuf, sizeof(outbuf), 0x0 ) );
+
+	free(tl1);
+	free(typelib1);
+	free(typelib2);
+}
+
 // test read-errors for enum
 
 // invalid type
@@ -225,4 +225,126 @@ TEST_F( DLUtil, dl_util_load_non_existing_file )
 					  dl_util_load_from_file( Ctx, 0, "whobb whobb whoob", DL_UTIL_FILE_TYPE_AUTO, 0, 0, 0 ) );
 }
 
+TEST_F( DLUtil, store_load_inplace )
+{
+	static const dl_util_file_type_t file_types[] = { DL_UTIL_FILE_TYPE_BINARY, DL_UTIL_FILE_TYPE_TEXT };
+	static const size_t              ptr_sizes[]  = { 4, 8 };
+
+	for( size_t ft = 0; ft < DL_ARRAY_LENGTH( file_types ); ++ft )
+		for( int endian = 0; endian < 2; ++endian )
+			for( size_t ps = 0; ps < DL_ARRAY_LENGTH( ptr_sizes ); ++ps )
+			{
+				EXPECT_DL_ERR_OK( dl_util_store_to_file( Ctx,
+														 Pods::TYPE_ID,
+														 TEMP_FILE_NAME,
+														 file_types[ft],
+														 endian == 0 ? DL_ENDIAN_LITTLE : DL_ENDIAN_BIG,
+														 ptr_sizes[ps],
+														 &p,
+														 0x0 ) );
+
+				Pods DL_ALIGN(8) loaded[8];
+				memset( loaded, 0x0, sizeof( loaded ) );
+				dl_typeid_t stored_type = 0;
+
+				EXPECT_DL_ERR_OK( dl_util_load_from_file_inplace( Ctx,
+																  0, // check autodetection of type
+																  TEMP_FILE_NAME,
+																  DL_UTIL_FILE_TYPE_AUTO,
+																  loaded,
+																  sizeof( loaded ),
+																  &stored_type,
+																  0x0 ) );
+
+				dl_typeid_t expect = Pods::TYPE_ID;
+				EXPECT_EQ( expect, stored_type );
+				check_loaded( loaded );
+			}
+}
+
+TEST_F( DLUtil, load_inplace_patches_ptrs )
+{
+	PtrChain ptr1 = { 1337, 0x0 };
+	PtrChain ptr2 = { 7331, &ptr1 };
+	EXPECT_DL_ERR_OK( dl_util_store_to_file( Ctx,
+											 PtrChain::TYPE_ID,
+											 TEMP_FILE_NAME,
+											 DL_UTIL_FILE_TYPE_BINARY,
+											 DL_ENDIAN_HOST,
+											 sizeof(void*),
+											 &ptr2,
+											 0x0 ) );
+
+	PtrChain loaded[4];
+	EXPECT_DL_ERR_OK( dl_util_load_from_file_inplace( Ctx, PtrChain::TYPE_ID, TEMP_FILE_NAME, DL_UTIL_FILE_TYPE_BINARY, loaded, sizeof( loaded ), 0x0, 0x0 ) );
+	EXPECT_EQ( 7331u, loaded[0].Int );
+	EXPECT_EQ( &loaded[1], loaded[0].Next );
+	EXPECT_EQ( 1337u, loaded[0].Next->Int );
+	EXPECT_EQ( 0x0, loaded[0].Next->Next );
+
+	// ... buffer fitting only the root instance ...
+	EXPECT_DL_ERR_EQ( DL_ERROR_BUFFER_TO_SMALL,
+					  dl_util_load_from_file_inplace( Ctx, PtrChain::TYPE_ID, TEMP_FILE_NAME, DL_UTIL_FILE_TYPE_BINARY, loaded, sizeof( loaded[0] ), 0x0, 0x0 ) );
+
+	EXPECT_DL_ERR_EQ( DL_ERROR_UTIL_FILE_TYPE_MISMATCH,
+					  dl_util_load_from_file_inplace( Ctx, PtrChain::TYPE_ID, TEMP_FILE_NAME, DL_UTIL_FILE_TYPE_TEXT, loaded, sizeof( loaded ), 0x0, 0x0 ) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_UTIL_FILE_NOT_FOUND,
+					  dl_util_load_from_file_inplace( Ctx, 0, "whobb whobb whoob", DL_UTIL_FILE_TYPE_AUTO, loaded, sizeof( loaded ), 0x0, 0x0 ) );
+}
+
 // store in other endian and load!
+TEST_F( DLUtil, load_mmap )
+{
+	PtrChain ptr1 = { 1337, 0x0 };
+	PtrChain ptr2 = { 7331, &ptr1 };
+
+	static const unsigned int mmap_flags[] = { DL_UTIL_MMAP_FLAG_DEFAULT, DL_UTIL_MMAP_FLAG_POPULATE, DL_UTIL_MMAP_FLAG_WILLNEED };
+
+	for( int endian = 0; endian < 2; ++endian )
+		for( size_t i = 0; i < DL_ARRAY_LENGTH( mmap_flags ); ++i )
+		{
+			EXPECT_DL_ERR_OK( dl_util_store_to_file( Ctx,
+													 PtrChain::TYPE_ID,
+													 TEMP_FILE_NAME,
+													 DL_UTIL_FILE_TYPE_BINARY,
+													 endian == 0 ? DL_ENDIAN_LITTLE : DL_ENDIAN_BIG,
+													 sizeof(void*),
+													 &ptr2,
+													 0x0 ) );
+
+			dl_util_mapping_t mapping;
+			union { PtrChain* p; void* vp; } loaded;
+			dl_typeid_t stored_type = 0;
+			EXPECT_DL_ERR_OK( dl_util_load_from_file_mmap( Ctx, 0, TEMP_FILE_NAME, mmap_flags[i], &mapping, &loaded.vp, &stored_type ) );
+
+			dl_typeid_t expect = PtrChain::TYPE_ID;
+			EXPECT_EQ( expect, stored_type );
+			EXPECT_NE( (void*)0x0, mapping.address );
+			EXPECT_EQ( 7331u, loaded.p->Int );
+			EXPECT_EQ( 1337u, loaded.p->Next->Int );
+			EXPECT_EQ( 0x0,   loaded.p->Next->Next );
+
+			dl_util_unmap( &mapping );
+			EXPECT_EQ( (void*)0x0, mapping.address );
+			EXPECT_EQ( 0u, mapping.size );
+		}
+}
+
+TEST_F( DLUtil, load_mmap_error )
+{
+	dl_util_mapping_t mapping;
+	void* loaded;
+	EXPECT_DL_ERR_EQ( DL_ERROR_UTIL_FILE_NOT_FOUND,
+					  dl_util_load_from_file_mmap( Ctx, 0, "whobb whobb whoob", DL_UTIL_MMAP_FLAG_DEFAULT, &mapping, &loaded, 0x0 ) );
+
+	// ... text can not be mapped ...
+	EXPECT_DL_ERR_OK( dl_util_store_to_file( Ctx, Pods::TYPE_ID, TEMP_FILE_NAME, DL_UTIL_FILE_TYPE_TEXT, DL_ENDIAN_HOST, sizeof(void*), &p, 0x0 ) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_UTIL_FILE_TYPE_MISMATCH,
+					  dl_util_load_from_file_mmap( Ctx, 0, TEMP_FILE_NAME, DL_UTIL_MMAP_FLAG_DEFAULT, &mapping, &loaded, 0x0 ) );
+	EXPECT_EQ( (void*)0x0, mapping.address );
+
+	EXPECT_DL_ERR_OK( dl_util_store_to_file( Ctx, Pods::TYPE_ID, TEMP_FILE_NAME, DL_UTIL_FILE_TYPE_BINARY, DL_ENDIAN_HOST, sizeof(void*), &p, 0x0 ) );
+	EXPECT_DL_ERR_EQ( DL_ERROR_TYPE_MISMATCH,
+					  dl_util_load_from_file_mmap( Ctx, PtrChain::TYPE_ID, TEMP_FILE_NAME, DL_UTIL_MMAP_FLAG_DEFAULT, &mapping, &loaded, 0x0 ) );
+	EXPECT_EQ( (void*)0x0, mapping.address );
+}
@@ -1,6 +1,7 @@
 
 #include <dl/dl.h>
 #include <dl/dl_util.h>
+#include <dl/dl_txt.h>
 #include <dl/dl_reflect.h>
 
 #include "getopt/getopt.h"
@@ -18,6 +19,8 @@
 */
 
 int g_Verbose = 0;
+int g_TxtUnpackFlags  = DL_TXT_UNPACK_FLAG_DEFAULT;
+int g_TxtUnpackIndent = 2;
 
 enum
 {
@@ -87,6 +90,8 @@ dl_ctx_t create_ctx()
 	dl_create_params_t p;
 	DL_CREATE_PARAMS_SET_DEFAULT(p);
 	p.error_msg_func = error_report_function;
+	p.txt_unpack_flags  = (unsigned int)g_TxtUnpackFlags;
+	p.txt_unpack_indent = (unsigned int)g_TxtUnpackIndent;
 	dl_error_t err = dl_context_create( &dl_ctx, &p );
 	if(err != DL_ERROR_OK)
 		M_ERROR_AND_FAIL( "DL error while creating context: %s", dl_error_to_string(err) );
@@ -140,6 +145,9 @@ int main( int argc, const char** argv )
 		{ "endian",  'e', GETOPT_OPTION_TYPE_REQUIRED, 0x0,        'e', "endianness of output data, if not specified pack-platform is assumed", "little,big" },
 		{ "ptrsize", 'p', GETOPT_OPTION_TYPE_REQUIRED, 0x0,        'p', "ptr-size of output data, if not specified pack-platform is assumed", "4,8" },
 		{ "unpack",  'u', GETOPT_OPTION_TYPE_FLAG_SET, &do_unpack,   1, "force dl_pack to treat input data as a packed instance that should be unpacked.", 0x0 },
+		{ "compact", 'c', GETOPT_OPTION_TYPE_FLAG_OR,  &g_TxtUnpackFlags, DL_TXT_UNPACK_FLAG_COMPACT, "write unpacked text on a single line without optional whitespace.", 0x0 },
+		{ "base64",  'b', GETOPT_OPTION_TYPE_FLAG_OR,  &g_TxtUnpackFlags, DL_TXT_UNPACK_FLAG_BASE64_ARRAYS, "write arrays of numbers in unpacked text as base64.", 0x0 },
+		{ "indent",  'I', GETOPT_OPTION_TYPE_REQUIRED, 0x0,        'I', "spaces per indentation-level in unpacked text, defaults to 2", "count" },
 		{ "info",    'i', GETOPT_OPTION_TYPE_FLAG_SET, &show_info,   1, "make dl_pack show info about a packed instance.", 0x0 },
 		{ "verbose", 'v', GETOPT_OPTION_TYPE_FLAG_SET, &g_Verbose,   1, "verbose output", 0x0 },
 		GETOPT_OPTIONS_END
@@ -182,6 +190,11 @@ int main( int argc, const char** argv )
 
 				out_ptr_size = (unsigned int)(go_ctx.current_opt_arg[0] - '0');
 				break;
+			case 'I':
+				g_TxtUnpackIndent = atoi( go_ctx.current_opt_arg );
+				if( g_TxtUnpackIndent < 0 || g_TxtUnpackIndent > 64 )
+					M_ERROR_AND_QUIT("indent-flag need a value between 0 and 64, not \"%s\"!", go_ctx.current_opt_arg);
+				break;
 			case '!': M_ERROR_AND_QUIT("incorrect usage of flag \"%s\"!", go_ctx.current_opt_arg); break;
 			case '?': M_ERROR_AND_QUIT("unrecognized flag \"%s\"!", go_ctx.current_opt_arg); break;
 			case '+':
@@ -22,6 +22,8 @@ struct dltlc_args
 	int unpack;
 	int show_info;
 	int c_header;
+	int txt_gen;
+	int bin_gen;
 };
 
 static int verbose = 0;
@@ -42,6 +44,8 @@ static int parse_args( int argc, const char** argv, dltlc_args* args )
 		{ "info",     'i', GETOPT_OPTION_TYPE_FLAG_SET, &args->show_info, 1, "make dl_pack show info about a packed instance.", 0x0 },
 		{ "verbose",  'v', GETOPT_OPTION_TYPE_FLAG_SET, &verbose,         1, "verbose output", 0x0 },
 		{ "c-header", 'c', GETOPT_OPTION_TYPE_FLAG_SET, &args->c_header,  1, "output c header instead of tld binary", 0x0 },
+		{ "txt-gen",  't', GETOPT_OPTION_TYPE_FLAG_SET, &args->txt_gen,   1, "output c++ header with text pack/unpack-routines specialized per type instead of tld binary", 0x0 },
+		{ "bin-gen",  'b', GETOPT_OPTION_TYPE_FLAG_SET, &args->bin_gen,   1, "output c++ header with store/patch-routines specialized per type instead of tld binary", 0x0 },
 		GETOPT_OPTIONS_END
 	};
 
@@ -90,9 +94,9 @@ static int parse_args( int argc, const char** argv, dltlc_args* args )
 		}
 	}
 
-	if( args->show_info + args->c_header + args->unpack > 1 )
+	if( args->show_info + args->c_header + args->txt_gen + args->bin_gen + args->unpack > 1 )
 	{
-		fprintf( stderr, "more than one of, -u,--unpack, -i,--info or -c,--c_header was specified!\n" );
+		fprintf( stderr, "more than one of, -u,--unpack, -i,--info, -c,--c_header, -t,--txt-gen or -b,--bin-gen was specified!\n" );
 		return 1;
 	}
 
@@ -187,6 +191,54 @@ static int write_tl_as_c_header( dl_ctx_t ctx, const char* module_name, FILE* ou
 	return err == DL_ERROR_OK ? 0 : 1;
 }
 
+static int write_tl_as_txt_gen( dl_ctx_t ctx, const char* module_name, FILE* out )
+{
+	dl_error_t err;
+
+	// ... query result size ...
+	size_t res_size;
+	err = dl_context_write_type_library_txt_gen( ctx, module_name, 0x0, 0, &res_size );
+	if( err != DL_ERROR_OK )
+	{
+		fprintf( stderr, "failed to query txt-gen header size for typelib with error \"%s\"\n", dl_error_to_string( err ) );
+		return 1;
+	}
+
+	char* outdata = (char*)malloc( res_size );
+	err = dl_context_write_type_library_txt_gen( ctx, module_name, outdata, res_size, 0x0 );
+	if( err == DL_ERROR_OK )
+		fwrite( outdata, res_size, 1, out );
+	else
+		fprintf( stderr, "failed to write txt-gen header for typelib with error \"%s\"\n", dl_error_to_string( err ) );
+
+	free( outdata );
+	return err == DL_ERROR_OK ? 0 : 1;
+}
+
+static int write_tl_as_bin_gen( dl_ctx_t ctx, const char* module_name, FILE* out )
+{
+	dl_error_t err;
+
+	// ... query result size ...
+	size_t res_size;
+	err = dl_context_write_type_library_bin_gen( ctx, module_name, 0x0, 0, &res_size );
+	if( err != DL_ERROR_OK )
+	{
+		fprintf( stderr, "failed to query bin-gen header size for typelib with error \"%s\"\n", dl_error_to_string( err ) );
+		return 1;
+	}
+
+	char* outdata = (char*)malloc( res_size );
+	err = dl_context_write_type_library_bin_gen( ctx, module_name, outdata, res_size, 0x0 );
+	if( err == DL_ERROR_OK )
+		fwrite( outdata, res_size, 1, out );
+	else
+		fprintf( stderr, "failed to write bin-gen header for typelib with error \"%s\"\n", dl_error_to_string( err ) );
+
+	free( outdata );
+	return err == DL_ERROR_OK ? 0 : 1;
+}
+
 static int write_tl_as_binary( dl_ctx_t ctx, FILE* out )
 {
 	dl_error_t err;
@@ -363,13 +415,12 @@ int main( int argc, const char** argv )
 		show_tl_info( ctx );
 	else if( args.unpack )
 		res = write_tl_as_text( ctx, output );
-	else if( args.c_header )
+	else if( args.c_header || args.txt_gen || args.bin_gen )
 	{
-		if( output == stdout )
-			res = write_tl_as_c_header( ctx, "STDOUT", output );
-		else
+		const char* module_name = "STDOUT";
+		if( output != stdout )
 		{
-			const char* module_name = args.output;
+			module_name = args.output;
 			const char* iter = args.output;
 			while( *iter )
 			{
@@ -377,8 +428,14 @@ int main( int argc, const char** argv )
 					module_name = iter + 1;
 				++iter;
 			}
-			res = write_tl_as_c_header( ctx, module_name, output );
 		}
+
+		if( args.c_header )
+			res = write_tl_as_c_header( ctx, module_name, output );
+		else if( args.txt_gen )
+			res = write_tl_as_txt_gen( ctx, module_name, output );
+		else
+			res = write_tl_as_bin_gen( ctx, module_name, output );
 	}
 	else
 		res = write_tl_as_binary( ctx, output );